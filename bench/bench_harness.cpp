@@ -0,0 +1,227 @@
+#include "bench_harness.h"
+#include "utils/jsonCodec.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+volatile uint64_t gSink = 0;
+
+double secondsFor(const BenchSuite::Body& body, int iterations) {
+    auto start = std::chrono::steady_clock::now();
+    body(iterations);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+} // namespace
+
+void benchKeep(uint64_t value) {
+    gSink = gSink + value;
+}
+
+double benchMedian(std::vector<double> values) {
+    if (values.empty()) return 0.0;
+    size_t mid = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + mid, values.end());
+    double upper = values[mid];
+    if (values.size() % 2 == 1) return upper;
+    double lower = *std::max_element(values.begin(), values.begin() + mid);
+    return (lower + upper) * 0.5;
+}
+
+double benchMad(const std::vector<double>& values) {
+    double median = benchMedian(values);
+    std::vector<double> deviations;
+    deviations.reserve(values.size());
+    for (double v : values) deviations.push_back(std::fabs(v - median));
+    return benchMedian(std::move(deviations));
+}
+
+void BenchSuite::add(std::string name, Body body) {
+    entries_.push_back({std::move(name), std::move(body)});
+}
+
+std::vector<std::string> BenchSuite::names() const {
+    std::vector<std::string> out;
+    for (const Entry& e : entries_) out.push_back(e.name);
+    return out;
+}
+
+std::vector<BenchResult> BenchSuite::run(const BenchOptions& options) const {
+    constexpr int kMaxIterations = 1 << 30;
+    std::vector<BenchResult> results;
+    for (const Entry& e : entries_) {
+        if (!options.filter.empty() && e.name.find(options.filter) == std::string::npos) continue;
+
+        // Calibrate; this also warms caches and lazily built tables.
+        int iterations = 1;
+        for (;;) {
+            double seconds = secondsFor(e.body, iterations);
+            if (seconds >= options.minSampleSeconds || iterations >= kMaxIterations) break;
+            double scale = seconds > 0.0 ? 1.4 * options.minSampleSeconds / seconds : 10.0;
+            double next = iterations * std::clamp(scale, 2.0, 10.0);
+            iterations = static_cast<int>(std::min<double>(next, kMaxIterations));
+        }
+
+        BenchResult r;
+        r.name = e.name;
+        r.iterations = iterations;
+        for (int rep = 0; rep < std::max(1, options.repetitions); ++rep) {
+            r.samples.push_back(secondsFor(e.body, iterations) * 1e9 / iterations);
+        }
+        r.medianNs = benchMedian(r.samples);
+        r.minNs = *std::min_element(r.samples.begin(), r.samples.end());
+        r.madNs = benchMad(r.samples);
+        results.push_back(std::move(r));
+    }
+    return results;
+}
+
+void writeBenchJson(const std::vector<BenchResult>& results, std::string& out) {
+    out.clear();
+    JsonWriter w(out);
+    w.beginObject().key("schema").value(1).key("benchmarks").beginArray();
+    for (const BenchResult& r : results) {
+        w.beginObject();
+        w.key("name").value(r.name);
+        w.key("iterations").value(r.iterations);
+        w.key("median_ns").value(r.medianNs);
+        w.key("min_ns").value(r.minNs);
+        w.key("mad_ns").value(r.madNs);
+        if (r.thresholdPct > 0.0) w.key("threshold_pct").value(r.thresholdPct);
+        w.key("samples_ns").beginArray();
+        for (double s : r.samples) w.value(s);
+        w.endArray();
+        w.endObject();
+    }
+    w.endArray().endObject();
+    out.push_back('\n');
+}
+
+namespace {
+
+bool readBenchEntry(JsonReader& reader, BenchResult& r) {
+    if (!reader.beginObject()) return false;
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        bool ok = true;
+        if (key == "name") {
+            std::string_view raw;
+            ok = reader.readString(raw);
+            if (ok) JsonReader::unescape(raw, r.name);
+        } else if (key == "iterations") {
+            ok = reader.readInt(r.iterations);
+        } else if (key == "median_ns") {
+            ok = reader.readDouble(r.medianNs);
+        } else if (key == "min_ns") {
+            ok = reader.readDouble(r.minNs);
+        } else if (key == "mad_ns") {
+            ok = reader.readDouble(r.madNs);
+        } else if (key == "threshold_pct") {
+            ok = reader.readDouble(r.thresholdPct);
+        } else if (key == "samples_ns") {
+            ok = reader.beginArray();
+            while (ok && reader.nextElement()) {
+                double v = 0.0;
+                ok = reader.readDouble(v);
+                r.samples.push_back(v);
+            }
+        } else {
+            ok = reader.skipValue();
+        }
+        if (!ok) return false;
+    }
+    if (!reader.ok()) return false;
+    if (!r.samples.empty()) {
+        r.medianNs = benchMedian(r.samples);
+        r.madNs = benchMad(r.samples);
+        r.minNs = *std::min_element(r.samples.begin(), r.samples.end());
+    }
+    return true;
+}
+
+} // namespace
+
+bool readBenchJson(std::string_view json, std::vector<BenchResult>& out, std::string* error) {
+    out.clear();
+    JsonReader reader(json);
+    bool ok = reader.beginObject();
+    std::string_view key;
+    while (ok && reader.nextKey(key)) {
+        if (key == "benchmarks") {
+            ok = reader.beginArray();
+            while (ok && reader.nextElement()) {
+                BenchResult r;
+                ok = readBenchEntry(reader, r);
+                if (ok && r.name.empty()) {
+                    if (error) *error = "Benchmark entry without a name";
+                    return false;
+                }
+                out.push_back(std::move(r));
+            }
+        } else {
+            ok = reader.skipValue();
+        }
+    }
+    if (!reader.ok() || !reader.atEnd()) {
+        if (error) *error = reader.ok() ? "Trailing data after results" : reader.error();
+        return false;
+    }
+    return true;
+}
+
+std::vector<BenchComparison> compareBench(const std::vector<BenchResult>& baseline,
+                                          const std::vector<BenchResult>& current,
+                                          const BenchCompareOptions& options) {
+    constexpr double kMadToSigma = 1.4826; // MAD of a normal distribution is 0.6745 sigma
+    std::vector<BenchComparison> out;
+    for (const BenchResult& cur : current) {
+        BenchComparison c;
+        c.name = cur.name;
+        c.currentNs = cur.medianNs;
+        auto base = std::find_if(baseline.begin(), baseline.end(), [&](const BenchResult& b) { return b.name == cur.name; });
+        if (base == baseline.end() || base->medianNs <= 0.0) {
+            c.verdict = BenchVerdict::New;
+            out.push_back(c);
+            continue;
+        }
+        c.baselineNs = base->medianNs;
+        c.thresholdPct = base->thresholdPct > 0.0 ? base->thresholdPct : options.thresholdPct;
+        double delta = cur.medianNs - base->medianNs;
+        c.changePct = 100.0 * delta / base->medianNs;
+        double noise = options.noiseSigmas * kMadToSigma * std::max(base->madNs, cur.madNs);
+        bool significant = std::fabs(c.changePct) > c.thresholdPct && std::fabs(delta) > noise;
+        if (significant) c.verdict = delta > 0.0 ? BenchVerdict::Regressed : BenchVerdict::Faster;
+        out.push_back(c);
+    }
+    if (options.reportMissing) {
+        for (const BenchResult& b : baseline) {
+            bool ran = std::any_of(current.begin(), current.end(), [&](const BenchResult& r) { return r.name == b.name; });
+            if (ran) continue;
+            BenchComparison c;
+            c.name = b.name;
+            c.baselineNs = b.medianNs;
+            c.verdict = BenchVerdict::Missing;
+            out.push_back(c);
+        }
+    }
+    return out;
+}
+
+bool anyRegressed(const std::vector<BenchComparison>& comparisons) {
+    return std::any_of(comparisons.begin(), comparisons.end(),
+                       [](const BenchComparison& c) { return c.verdict == BenchVerdict::Regressed; });
+}
+
+const char* benchVerdictName(BenchVerdict verdict) {
+    switch (verdict) {
+    case BenchVerdict::Same: return "same";
+    case BenchVerdict::Faster: return "faster";
+    case BenchVerdict::Regressed: return "REGRESSED";
+    case BenchVerdict::New: return "new";
+    case BenchVerdict::Missing: return "missing";
+    }
+    return "same";
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+// Small repeatable microbenchmark harness for vray_bench.
+//
+// Each benchmark is a body that runs its operation a given number of times.
+// The harness grows the iteration count until one run takes minSampleSeconds,
+// then times `repetitions` runs at that count. Every run becomes one sample in
+// nanoseconds per operation.
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct BenchOptions {
+    double minSampleSeconds = 0.02;
+    int repetitions = 5;
+    std::string filter; // run only benchmarks whose name contains this; empty = all
+};
+
+struct BenchResult {
+    std::string name;
+    int iterations = 0;          // per sample
+    std::vector<double> samples; // ns per op, one per repetition
+    double medianNs = 0.0;
+    double minNs = 0.0;
+    double madNs = 0.0;        // median absolute deviation of the samples
+    double thresholdPct = 0.0; // allowed slowdown when used as a baseline; 0 = the comparison default
+};
+
+class BenchSuite {
+public:
+    using Body = std::function<void(int iterations)>;
+
+    void add(std::string name, Body body);
+    std::vector<std::string> names() const;
+    std::vector<BenchResult> run(const BenchOptions& options) const;
+
+private:
+    struct Entry {
+        std::string name;
+        Body body;
+    };
+    std::vector<Entry> entries_;
+};
+
+// Folds a value into a sink the optimiser cannot see through, so measured
+// loops are not elided.
+void benchKeep(uint64_t value);
+
+double benchMedian(std::vector<double> values);
+double benchMad(const std::vector<double>& values);
+
+/**
+ * Results as JSON, one object per benchmark:
+ *   {"schema":1,"benchmarks":[{"name":..,"iterations":..,"median_ns":..,
+ *     "min_ns":..,"mad_ns":..,"samples_ns":[..]}, ...]}
+ * A baseline entry may also carry "threshold_pct" (written back when set).
+ */
+void writeBenchJson(const std::vector<BenchResult>& results, std::string& out);
+// Reads writeBenchJson output. Unknown keys are skipped; medians and MADs are
+// recomputed from the samples when present. False with error on malformed input.
+bool readBenchJson(std::string_view json, std::vector<BenchResult>& out, std::string* error = nullptr);
+
+enum class BenchVerdict {
+    Same,      // within threshold or within noise
+    Faster,
+    Regressed,
+    New,       // not in the baseline
+    Missing    // in the baseline but not run
+};
+
+struct BenchComparison {
+    std::string name;
+    double baselineNs = 0.0;
+    double currentNs = 0.0;
+    double changePct = 0.0; // 100 * (current - baseline) / baseline
+    double thresholdPct = 0.0;
+    BenchVerdict verdict = BenchVerdict::Same;
+};
+
+struct BenchCompareOptions {
+    double thresholdPct = 10.0; // for baseline entries without their own
+    // A change must also exceed this many robust standard deviations
+    // (1.4826 * MAD, the larger of the two runs') to count.
+    double noiseSigmas = 3.0;
+    bool reportMissing = true;  // false when the run was filtered
+};
+
+/**
+ * Median-to-median comparison of a run against a baseline. A benchmark
+ * regresses when its median slowed by more than its threshold and by more
+ * than the noise band, so one noisy sample cannot fail the gate.
+ */
+std::vector<BenchComparison> compareBench(const std::vector<BenchResult>& baseline,
+                                          const std::vector<BenchResult>& current,
+                                          const BenchCompareOptions& options = {});
+bool anyRegressed(const std::vector<BenchComparison>& comparisons);
+const char* benchVerdictName(BenchVerdict verdict);
@@ -0,0 +1,247 @@
+// JSON codec benchmark: single-pass JsonReader/JsonWriter helpers in card.cpp
+// against the original find()/substr()/ostringstream implementation (kept
+// verbatim below as the baseline), plus the JSON helpers against the binary
+// wire format (wire.h).
+//
+//   vray_json_bench [iterations]
+#include "card.h"
+#include "game.h"
+#include "wire.h"
+#include "raylib.h" // SetTraceLogLevel
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace legacy {
+
+std::string boolString(bool v) { return v ? "true" : "false"; }
+
+bool extractString(const std::string& src, const std::string& key, std::string& out) {
+    std::string pattern = "\"" + key + "\"";
+    size_t pos = src.find(pattern);
+    if (pos == std::string::npos) return false;
+    pos = src.find('"', pos + pattern.size());
+    if (pos == std::string::npos) return false;
+    size_t start = pos + 1;
+    size_t end = src.find('"', start);
+    if (end == std::string::npos) return false;
+    out = src.substr(start, end - start);
+    return true;
+}
+
+bool extractInt(const std::string& src, const std::string& key, int& out) {
+    std::string pattern = "\"" + key + "\"";
+    size_t pos = src.find(pattern);
+    if (pos == std::string::npos) return false;
+    pos = src.find(':', pos);
+    if (pos == std::string::npos) return false;
+    pos++;
+    while (pos < src.size() && src[pos] == ' ') pos++;
+    try {
+        out = std::stoi(src.substr(pos));
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool extractBool(const std::string& src, const std::string& key, bool& out) {
+    std::string pattern = "\"" + key + "\"";
+    size_t pos = src.find(pattern);
+    if (pos == std::string::npos) return false;
+    pos = src.find(':', pos);
+    if (pos == std::string::npos) return false;
+    pos++;
+    while (pos < src.size() && src[pos] == ' ') pos++;
+    if (src.compare(pos, 4, "true") == 0) { out = true; return true; }
+    if (src.compare(pos, 5, "false") == 0) { out = false; return true; }
+    return false;
+}
+
+std::string serializeCard(const Card& card) {
+    std::ostringstream oss;
+    oss << "{\"id\":" << card.id
+        << ",\"name\":\"" << card.name << "\""
+        << ",\"type\":\"" << cardTypeToString(card.type) << "\""
+        << ",\"move\":{\"forward\":" << card.effect.move.forward << ",\"lateral\":" << card.effect.move.lateral << "}"
+        << ",\"damage\":" << card.effect.damage
+        << ",\"heal\":" << card.effect.heal
+        << "}";
+    return oss.str();
+}
+
+bool deserializeCard(const std::string& json, Card& out) {
+    int id = 0; std::string name; std::string typeStr;
+    if (!extractInt(json, "id", id)) return false;
+    if (!extractString(json, "name", name)) return false;
+    if (!extractString(json, "type", typeStr)) return false;
+    int fwd = 0, lat = 0, dmg = 0, heal = 0;
+    extractInt(json, "forward", fwd);
+    extractInt(json, "lateral", lat);
+    extractInt(json, "damage", dmg);
+    extractInt(json, "heal", heal);
+
+    out.id = id;
+    out.name = name;
+    out.type = cardTypeFromString(typeStr);
+    out.effect.type = out.type;
+    out.effect.move.forward = fwd;
+    out.effect.move.lateral = lat;
+    out.effect.damage = dmg;
+    out.effect.heal = heal;
+    out.mirroredEffect = mirrorEffect(out.effect);
+    return true;
+}
+
+std::string serializeHand(const Hand& hand) {
+    std::ostringstream oss;
+    oss << "{\"cards\":[";
+    for (size_t i = 0; i < hand.size(); ++i) {
+        if (i > 0) oss << ",";
+        oss << legacy::serializeCard(hand.cards()[i]);
+    }
+    oss << "]}";
+    return oss.str();
+}
+
+bool deserializeHand(const std::string& json, Hand& out) {
+    out.clear();
+    size_t start = json.find('[');
+    size_t end = json.rfind(']');
+    if (start == std::string::npos || end == std::string::npos || end <= start) return false;
+    size_t pos = start + 1;
+    while (pos < end) {
+        size_t objStart = json.find('{', pos);
+        if (objStart == std::string::npos || objStart >= end) break;
+        size_t objEnd = json.find('}', objStart);
+        if (objEnd == std::string::npos || objEnd > end) return false;
+        Card c;
+        if (!legacy::deserializeCard(json.substr(objStart, objEnd - objStart + 1), c)) return false;
+        out.addCard(c);
+        pos = objEnd + 1;
+        size_t comma = json.find(',', pos);
+        if (comma != std::string::npos && comma < end) pos = comma + 1;
+    }
+    out.resetUsage();
+    return true;
+}
+
+std::string serializeTurnPlan(const TurnPlan& plan) {
+    std::ostringstream oss;
+    oss << "{\"assignments\":[";
+    for (size_t i = 0; i < plan.assignments.size(); ++i) {
+        const auto& a = plan.assignments[i];
+        if (i > 0) oss << ",";
+        oss << "{\"mechId\":" << a.mechId
+            << ",\"cardId\":" << a.cardId
+            << ",\"useMirror\":" << boolString(a.useMirror) << "}";
+    }
+    oss << "]}";
+    return oss.str();
+}
+
+bool deserializeTurnPlan(const std::string& json, TurnPlan& out) {
+    out.assignments.clear();
+    size_t start = json.find('[');
+    size_t end = json.rfind(']');
+    if (start == std::string::npos || end == std::string::npos || end <= start) return false;
+    size_t pos = start + 1;
+    while (pos < end) {
+        size_t objStart = json.find('{', pos);
+        if (objStart == std::string::npos || objStart >= end) break;
+        size_t objEnd = json.find('}', objStart);
+        if (objEnd == std::string::npos || objEnd > end) return false;
+        std::string slice = json.substr(objStart, objEnd - objStart + 1);
+        PlanAssignment a;
+        int mech = -1, cardId = -1; bool mirror = false;
+        if (!extractInt(slice, "mechId", mech)) return false;
+        if (!extractInt(slice, "cardId", cardId)) return false;
+        extractBool(slice, "useMirror", mirror);
+        a.mechId = mech;
+        a.cardId = cardId;
+        a.useMirror = mirror;
+        out.assignments.push_back(a);
+        pos = objEnd + 1;
+        size_t comma = json.find(',', pos);
+        if (comma != std::string::npos && comma < end) pos = comma + 1;
+    }
+    return true;
+}
+
+} // namespace legacy
+
+namespace {
+
+volatile size_t gSink = 0; // keeps results observable so loops are not elided
+
+template <typename Fn>
+double nsPerOp(int iterations, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+void report(const char* name, double legacyNs, double currentNs) {
+    std::printf("%-22s legacy %9.1f ns   current %9.1f ns   speedup %5.2fx\n", name, legacyNs, currentNs,
+                currentNs > 0.0 ? legacyNs / currentNs : 0.0);
+}
+
+void reportWire(const char* name, double jsonNs, double wireNs, size_t jsonBytes, size_t wireBytes) {
+    std::printf("%-22s json   %9.1f ns   wire    %9.1f ns   bytes %zu -> %zu\n", name, jsonNs, wireNs, jsonBytes,
+                wireBytes);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 20000;
+    if (iterations <= 0) iterations = 20000;
+    SetTraceLogLevel(LOG_NONE);
+
+    Game game;
+    init_game(game);
+    const Hand& hand = game.hand;
+    TurnPlan plan;
+    plan.assignments = {{1, 1, false}, {2, 4, true}, {3, 6, false}};
+
+    std::string buffer;
+    const std::string handJson = ::serializeHand(hand);
+    const std::string planJson = ::serializeTurnPlan(plan);
+
+    report("serializeHand",
+           nsPerOp(iterations, [&]() { gSink = gSink + legacy::serializeHand(hand).size(); }),
+           nsPerOp(iterations, [&]() { ::serializeHand(hand, buffer); gSink = gSink + buffer.size(); }));
+    report("serializeTurnPlan",
+           nsPerOp(iterations, [&]() { gSink = gSink + legacy::serializeTurnPlan(plan).size(); }),
+           nsPerOp(iterations, [&]() { ::serializeTurnPlan(plan, buffer); gSink = gSink + buffer.size(); }));
+
+    Hand decodedHand;
+    TurnPlan decodedPlan;
+    report("deserializeHand",
+           nsPerOp(iterations, [&]() { legacy::deserializeHand(handJson, decodedHand); gSink = gSink + decodedHand.size(); }),
+           nsPerOp(iterations, [&]() { ::deserializeHand(handJson, decodedHand); gSink = gSink + decodedHand.size(); }));
+    report("deserializeTurnPlan",
+           nsPerOp(iterations, [&]() { legacy::deserializeTurnPlan(planJson, decodedPlan); gSink = gSink + decodedPlan.assignments.size(); }),
+           nsPerOp(iterations, [&]() { ::deserializeTurnPlan(planJson, decodedPlan); gSink = gSink + decodedPlan.assignments.size(); }));
+
+    std::vector<uint8_t> wire;
+    encodeHand(hand, wire);
+    const std::vector<uint8_t> handWire = wire;
+    reportWire("encodeHand",
+               nsPerOp(iterations, [&]() { ::serializeHand(hand, buffer); gSink = gSink + buffer.size(); }),
+               nsPerOp(iterations, [&]() { encodeHand(hand, wire); gSink = gSink + wire.size(); }),
+               handJson.size(), handWire.size());
+    HandView handView;
+    reportWire("HandView iterate",
+               nsPerOp(iterations, [&]() { ::deserializeHand(handJson, decodedHand); gSink = gSink + decodedHand.size(); }),
+               nsPerOp(iterations, [&]() {
+                   handView.parse(handWire);
+                   for (const CardView& card : handView) gSink = gSink + card.name.size();
+               }),
+               handJson.size(), handWire.size());
+    return 0;
+}
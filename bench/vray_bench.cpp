@@ -0,0 +1,302 @@
+// vray_bench: microbenchmarks for the simulation, codec, config and mesh hot paths.
+//
+//   vray_bench [--filter S] [--reps N] [--min-time SEC] [--out FILE] [--no-gl] [--list]
+//              [--baseline FILE] [--threshold PCT] [--noise-sigmas K]
+//
+// Writes one JSON result per benchmark (see bench_harness.h) to stdout, or to
+// FILE with a readable table on stdout. Run from the repository root so the
+// mech configs under assets/ are found. CreateMechMesh uploads to the GPU and
+// only runs when a hidden window can be opened; --no-gl skips it.
+//
+// --baseline compares the run against a stored results file and prints one
+// verdict per benchmark (compareBench). Exit code 2 when any benchmark
+// regressed past its threshold (the baseline's threshold_pct, else
+// --threshold, default 10) and its noise band. Thresholds are copied into
+// --out, so a refreshed baseline keeps them. Use --reps 9 or more on shared
+// build agents so the MAD is meaningful.
+#include "bench_harness.h"
+#include "card.h"
+#include "cardRegistry.h"
+#include "common/arena.h"
+#include "game.h"
+#include "raylib.h"
+#include "raymath.h"
+#include "utils/luaUtils.h"
+#include "utils/meshGenerateUtils.h"
+#include "utils/meshMathUtils.h"
+#include "utils/meshMech.h"
+#include "utils/meshProcessUtils.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct BenchArgs {
+    BenchOptions options;
+    std::string outPath;
+    std::string baselinePath;
+    BenchCompareOptions compare;
+    bool noGl = false;
+    bool list = false;
+};
+
+void PrintUsage() {
+    std::printf("usage: vray_bench [--filter S] [--reps N] [--min-time SEC] [--out FILE] [--no-gl] [--list]\n");
+    std::printf("                  [--baseline FILE] [--threshold PCT] [--noise-sigmas K]\n");
+}
+
+bool ParseArgs(int argc, char** argv, BenchArgs& args) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) return false;
+        if (std::strcmp(arg, "--no-gl") == 0) {
+            args.noGl = true;
+            continue;
+        }
+        if (std::strcmp(arg, "--list") == 0) {
+            args.list = true;
+            continue;
+        }
+        if (!value) {
+            std::fprintf(stderr, "missing value for %s\n", arg);
+            return false;
+        }
+        if (std::strcmp(arg, "--filter") == 0) args.options.filter = value;
+        else if (std::strcmp(arg, "--reps") == 0) args.options.repetitions = std::atoi(value);
+        else if (std::strcmp(arg, "--min-time") == 0) args.options.minSampleSeconds = std::atof(value);
+        else if (std::strcmp(arg, "--out") == 0) args.outPath = value;
+        else if (std::strcmp(arg, "--baseline") == 0) args.baselinePath = value;
+        else if (std::strcmp(arg, "--threshold") == 0) args.compare.thresholdPct = std::atof(value);
+        else if (std::strcmp(arg, "--noise-sigmas") == 0) args.compare.noiseSigmas = std::atof(value);
+        else {
+            std::fprintf(stderr, "unknown option %s\n", arg);
+            return false;
+        }
+        ++i;
+    }
+    return args.options.repetitions > 0 && args.options.minSampleSeconds > 0.0;
+}
+
+bool ReadFile(const std::string& path, std::string& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    std::stringstream buf;
+    buf << file.rdbuf();
+    out = buf.str();
+    return true;
+}
+
+MeshUtils::PolySoup Icosahedron() {
+    const float t = (1.0f + std::sqrt(5.0f)) * 0.5f;
+    MeshUtils::PolySoup soup;
+    soup.verts = {{-1, t, 0}, {1, t, 0}, {-1, -t, 0}, {1, -t, 0}, {0, -1, t}, {0, 1, t},
+                  {0, -1, -t}, {0, 1, -t}, {t, 0, -1}, {t, 0, 1}, {-t, 0, -1}, {-t, 0, 1}};
+    soup.indices = {0, 11, 5, 0, 5, 1,  0, 1, 7,  0, 7, 10, 0, 10, 11, 1, 5, 9, 5, 11, 4, 11, 10, 2, 10, 7, 6, 7, 1, 8,
+                    3, 9, 4,  3, 4, 2,  3, 2, 6, 3, 6, 8,  3, 8, 9,   4, 9, 5, 2, 4, 11, 6, 2, 10, 8, 6, 7, 9, 8, 1};
+    return soup;
+}
+
+// CPU-side meshes built here never reach the GPU; free their buffers directly.
+void FreeCpuMesh(Mesh& mesh) {
+    MemFree(mesh.vertices);
+    MemFree(mesh.normals);
+    MemFree(mesh.texcoords);
+    MemFree(mesh.indices);
+    mesh = Mesh{};
+}
+
+void PrintTable(const std::vector<BenchResult>& results) {
+    for (const BenchResult& r : results) {
+        std::printf("%-28s %12.1f ns/op   mad %10.1f   x%d\n", r.name.c_str(), r.medianNs, r.madNs, r.iterations);
+    }
+}
+
+void PrintComparison(const std::vector<BenchComparison>& comparisons) {
+    for (const BenchComparison& c : comparisons) {
+        if (c.verdict == BenchVerdict::New || c.verdict == BenchVerdict::Missing) {
+            std::printf("%-28s %-10s\n", c.name.c_str(), benchVerdictName(c.verdict));
+            continue;
+        }
+        std::printf("%-28s %-10s %12.1f -> %12.1f ns/op  %+7.1f%% (limit %.0f%%)\n", c.name.c_str(),
+                    benchVerdictName(c.verdict), c.baselineNs, c.currentNs, c.changePct, c.thresholdPct);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchArgs args;
+    if (!ParseArgs(argc, argv, args)) {
+        PrintUsage();
+        return 1;
+    }
+    SetTraceLogLevel(LOG_NONE);
+
+    bool gl = false;
+    if (!args.noGl && !args.list) {
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+        InitWindow(64, 64, "vray_bench");
+        gl = IsWindowReady();
+        if (!gl) std::fprintf(stderr, "vray_bench: no GL context, skipping CreateMechMesh\n");
+    }
+
+    // Simulation fixtures.
+    Game game;
+    init_game(game);
+    const GameState root = take_state(game);
+    const std::vector<Card> handCards = game.hand.cardList();
+    const Card& advance = cardByHandle(builtinCardHandle(0));
+    const std::vector<int> mechIds = {1, 2, 3};
+    TurnPlan plan;
+    plan.assignments = {{1, 1, false}, {2, 4, true}, {3, 6, false}};
+    Arena arena;
+    std::string handJson;
+    serializeHand(game.hand, handJson);
+    std::string buffer;
+    Hand decodedHand;
+
+    // Config and mesh fixtures.
+    std::string luaSource;
+    const bool haveLua = ReadFile("assets/mech_bravo.lua", luaSource);
+    if (!haveLua) std::fprintf(stderr, "vray_bench: assets/mech_bravo.lua not found, skipping SimpleLuaParser::Parse\n");
+    const MeshUtils::PolySoup ico = Icosahedron();
+    const MeshUtils::PolySoup sphereSoup = MeshUtils::subdivideSoup(ico, 3);
+    Mesh sphere = MeshUtils::bakeSoupToSphere(sphereSoup, 1.0f);
+    const Matrix offset = MatrixTranslate(2.5f, 0.0f, 0.0f);
+
+    BenchSuite suite;
+    suite.add("applyCard", [&](int n) {
+        for (int i = 0; i < n; ++i) {
+            GameState next = applyCard(root, advance, 1 + i % 3);
+            benchKeep(next.hash);
+        }
+    });
+    suite.add("applyCard/arena", [&](int n) {
+        for (int i = 0; i < n; ++i) {
+            ArenaScope scratch(arena);
+            GameState next = applyCard(root, advance, 1 + i % 3, false, &arena);
+            benchKeep(next.hash);
+        }
+    });
+    suite.add("TurnPlan::validate", [&](int n) {
+        for (int i = 0; i < n; ++i) benchKeep(plan.validate(handCards, mechIds) ? 1 : 0);
+    });
+    suite.add("TurnPlan::validate/hand", [&](int n) {
+        for (int i = 0; i < n; ++i) benchKeep(plan.validate(game.hand, mechIds) ? 1 : 0);
+    });
+    suite.add("buildRandomPlan", [&](int n) {
+        for (int i = 0; i < n; ++i) {
+            game.hand.resetUsage();
+            TurnPlan p = buildRandomPlan(mechIds, game.hand, static_cast<uint32_t>(i));
+            benchKeep(p.assignments.size());
+        }
+    });
+    suite.add("serializeHand", [&](int n) {
+        for (int i = 0; i < n; ++i) {
+            serializeHand(game.hand, buffer);
+            benchKeep(buffer.size());
+        }
+    });
+    suite.add("deserializeHand", [&](int n) {
+        for (int i = 0; i < n; ++i) {
+            deserializeHand(handJson, decodedHand);
+            benchKeep(decodedHand.size());
+        }
+    });
+    if (haveLua) {
+        suite.add("SimpleLuaParser::Parse", [&](int n) {
+            for (int i = 0; i < n; ++i) {
+                SimpleLuaParser parser;
+                parser.Parse(luaSource);
+                benchKeep(parser.tables.size());
+            }
+        });
+    }
+    if (gl) {
+        suite.add("CreateMechMesh", [&](int n) {
+            for (int i = 0; i < n; ++i) {
+                Mesh mech = CreateMechMesh("bravo");
+                benchKeep(static_cast<uint64_t>(mech.triangleCount));
+                UnloadMesh(mech);
+            }
+        });
+    }
+    suite.add("subdivideSoup", [&](int n) {
+        for (int i = 0; i < n; ++i) {
+            MeshUtils::PolySoup fine = MeshUtils::subdivideSoup(ico, 3);
+            benchKeep(fine.indices.size());
+        }
+    });
+    suite.add("computeMeshNormals", [&](int n) {
+        for (int i = 0; i < n; ++i) {
+            MeshUtils::computeMeshNormals(&sphere);
+            benchKeep(static_cast<uint64_t>(sphere.normals[i % (sphere.vertexCount * 3)] * 1000.0f));
+        }
+    });
+    suite.add("combineMeshes", [&](int n) {
+        for (int i = 0; i < n; ++i) {
+            Mesh combined = MeshGenerator::combineMeshes(sphere, sphere, offset);
+            benchKeep(static_cast<uint64_t>(combined.vertexCount));
+            FreeCpuMesh(combined);
+        }
+    });
+
+    std::vector<BenchResult> baseline;
+    if (!args.baselinePath.empty()) {
+        std::string text;
+        std::string error;
+        if (!ReadFile(args.baselinePath, text)) {
+            error = "cannot read file";
+        } else {
+            readBenchJson(text, baseline, &error);
+        }
+        if (!error.empty()) {
+            std::fprintf(stderr, "vray_bench: baseline %s: %s\n", args.baselinePath.c_str(), error.c_str());
+            FreeCpuMesh(sphere);
+            if (gl) CloseWindow();
+            return 1;
+        }
+    }
+
+    int status = 0;
+    if (args.list) {
+        for (const std::string& name : suite.names()) std::printf("%s\n", name.c_str());
+    } else {
+        std::vector<BenchResult> results = suite.run(args.options);
+        for (BenchResult& r : results) {
+            for (const BenchResult& b : baseline) {
+                if (b.name == r.name) r.thresholdPct = b.thresholdPct;
+            }
+        }
+        std::string json;
+        writeBenchJson(results, json);
+        if (!args.outPath.empty()) {
+            std::ofstream file(args.outPath, std::ios::binary);
+            if (!file.write(json.data(), static_cast<std::streamsize>(json.size()))) {
+                std::fprintf(stderr, "vray_bench: cannot write %s\n", args.outPath.c_str());
+                status = 1;
+            }
+        }
+        if (!args.baselinePath.empty()) {
+            args.compare.reportMissing = args.options.filter.empty();
+            std::vector<BenchComparison> comparisons = compareBench(baseline, results, args.compare);
+            PrintComparison(comparisons);
+            if (anyRegressed(comparisons)) status = 2;
+        } else if (args.outPath.empty()) {
+            std::fputs(json.c_str(), stdout);
+        } else {
+            PrintTable(results);
+        }
+    }
+
+    FreeCpuMesh(sphere);
+    if (gl) CloseWindow();
+    return status;
+}
@@ -0,0 +1,65 @@
+#include "npc_plan_task.h"
+#include "game.h"
+
+NpcPlanTask::NpcPlanTask() : plannerLock_(std::make_shared<std::mutex>()) {}
+
+NpcPlanTask::~NpcPlanTask() {
+    cancel();
+}
+
+void NpcPlanTask::start(std::shared_ptr<NpcPlanner> planner, PlannerInput input, double budgetMs) {
+    cancel();
+    auto run = std::make_shared<Run>();
+    run->planner = std::move(planner);
+    if (!run->planner) {
+        run->planner = std::make_shared<RandomNpcPlanner>();
+    }
+    run->plannerLock = plannerLock_;
+    run->input = std::move(input);
+    run->budgetMs = budgetMs;
+    run_ = run;
+    generation_++;
+
+    active_ = true;
+    jobSystem().run(run->group, [run]() {
+        // A cancelled run may still be searching with the same planner; wait it out here, on the worker.
+        std::lock_guard<std::mutex> lock(*run->plannerLock);
+        if (run->cancel.load(std::memory_order_relaxed)) return;
+        PlannerBudget budget;
+        budget.milliseconds = run->budgetMs;
+        budget.cancel = &run->cancel;
+        run->result = run->planner->plan(run->input, budget, &run->stats);
+        run->done.store(true, std::memory_order_release);
+    });
+}
+
+void NpcPlanTask::cancel() {
+    if (!active_) return;
+    run_->cancel.store(true, std::memory_order_relaxed);
+    active_ = false;
+}
+
+const PlannerInput& NpcPlanTask::input() const {
+    static const PlannerInput kEmpty;
+    return run_ ? run_->input : kEmpty;
+}
+
+bool NpcPlanTask::collect(TurnPlan& plan, PlannerStats* stats) {
+    if (!ready()) return false;
+    active_ = false;
+    plan = std::move(run_->result);
+    if (stats) *stats = run_->stats;
+    return true;
+}
+
+void restartNpcPlanning(Game& game) {
+    if (!game.npcTask) {
+        game.npcTask = std::make_shared<NpcPlanTask>();
+    }
+    game.npcTask->start(game.npcPlanner, makePlannerInput(game), game.npcBudgetMs);
+}
+
+bool npcPlanningCurrent(const Game& game) {
+    if (!game.npcTask || !game.npcTask->active()) return false;
+    return game.npcTask->input().playerPlan.assignments == game.currentPlan.assignments;
+}
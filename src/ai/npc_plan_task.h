@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include "ai/npc_planner.h"
+#include "common/jobsystem.h"
+
+/**
+ * Runs one NpcPlanner as a job on the shared pool, off the render thread.
+ *
+ * start() copies its input, so the game can keep changing while the planner
+ * works. The caller polls ready() each frame and then calls collect().
+ * Nothing here waits on the pool: start(), cancel() and collect() only flip
+ * flags and swap the run, because JobSystem::wait would run queued jobs, the
+ * search included, on the calling thread. A cancelled run that has not
+ * started yet skips the search; one already searching stops at its next
+ * cancel check. Each run holds its own state, so a stale job never touches
+ * the current one, and runs sharing a planner take turns on it.
+ */
+class NpcPlanTask {
+public:
+    NpcPlanTask();
+    ~NpcPlanTask();
+    NpcPlanTask(const NpcPlanTask&) = delete;
+    NpcPlanTask& operator=(const NpcPlanTask&) = delete;
+
+    void start(std::shared_ptr<NpcPlanner> planner, PlannerInput input, double budgetMs);
+    // Stop the current run (if any) and discard its result. Never blocks.
+    void cancel();
+
+    // A run was started and has not been collected or cancelled yet.
+    bool active() const { return active_; }
+    bool ready() const { return active_ && run_->done.load(std::memory_order_acquire); }
+    // Number of start() calls; lets callers tell which snapshot a result came from.
+    uint64_t generation() const { return generation_; }
+    const char* plannerName() const { return run_ && run_->planner ? run_->planner->getName() : "none"; }
+    // The snapshot the current (or last) run was started from.
+    const PlannerInput& input() const;
+
+    // Take the finished plan. Returns false, without waiting, if the run has
+    // not completed.
+    bool collect(TurnPlan& plan, PlannerStats* stats = nullptr);
+
+private:
+    // One start() call. Shared with its job, which may outlive the task.
+    struct Run {
+        std::shared_ptr<NpcPlanner> planner;
+        std::shared_ptr<std::mutex> plannerLock; // held while the planner searches
+        PlannerInput input;
+        double budgetMs = 0.0;
+        TurnPlan result;
+        PlannerStats stats;
+        std::atomic<bool> cancel{false};
+        std::atomic<bool> done{false};
+        TaskGroup group;
+    };
+
+    std::shared_ptr<Run> run_;
+    std::shared_ptr<std::mutex> plannerLock_;
+    bool active_ = false;
+    uint64_t generation_ = 0;
+};
+
+struct Game;
+
+// (Re)start background planning from a snapshot of game, creating game.npcTask on first use.
+void restartNpcPlanning(Game& game);
+
+// True when game.npcTask was started against the player's current plan.
+bool npcPlanningCurrent(const Game& game);
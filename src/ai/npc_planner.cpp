@@ -0,0 +1,293 @@
+#include "npc_planner.h"
+#include "ai/plan_enumerator.h"
+#include "common/profiler.h"
+#include "game.h"
+#include "zobrist.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+#include <random>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Plan with registry handles resolved up front into subphase actions, so
+// leaves never search the hand and registered cards' moves come straight from
+// their step tables. The planner never interns its input hand.
+struct CompiledPlan {
+    SubphaseAction actions[3];
+    int count = 0;
+};
+
+CompiledPlan compile(const TurnPlan& plan, const std::vector<Card>& hand, const std::vector<CardHandle>& handles) {
+    CompiledPlan out;
+    for (const auto& a : plan.assignments) {
+        if (out.count == 3) break;
+        for (size_t i = 0; i < hand.size(); ++i) {
+            if (hand[i].id != a.cardId) continue;
+            // Unregistered cards resolve from the input hand itself, stepping without a moves table.
+            bool registered = handles[i] != kInvalidCardHandle;
+            const Card& card = registered ? cardByHandle(handles[i]) : hand[i];
+            out.actions[out.count++] = {a.mechId, a.useMirror ? &card.mirroredEffect : &card.effect,
+                                        registered ? &cardMovesByHandle(handles[i]) : nullptr, a.useMirror};
+            break;
+        }
+    }
+    return out;
+}
+
+uint64_t mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+uint64_t planKey(const TurnPlan& plan) {
+    uint64_t h = 0x504C414Eull;
+    for (const auto& a : plan.assignments) {
+        h = mix(h ^ (static_cast<uint64_t>(static_cast<uint32_t>(a.mechId)) << 33) ^
+                (static_cast<uint64_t>(static_cast<uint32_t>(a.cardId)) << 1) ^ (a.useMirror ? 1u : 0u));
+    }
+    return h;
+}
+
+// Zobrist keys bucket health by tens, but leaves read exact health. Folded
+// into the table key so cached averages never carry over between positions
+// that differ only within a bucket.
+uint64_t exactHealthKey(const GameState& state) {
+    uint64_t h = 0x4845414C5448ull;
+    for (size_t i = 0; i < state.entities.size(); ++i) {
+        h = mix(h ^ (static_cast<uint64_t>(i) << 32) ^ static_cast<uint32_t>(state.entities[i].health));
+    }
+    return h;
+}
+
+// Play the turn the way BossPlayState does: subphase i resolves the reply's
+// and the NPC's i-th assignments together. Evaluate, then undo the subphases
+// in reverse.
+float evaluateLeaf(GameState& state, SubphaseResolver& resolver, std::array<SubphaseUndo, 3>& undo,
+                   const CompiledPlan& npc, const CompiledPlan* reply,
+                   const std::vector<int>& npcMechIds, const std::vector<int>& playerMechIds) {
+    int steps = std::max(npc.count, reply ? reply->count : 0);
+    for (int i = 0; i < steps; ++i) {
+        SubphaseAction both[2];
+        size_t count = 0;
+        if (reply && i < reply->count) both[count++] = reply->actions[i];
+        if (i < npc.count) both[count++] = npc.actions[i];
+        resolver.resolve(state, std::span<const SubphaseAction>(both, count), nullptr, &undo[i]);
+    }
+    float value = ExpectimaxNpcPlanner::evaluate(state, npcMechIds, playerMechIds);
+    for (int i = steps - 1; i >= 0; --i) {
+        SubphaseResolver::undo(state, undo[i]);
+    }
+    return value;
+}
+
+// Living mechs only; dead ones neither act nor reply, as in the live game.
+void collectMechs(const std::vector<Entity>& entities, EntityType type, std::vector<int>& out) {
+    for (const auto& e : entities) {
+        if (e.type == type && e.health > 0) {
+            out.push_back(e.id);
+            if (out.size() >= 3) break;
+        }
+    }
+}
+
+} // namespace
+
+TurnPlan RandomNpcPlanner::plan(const PlannerInput& input, const PlannerBudget&, PlannerStats* stats) {
+    PROFILE_ZONE("RandomNpcPlanner::plan");
+    auto start = Clock::now();
+    TurnPlan plan;
+    std::mt19937 rng(static_cast<uint32_t>(1000 + input.turnNumber));
+
+    for (int mechId : input.npcMechIds) {
+        if (input.hand.empty()) break;
+        std::uniform_int_distribution<size_t> dist(0, input.hand.size() - 1);
+        int cardId = input.hand[dist(rng)].id;
+        bool useMirror = std::bernoulli_distribution(0.5f)(rng);
+        plan.assignments.push_back({mechId, cardId, useMirror});
+    }
+
+    if (stats) {
+        *stats = PlannerStats{};
+        stats->nodes = plan.assignments.size();
+        stats->depthReached = 1;
+        stats->seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+    return plan;
+}
+
+ExpectimaxNpcPlanner::ExpectimaxNpcPlanner(size_t ttCapacity) : tt_(ttCapacity) {}
+
+float ExpectimaxNpcPlanner::evaluate(const GameState& state, const std::vector<int>& npcMechIds, const std::vector<int>& playerMechIds) {
+    constexpr float kDistanceWeight = 0.5f;
+    float npcHealth = 0.0f;
+    float playerHealth = 0.0f;
+    float distance = 0.0f;
+    for (const auto& e : state.entities) {
+        bool isNpc = std::find(npcMechIds.begin(), npcMechIds.end(), e.id) != npcMechIds.end();
+        if (!isNpc) {
+            if (std::find(playerMechIds.begin(), playerMechIds.end(), e.id) != playerMechIds.end()) {
+                playerHealth += static_cast<float>(e.health);
+            }
+            continue;
+        }
+        npcHealth += static_cast<float>(e.health);
+        if (e.health <= 0) continue;
+        int nearest = std::numeric_limits<int>::max();
+        for (const auto& p : state.entities) {
+            if (p.health <= 0 || std::find(playerMechIds.begin(), playerMechIds.end(), p.id) == playerMechIds.end()) continue;
+            int d = std::abs(p.position.x - e.position.x) + std::abs(p.position.y - e.position.y);
+            nearest = std::min(nearest, d);
+        }
+        if (nearest != std::numeric_limits<int>::max()) distance += static_cast<float>(nearest);
+    }
+    return (npcHealth - playerHealth) - kDistanceWeight * distance;
+}
+
+TurnPlan ExpectimaxNpcPlanner::plan(const PlannerInput& input, const PlannerBudget& budget, PlannerStats* stats) {
+    PROFILE_ZONE("ExpectimaxNpcPlanner::plan");
+    auto start = Clock::now();
+    ArenaScope scratch(arena_); // declared first: everything below is destroyed before the reset
+    auto deadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(budget.milliseconds));
+    PlannerStats local;
+
+    enumeratePlans(input.npcMechIds, input.hand, npcPlans_);
+    enumeratePlans(input.playerMechIds, input.hand, playerPlans_);
+    if (npcPlans_.empty()) {
+        if (stats) *stats = local;
+        return {};
+    }
+
+    handles_.clear();
+    for (const auto& c : input.hand) handles_.push_back(findCardHandle(c));
+
+    std::pmr::vector<CompiledPlan> npc(&arena_);
+    npc.reserve(npcPlans_.size());
+    for (const auto& p : npcPlans_) npc.push_back(compile(p, input.hand, handles_));
+
+    // Fixed, seeded reply order so every pass samples a prefix of the same sequence.
+    std::pmr::vector<CompiledPlan> replies(&arena_);
+    replies.reserve(playerPlans_.size());
+    for (const auto& p : playerPlans_) replies.push_back(compile(p, input.hand, handles_));
+    std::mt19937 rng(static_cast<uint32_t>(input.turnNumber) * 2654435761u + 17u);
+    std::shuffle(replies.begin(), replies.end(), rng);
+    if (!input.playerPlan.assignments.empty()) {
+        replies.insert(replies.begin(), compile(input.playerPlan, input.hand, handles_));
+    }
+
+    GameState state = input.state;
+    state.entities.setResource(&arena_);
+    // The zobrist turn key wraps every 64 turns, but the reply sample is seeded
+    // from the full turn number, so the turn goes into the key as well.
+    const uint64_t rootKey = mix(input.state.hash ^ exactHealthKey(input.state) ^ planKey(input.playerPlan) ^
+                                 (static_cast<uint64_t>(replies.size()) << 40) ^
+                                 mix(static_cast<uint64_t>(static_cast<uint32_t>(input.turnNumber))));
+    auto outOfTime = [&]() {
+        if (budget.cancel && budget.cancel->load(std::memory_order_relaxed)) return true;
+        return Clock::now() >= deadline;
+    };
+
+    // Depth 1: player idle. Always completes so a legal plan is returned.
+    size_t best = 0;
+    float bestValue = -std::numeric_limits<float>::max();
+    for (size_t i = 0; i < npc.size(); ++i) {
+        float v = evaluateLeaf(state, resolver_, undo_, npc[i], nullptr, input.npcMechIds, input.playerMechIds);
+        local.nodes++;
+        if (v > bestValue) {
+            bestValue = v;
+            best = i;
+        }
+    }
+    local.depthReached = 1;
+
+    // Depth 2: progressively larger reply samples; a pass only counts if it completes.
+    const int replyCount = static_cast<int>(replies.size());
+    sums_.assign(npc.size(), 0.0);
+    int sampled = 0;
+    bool stopped = false;
+    while (!stopped && sampled < replyCount) {
+        int target = sampled == 0 ? 1 : std::min(replyCount, sampled * 2);
+        for (size_t i = 0; i < npc.size() && !stopped; ++i) {
+            uint64_t key = rootKey ^ planKey(npcPlans_[i]) ^ mix(static_cast<uint64_t>(target));
+            TTEntry cached;
+            if (tt_.probe(key, cached) && cached.depth == 2) {
+                sums_[i] = static_cast<double>(cached.value) * target;
+                local.ttHits++;
+                continue;
+            }
+            for (int r = sampled; r < target; ++r) {
+                sums_[i] += evaluateLeaf(state, resolver_, undo_, npc[i], &replies[r], input.npcMechIds, input.playerMechIds);
+                local.nodes++;
+                if ((local.nodes & 255) == 0 && outOfTime()) {
+                    stopped = true;
+                    break;
+                }
+            }
+            if (!stopped) {
+                tt_.store(key, {static_cast<float>(sums_[i] / target), static_cast<uint16_t>(std::min<size_t>(i, 0xFFFE)), 2, 0});
+            }
+        }
+        if (stopped) break;
+
+        sampled = target;
+        double bestMean = -std::numeric_limits<double>::max();
+        for (size_t i = 0; i < npc.size(); ++i) {
+            double mean = sums_[i] / sampled;
+            if (mean > bestMean) {
+                bestMean = mean;
+                best = i;
+            }
+        }
+        local.depthReached = 2;
+        local.repliesSampled = sampled;
+        if (outOfTime()) break;
+    }
+
+    local.arenaPeakBytes = arena_.bytesUsed();
+    local.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (stats) *stats = local;
+    return npcPlans_[best];
+}
+
+float ExpectimaxNpcPlanner::scorePlan(const PlannerInput& input, const TurnPlan& npc, const TurnPlan& reply) {
+    handles_.clear();
+    for (const auto& c : input.hand) handles_.push_back(findCardHandle(c));
+    CompiledPlan npcPlan = compile(npc, input.hand, handles_);
+    CompiledPlan replyPlan = compile(reply, input.hand, handles_);
+    GameState state = input.state;
+    return evaluateLeaf(state, resolver_, undo_, npcPlan, reply.assignments.empty() ? nullptr : &replyPlan,
+                        input.npcMechIds, input.playerMechIds);
+}
+
+std::unique_ptr<NpcPlanner> makeNpcPlanner(NpcPlannerKind kind) {
+    switch (kind) {
+    case NpcPlannerKind::Random: return std::make_unique<RandomNpcPlanner>();
+    case NpcPlannerKind::Search: return std::make_unique<ExpectimaxNpcPlanner>();
+    }
+    return std::make_unique<RandomNpcPlanner>();
+}
+
+PlannerInput makePlannerInput(const Game& game) {
+    PlannerInput input;
+    input.state.grid = game.grid;
+    input.state.entities = game.entities;
+    input.state.currentTurn = game.turnNumber;
+    input.state.grid.syncOccupancy(input.state.entities);
+    input.state.hash = zobristHash(input.state);
+    game.hand.copyCards(input.hand);
+    input.playerPlan = game.currentPlan;
+    input.turnNumber = game.turnNumber;
+
+    collectMechs(game.entities, ENEMY, input.npcMechIds);
+    collectMechs(game.entities, PLAYER, input.playerMechIds);
+    if (input.npcMechIds.empty()) {
+        // Fallback: use player mechs if no enemies
+        input.npcMechIds = input.playerMechIds;
+    }
+    return input;
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "card.h"
+#include "subphase.h"
+#include "common/arena.h"
+#include "ai/transposition_table.h"
+
+struct Game;
+
+/**
+ * Everything a planner may read, copied out of Game so planning never touches
+ * live game state (and can run off the main thread).
+ */
+struct PlannerInput {
+    GameState state;                // occupancy and hash seeded
+    std::vector<Card> hand;         // shared hand; each side plays from fresh usage
+    std::vector<int> npcMechIds;    // up to 3, in assignment order
+    std::vector<int> playerMechIds; // up to 3
+    TurnPlan playerPlan;            // player's plan so far; searched as the first reply
+    int turnNumber = 0;
+};
+
+struct PlannerBudget {
+    double milliseconds = 8.0;
+    const std::atomic<bool>* cancel = nullptr; // checked between node batches
+};
+
+struct PlannerStats {
+    uint64_t nodes = 0;      // leaf positions evaluated
+    uint64_t ttHits = 0;
+    int depthReached = 0;    // 1 = NPC plans only, 2 = NPC plans vs player replies
+    int repliesSampled = 0;  // player plans averaged per NPC plan at depth 2
+    size_t arenaPeakBytes = 0; // search scratch taken from the planner's arena this decision
+    double seconds = 0.0;
+
+    double nodesPerSecond() const { return seconds > 0.0 ? nodes / seconds : 0.0; }
+};
+
+enum class NpcPlannerKind {
+    Random, // seeded from the turn number; deterministic, used by tests
+    Search  // time-budgeted expectimax
+};
+
+/**
+ * Pluggable NPC planning strategy used by BossNpcSelectState.
+ */
+class NpcPlanner {
+public:
+    virtual ~NpcPlanner() = default;
+    virtual TurnPlan plan(const PlannerInput& input, const PlannerBudget& budget, PlannerStats* stats = nullptr) = 0;
+    virtual const char* getName() const = 0;
+};
+
+/**
+ * The original NpcSelect behaviour: one uniformly random card (with
+ * replacement) and a coin-flip mirror per mech, mt19937 seeded 1000 + turn.
+ */
+class RandomNpcPlanner : public NpcPlanner {
+public:
+    TurnPlan plan(const PlannerInput& input, const PlannerBudget& budget, PlannerStats* stats = nullptr) override;
+    const char* getName() const override { return "Random"; }
+};
+
+/**
+ * Anytime expectimax over (NPC plan, player plan) pairs.
+ *
+ * Depth 1 scores every enumerated NPC plan with the player idle. Depth 2 then
+ * averages each NPC plan over player replies in a fixed shuffled order, doubling
+ * the number of replies per pass until the budget runs out or every reply has
+ * been tried. A known player plan is always the first reply sampled. Only
+ * completed passes update the answer. Each leaf plays the turn through
+ * SubphaseResolver like BossPlayState, pairing {P_i, N_i} per subphase, in
+ * place with SubphaseResolver::undo.
+ * Per-plan averages are cached in the transposition table, so a repeated or
+ * restarted search on the same position skips work it has already done.
+ * Per-decision scratch (compiled plans, the search state's entity copies)
+ * comes from an arena that is reset when plan() returns.
+ */
+class ExpectimaxNpcPlanner : public NpcPlanner {
+public:
+    explicit ExpectimaxNpcPlanner(size_t ttCapacity = 1u << 16);
+    TurnPlan plan(const PlannerInput& input, const PlannerBudget& budget, PlannerStats* stats = nullptr) override;
+    const char* getName() const override { return "Expectimax"; }
+
+    // Value of npc against one player reply (empty = player idle), resolved
+    // and evaluated exactly as a search leaf.
+    float scorePlan(const PlannerInput& input, const TurnPlan& npc, const TurnPlan& reply);
+
+    // Static evaluation from the NPC side: health difference plus closing distance.
+    static float evaluate(const GameState& state, const std::vector<int>& npcMechIds, const std::vector<int>& playerMechIds);
+
+private:
+    TranspositionTable tt_;
+    std::vector<TurnPlan> npcPlans_;
+    std::vector<TurnPlan> playerPlans_;
+    std::vector<double> sums_;
+    std::vector<CardHandle> handles_; // registry handle per input.hand card; invalid if unregistered
+    SubphaseResolver resolver_;
+    std::array<SubphaseUndo, 3> undo_; // one per subphase of the leaf being evaluated
+    Arena arena_;
+};
+
+std::unique_ptr<NpcPlanner> makeNpcPlanner(NpcPlannerKind kind);
+
+// Snapshot the planning inputs from Game (NPC mechs are enemies, or players when none).
+PlannerInput makePlannerInput(const Game& game);
@@ -0,0 +1,150 @@
+#include "plan_enumerator.h"
+#include <algorithm>
+
+namespace {
+
+struct CardOption {
+    const Card* card = nullptr;
+    int remaining = 0;
+    bool mirrorDiffers = false;
+};
+
+struct EnumerationContext {
+    const std::vector<int>& mechIds;
+    std::vector<CardOption>& options;
+    std::vector<TurnPlan>& out;
+    std::vector<PlanAssignment> current;
+    int targetAssignments = 0;
+};
+
+void recurse(EnumerationContext& ctx, size_t mechIndex) {
+    int assigned = static_cast<int>(ctx.current.size());
+    if (assigned == ctx.targetAssignments) {
+        TurnPlan plan;
+        plan.assignments = ctx.current;
+        ctx.out.push_back(std::move(plan));
+        return;
+    }
+    int mechsLeft = static_cast<int>(ctx.mechIds.size() - mechIndex);
+    if (mechsLeft < ctx.targetAssignments - assigned) {
+        return;
+    }
+
+    int mechId = ctx.mechIds[mechIndex];
+    for (auto& opt : ctx.options) {
+        if (opt.remaining == 0) continue;
+        opt.remaining--;
+        for (int mirror = 0; mirror < (opt.mirrorDiffers ? 2 : 1); ++mirror) {
+            ctx.current.push_back({mechId, opt.card->id, mirror == 1});
+            recurse(ctx, mechIndex + 1);
+            ctx.current.pop_back();
+        }
+        opt.remaining++;
+    }
+
+    // Leave this mech idle only when there are more mechs than playable cards.
+    if (mechsLeft > ctx.targetAssignments - assigned) {
+        recurse(ctx, mechIndex + 1);
+    }
+}
+
+} // namespace
+
+void enumeratePlans(const std::vector<int>& mechIds, const std::vector<Card>& hand, std::vector<TurnPlan>& out) {
+    out.clear();
+
+    std::vector<CardOption> options;
+    int totalCards = 0;
+    for (const auto& c : hand) {
+        if (c.id < 0) continue;
+        bool seen = false;
+        for (auto& opt : options) {
+            if (opt.card->id == c.id) {
+                opt.remaining++;
+                seen = true;
+                break;
+            }
+        }
+        if (!seen) {
+            options.push_back({&c, 1, !(c.mirroredEffect == c.effect)});
+        }
+        totalCards++;
+    }
+
+    // TurnPlan allows at most three assignments
+    int mechs = static_cast<int>(std::min<size_t>(mechIds.size(), 3));
+    std::vector<int> roster(mechIds.begin(), mechIds.begin() + mechs);
+
+    EnumerationContext ctx{roster, options, out, {}, 0};
+    ctx.targetAssignments = std::min(mechs, totalCards);
+    ctx.current.reserve(3);
+    if (ctx.targetAssignments == 0) {
+        return;
+    }
+    recurse(ctx, 0);
+}
+
+PlanValidator::PlanValidator(const std::vector<Card>& hand, const std::vector<int>& mechIds) {
+    for (const auto& c : hand) {
+        int slot = slotOf(c.id);
+        if (slot < 0) {
+            if (distinctCards_ == kMaxDistinctCards) {
+                usable_ = false;
+                return;
+            }
+            slot = distinctCards_++;
+            cardIds_[slot] = c.id;
+        }
+        cardCounts_[slot]++;
+    }
+    if (mechIds.size() > static_cast<size_t>(kMaxMechs)) {
+        usable_ = false;
+        return;
+    }
+    for (int id : mechIds) {
+        mechIds_[mechCount_++] = id;
+    }
+}
+
+int PlanValidator::slotOf(int cardId) const {
+    for (int i = 0; i < distinctCards_; ++i) {
+        if (cardIds_[i] == cardId) return i;
+    }
+    return -1;
+}
+
+bool PlanValidator::validate(const TurnPlan& plan) const {
+    const auto& as = plan.assignments;
+    if (as.size() > 3) return false;
+
+    std::array<uint8_t, kMaxDistinctCards> used{};
+    for (size_t i = 0; i < as.size(); ++i) {
+        const PlanAssignment& a = as[i];
+        if (a.mechId < 0) return false;
+        if (mechCount_ > 0) {
+            bool inRoster = false;
+            for (int m = 0; m < mechCount_; ++m) {
+                if (mechIds_[m] == a.mechId) { inRoster = true; break; }
+            }
+            if (!inRoster) return false;
+        }
+        for (size_t j = 0; j < i; ++j) {
+            if (as[j].mechId == a.mechId) return false;
+        }
+        int slot = a.cardId < 0 ? -1 : slotOf(a.cardId);
+        if (slot < 0) return false;
+        if (++used[slot] > cardCounts_[slot]) return false;
+    }
+    return true;
+}
+
+size_t PlanValidator::validateAll(const std::vector<TurnPlan>& plans, std::vector<uint8_t>& results) const {
+    results.resize(plans.size());
+    size_t valid = 0;
+    for (size_t i = 0; i < plans.size(); ++i) {
+        bool ok = validate(plans[i]);
+        results[i] = ok ? 1 : 0;
+        valid += ok ? 1 : 0;
+    }
+    return valid;
+}
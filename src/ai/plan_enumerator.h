@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "card.h"
+
+/**
+ * TurnPlan generation for search-based NPCs.
+ *
+ * This is a reduced set, not every plan TurnPlan::validate accepts:
+ *   - Only the first three mechIds are used (a plan holds at most three).
+ *   - Assignments are listed in mechIds order. Since subphase k pairs each
+ *     side's k-th assignment, a reordered plan can resolve differently; those
+ *     orderings are not generated.
+ *   - Only plans with the most assignments the hand allows, min(mechs, cards),
+ *     are generated. Partial plans that leave a mech idle while cards remain
+ *     are not.
+ * Within that set every plan appears once: copies of the same card id are
+ * interchangeable, and useMirror is only tried when the card's mirroredEffect
+ * differs from its effect (Damage/Heal never differ). The full set grows about
+ * sevenfold for three mechs, which the per-turn search budget cannot cover.
+ */
+void enumeratePlans(const std::vector<int>& mechIds, const std::vector<Card>& hand, std::vector<TurnPlan>& out);
+
+/**
+ * Allocation-free validator for many plans against one hand and roster.
+ * Mirrors TurnPlan::validate but precomputes the hand's card counts once into
+ * fixed-size tables, so validate() is a handful of small loops.
+ */
+class PlanValidator {
+public:
+    static constexpr int kMaxDistinctCards = 32;
+    static constexpr int kMaxMechs = 8;
+
+    PlanValidator(const std::vector<Card>& hand, const std::vector<int>& mechIds);
+
+    // False when the hand/roster exceeded the fixed capacity; fall back to TurnPlan::validate.
+    bool usable() const { return usable_; }
+
+    bool validate(const TurnPlan& plan) const;
+
+    // Writes 1/0 per plan into results (resized once to plans.size()). Returns the valid count.
+    size_t validateAll(const std::vector<TurnPlan>& plans, std::vector<uint8_t>& results) const;
+
+private:
+    int slotOf(int cardId) const;
+
+    std::array<int, kMaxDistinctCards> cardIds_{};
+    std::array<uint8_t, kMaxDistinctCards> cardCounts_{};
+    int distinctCards_ = 0;
+    std::array<int, kMaxMechs> mechIds_{};
+    int mechCount_ = 0;
+    bool usable_ = true;
+};
@@ -0,0 +1,66 @@
+#include "transposition_table.h"
+#include <cstring>
+
+namespace {
+
+// Set on every stored entry so a written slot never packs to the empty value 0.
+constexpr uint64_t kOccupiedBit = 1ull << 63;
+
+uint64_t pack(const TTEntry& e) {
+    uint32_t valueBits = 0;
+    std::memcpy(&valueBits, &e.value, sizeof(valueBits));
+    return static_cast<uint64_t>(valueBits) |
+           (static_cast<uint64_t>(e.bestPlan) << 32) |
+           (static_cast<uint64_t>(e.depth) << 48) |
+           (static_cast<uint64_t>(e.flags & 0x7F) << 56) |
+           kOccupiedBit;
+}
+
+TTEntry unpack(uint64_t bits) {
+    TTEntry e;
+    uint32_t valueBits = static_cast<uint32_t>(bits);
+    std::memcpy(&e.value, &valueBits, sizeof(valueBits));
+    e.bestPlan = static_cast<uint16_t>(bits >> 32);
+    e.depth = static_cast<uint8_t>(bits >> 48);
+    e.flags = static_cast<uint8_t>((bits >> 56) & 0x7F);
+    return e;
+}
+
+} // namespace
+
+TranspositionTable::TranspositionTable(size_t capacity) {
+    size_t size = 1024;
+    while (size < capacity) size <<= 1;
+    slots_ = std::make_unique<Slot[]>(size);
+    mask_ = size - 1;
+}
+
+bool TranspositionTable::probe(uint64_t key, TTEntry& out) const {
+    const Slot& slot = slots_[key & mask_];
+    uint64_t data = slot.data.load(std::memory_order_relaxed);
+    uint64_t check = slot.check.load(std::memory_order_relaxed);
+    if (data == 0 || (check ^ data) != key) {
+        return false;
+    }
+    out = unpack(data);
+    return true;
+}
+
+void TranspositionTable::store(uint64_t key, const TTEntry& entry) {
+    Slot& slot = slots_[key & mask_];
+    uint64_t oldData = slot.data.load(std::memory_order_relaxed);
+    uint64_t oldCheck = slot.check.load(std::memory_order_relaxed);
+    if (oldData != 0 && (oldCheck ^ oldData) == key && unpack(oldData).depth > entry.depth) {
+        return; // keep the deeper result for this position
+    }
+    uint64_t data = pack(entry);
+    slot.check.store(key ^ data, std::memory_order_relaxed);
+    slot.data.store(data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i <= mask_; ++i) {
+        slots_[i].check.store(0, std::memory_order_relaxed);
+        slots_[i].data.store(0, std::memory_order_relaxed);
+    }
+}
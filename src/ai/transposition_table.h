@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * Search result cached per position. Packs into 64 bits so a table slot can be
+ * read and written with two relaxed atomics.
+ */
+struct TTEntry {
+    float value = 0.0f;
+    uint16_t bestPlan = 0xFFFF; // index into the caller's plan list
+    uint8_t depth = 0;
+    uint8_t flags = 0; // caller-defined, low 7 bits only
+};
+
+/**
+ * Fixed-size, lock-free transposition table keyed on GameState::hash.
+ *
+ * Each slot stores (key ^ data, data); a reader accepts an entry only if the two
+ * words agree, so a write torn by another thread reads as a miss rather than as
+ * a wrong result. Safe to share between search threads without locks.
+ */
+class TranspositionTable {
+public:
+    // capacity is rounded up to a power of two (minimum 1024 slots)
+    explicit TranspositionTable(size_t capacity = 1u << 16);
+
+    bool probe(uint64_t key, TTEntry& out) const;
+
+    // Replaces the slot when it holds another position or a shallower result.
+    void store(uint64_t key, const TTEntry& entry);
+
+    void clear();
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> check{0};
+        std::atomic<uint64_t> data{0};
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_ = 0;
+};
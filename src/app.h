@@ -1,6 +1,7 @@
 #pragma once
 
 #include "raylib.h"
+#include "perf_stats.h"
 #include <memory>
 
 // High-level application context scaffolding, per architecture.md
@@ -104,6 +105,8 @@ struct UiState {
     bool paletteEnabled = false;
     float paletteStrength = 1.0f;
     bool renderControlsCollapsed = true;
+    bool showAllocOverlay = false;
+    bool showPerfHud = false;
 };
 
 struct Game; // forward declare until game module exists
@@ -122,4 +125,5 @@ struct AppContext {
     RenderShaders shaders;
     RenderModels models;
     UiState ui;
+    FrameStats stats; // filled each frame for the performance HUD
 };
@@ -2,6 +2,7 @@
 #include "bossNpcSelectState.h"
 #include "game.h"
 #include "ui.h"
+#include "ai/npc_plan_task.h"
 #include <vector>
 
 bool BossCardSelectState::canEnter(Game& game) {
@@ -18,6 +19,8 @@ void BossCardSelectState::enter(Game& game) {
     playerPlanValid_ = false;
     game.hand.resetUsage();
     game.currentPlan.assignments.clear();
+    // NPC starts thinking while the player picks cards
+    restartNpcPlanning(game);
     TraceLog(LOG_INFO, "[BossState] Entering CardSelect");
 }
 
@@ -26,6 +29,12 @@ void BossCardSelectState::exit(Game& game) {
 }
 
 std::unique_ptr<BossState> BossCardSelectState::update(Game& game, const CardActions& actions, float dt) {
+    // Restart NPC planning against the player's latest assignments
+    if (!npcPlanningCurrent(game)) {
+        TraceLog(LOG_DEBUG, "[CardSelect] Player plan changed, restarting NPC planning");
+        restartNpcPlanning(game);
+    }
+
     // Check if player submitted a plan via OK button
     if (actions.playSequence) {
         TraceLog(LOG_INFO, "[CardSelect] OK button pressed, validating player plan...");
@@ -44,7 +53,7 @@ std::unique_ptr<BossState> BossCardSelectState::update(Game& game, const CardAct
                  game.currentPlan.assignments.size());
 
         std::string err;
-        if (game.currentPlan.validate(game.hand.cards, playerMechs, &err)) {
+        if (game.currentPlan.validate(game.hand, playerMechs, &err)) {
             // Valid plan submitted
             TraceLog(LOG_INFO, "[CardSelect::PLAN_VALID] Player plan validated successfully");
             playerPlanValid_ = true;
@@ -3,8 +3,8 @@
 #include "game.h"
 #include "ui.h"
 #include "card.h"
+#include "ai/npc_plan_task.h"
 #include <vector>
-#include <random>
 #include <sstream>
 #include <algorithm>
 
@@ -21,9 +21,16 @@ bool BossNpcSelectState::canExit(Game& game) {
 void BossNpcSelectState::enter(Game& game) {
     npcPlanReady_ = false;
     elapsed_ = 0.0f;
-    buildNpcPlan(game);
-    npcPlanReady_ = true;
-    TraceLog(LOG_INFO, "[NpcSelect] Entering NpcSelect state, generated plan: %s", game.lastAiPlanText.c_str());
+    // Normally already running since CardSelect; restart only if the snapshot is stale
+    if (!npcPlanningCurrent(game)) {
+        restartNpcPlanning(game);
+    }
+    {
+        std::ostringstream oss;
+        oss << "[NpcSelect] Entering NpcSelect state, waiting for " << game.npcTask->plannerName() << " planner, mechs:";
+        for (int id : game.npcTask->input().npcMechIds) oss << " " << id;
+        TraceLog(LOG_INFO, "%s", oss.str().c_str());
+    }
 }
 
 void BossNpcSelectState::exit(Game& game) {
@@ -33,7 +40,11 @@ void BossNpcSelectState::exit(Game& game) {
 std::unique_ptr<BossState> BossNpcSelectState::update(Game& game, const CardActions& actions, float dt) {
     elapsed_ += dt;
 
-    // NPC plan is generated immediately on enter, check if we can transition
+    // Collect the background plan without blocking the frame
+    if (!npcPlanReady_ && game.npcTask && game.npcTask->ready()) {
+        collectNpcPlan(game);
+    }
+
     if (canExit(game)) {
         TraceLog(LOG_INFO, "[NpcSelect::NPC_PLAN_READY] NPC plan ready, requesting transition to Play");
         auto nextState = std::make_unique<BossPlayState>();
@@ -48,59 +59,22 @@ std::unique_ptr<BossState> BossNpcSelectState::update(Game& game, const CardActi
     return nullptr;  // Stay in current state
 }
 
-void BossNpcSelectState::buildNpcPlan(Game& game) {
-    // Collect enemy mech IDs
-    std::vector<int> enemyMechIds;
-    for (const auto& entity : game.entities) {
-        if (entity.type == ENEMY) {
-            enemyMechIds.push_back(entity.id);
-            if (enemyMechIds.size() >= 3) break;
-        }
-    }
-
-    if (enemyMechIds.empty()) {
-        // Fallback: use player mechs if no enemies
-        for (const auto& entity : game.entities) {
-            if (entity.type == PLAYER) {
-                enemyMechIds.push_back(entity.id);
-                if (enemyMechIds.size() >= 3) break;
-            }
-        }
-    }
-
-    // Reset NPC plan
-    game.lastAiPlan.assignments.clear();
-
-    // Use deterministic seed based on turn number
-    uint32_t seed = static_cast<uint32_t>(1000 + game.turnNumber);
-    std::mt19937 rng(seed);
-
-    // Debug: log which mechs we plan for
-    {
-        std::ostringstream oss;
-        oss << "[NpcSelect] Mechs:";
-        for (int id : enemyMechIds) oss << " " << id;
-        TraceLog(LOG_INFO, "%s", oss.str().c_str());
-    }
-
-    // Pick random cards for each mech
-    auto pickCardId = [&]() -> int {
-        if (game.hand.cards.empty()) return -1;
-        std::uniform_int_distribution<size_t> dist(0, game.hand.cards.size() - 1);
-        return game.hand.cards[dist(rng)].id;
-    };
-
-    for (int mechId : enemyMechIds) {
-        int cardId = pickCardId();
-        if (cardId == -1) continue;
-        bool useMirror = std::bernoulli_distribution(0.5f)(rng);
-        game.lastAiPlan.assignments.push_back({mechId, cardId, useMirror});
-        TraceLog(LOG_INFO, "[NpcSelect] mech %d -> card %d mirror %d", mechId, cardId, useMirror ? 1 : 0);
+void BossNpcSelectState::collectNpcPlan(Game& game) {
+    const char* plannerName = game.npcTask->plannerName();
+    PlannerStats stats;
+    game.npcTask->collect(game.lastAiPlan, &stats);
+    TraceLog(LOG_INFO, "[NpcSelect] %s planner: %llu nodes in %.2f ms (%.0f nodes/sec), depth %d, %d replies, %.1f KB scratch, %.2f s waited",
+             plannerName, static_cast<unsigned long long>(stats.nodes), stats.seconds * 1000.0,
+             stats.nodesPerSecond(), stats.depthReached, stats.repliesSampled, stats.arenaPeakBytes / 1024.0, elapsed_);
+
+    const std::vector<int>& npcMechIds = game.npcTask->input().npcMechIds;
+    for (const auto& a : game.lastAiPlan.assignments) {
+        TraceLog(LOG_INFO, "[NpcSelect] mech %d -> card %d mirror %d", a.mechId, a.cardId, a.useMirror ? 1 : 0);
     }
 
     // Validate NPC plan
     std::string err;
-    if (!game.lastAiPlan.validate(game.hand.cards, enemyMechIds, &err)) {
+    if (!game.lastAiPlan.validate(game.hand, npcMechIds, &err)) {
         TraceLog(LOG_WARNING, "[NpcSelect] NPC plan invalid: %s", err.c_str());
     }
 
@@ -109,13 +83,8 @@ void BossNpcSelectState::buildNpcPlan(Game& game) {
         std::ostringstream oss;
         for (size_t i = 0; i < game.lastAiPlan.assignments.size(); ++i) {
             const auto& a = game.lastAiPlan.assignments[i];
-            std::string cardName = "?";
-            for (const auto& c : game.hand.cards) {
-                if (c.id == a.cardId) {
-                    cardName = c.name;
-                    break;
-                }
-            }
+            const Card* card = game.hand.find(a.cardId);
+            std::string cardName = card ? card->name : "?";
             if (i > 0) oss << " | ";
             oss << "M" << a.mechId << ":" << cardName;
             if (a.useMirror) oss << "(M)";
@@ -6,9 +6,11 @@
 /**
  * BossNpcSelectState: NPC generates its plan
  * 
- * Generates random plan for enemy mechs.
+ * Collects the enemy plan from game.npcTask, which CardSelect started in the
+ * background (game.npcPlanner, or seeded random picks when none is set).
+ * Waits without blocking the frame until the task finishes.
  * Entry: Player has submitted valid plan
- * Exit: NPC plan generated and validated
+ * Exit: NPC plan collected and validated
  * Next: BossPlayState
  */
 class BossNpcSelectState : public BossState {
@@ -24,5 +26,5 @@ private:
     bool npcPlanReady_ = false;
     float elapsed_ = 0.0f;
     
-    void buildNpcPlan(Game& game);
+    void collectNpcPlan(Game& game);
 };
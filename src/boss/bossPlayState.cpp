@@ -6,6 +6,8 @@
 #include "card.h"
 #include "entity.h"
 #include "world/world.h"
+#include "sim/replay.h"
+#include "zobrist.h"
 #include <algorithm>
 
 bool BossPlayState::canEnter(Game& game) {
@@ -28,6 +30,8 @@ void BossPlayState::enter(Game& game) {
     pendingNpc_ = game.lastAiPlan.assignments;
     playSubphase_ = 0;
     playSubphaseTime_ = 0.0f;
+    // One state for the whole play phase; subphases resolve into it in place.
+    sync_state(game, state_);
 
     if (pendingPlayer_.empty() && pendingNpc_.empty()) {
         TraceLog(LOG_WARNING, "[Play] No assignments to execute");
@@ -39,6 +43,10 @@ void BossPlayState::exit(Game& game) {
     
     // Clean up for next round
     game.turnNumber++;
+    if (game.replay) {
+        zobristAdvanceTurn(state_);
+        recordReplayTurn(*game.replay, game.currentPlan, game.lastAiPlan, state_);
+    }
     game.hand.resetUsage();
     game.currentPlan.assignments.clear();
     game.lastAiPlan.assignments.clear();
@@ -71,79 +79,28 @@ std::unique_ptr<BossState> BossPlayState::update(Game& game, const CardActions&
 }
 
 void BossPlayState::runPlaySubphase(Game& game) {
-    // Apply one assignment from player, one from NPC
-    bool playerDone = pendingPlayer_.empty();
-    bool npcDone = pendingNpc_.empty();
-
-    if (!playerDone) {
-        PlanAssignment assignment = pendingPlayer_.front();
+    // Next player card and next NPC card resolve together against the same state
+    subphase_.clear();
+    if (!pendingPlayer_.empty()) {
+        subphase_.push_back(pendingPlayer_.front());
         pendingPlayer_.erase(pendingPlayer_.begin());
-        applyAssignment(game, assignment);
     }
-
-    if (!npcDone) {
-        PlanAssignment assignment = pendingNpc_.front();
+    if (!pendingNpc_.empty()) {
+        subphase_.push_back(pendingNpc_.front());
         pendingNpc_.erase(pendingNpc_.begin());
-        applyAssignment(game, assignment);
     }
 
-    TraceLog(LOG_INFO, "[PlaySubphase] remaining P:%zu N:%zu", pendingPlayer_.size(), pendingNpc_.size());
-}
+    resolver_.resolve(state_, game.hand, subphase_, &deltas_);
+    write_state(game, state_);
 
-bool BossPlayState::applyAssignment(Game& game, const PlanAssignment& a) {
-    // Find card
-    const Card* card = nullptr;
-    for (const auto& c : game.hand.cards) {
-        if (c.id == a.cardId) {
-            card = &c;
-            break;
+    for (const CardDelta& delta : deltas_) {
+        if (delta.entityId == -1 || delta.type != CardType::Move) continue;
+        if (delta.blocked) {
+            TraceLog(LOG_INFO, "[Move] Mech %d: blocked at (%d,%d)", delta.entityId, delta.fromX, delta.fromY);
+        } else if (delta.fromX != delta.toX || delta.fromY != delta.toY) {
+            TraceLog(LOG_INFO, "[Move] Mech %d: -> (%d,%d)", delta.entityId, delta.toX, delta.toY);
         }
     }
-    if (!card) return true;
-
-    // Record state before
-    GameState before{game.grid, game.entities};
-    GameState after = applyCard(before, *card, a.mechId, a.useMirror);
 
-    // Check if move was blocked
-    bool moved = false;
-    if (card->type == CardType::Move) {
-        Vector2 beforePos{}, afterPos{};
-        auto findPos = [](const std::vector<Entity>& ents, int id, Vector2& out) -> bool {
-            for (const auto& e : ents) {
-                if (e.id == id) {
-                    out = e.position;
-                    return true;
-                }
-            }
-            return false;
-        };
-
-        bool haveBefore = findPos(before.entities, a.mechId, beforePos);
-        bool haveAfter = findPos(after.entities, a.mechId, afterPos);
-        
-        if (haveBefore && haveAfter) {
-            if (std::round(beforePos.x) != std::round(afterPos.x) ||
-                std::round(beforePos.y) != std::round(afterPos.y)) {
-                moved = true;
-            }
-        }
-    }
-
-    // Apply the change
-    game.grid = after.grid;
-    game.entities = after.entities;
-
-    if (moved) {
-        Vector2 pos{};
-        for (const auto& e : game.entities) {
-            if (e.id == a.mechId) {
-                pos = e.position;
-                break;
-            }
-        }
-        TraceLog(LOG_INFO, "[Move] Mech %d: -> (%.0f,%.0f)", a.mechId, pos.x, pos.y);
-    }
-
-    return true;
+    TraceLog(LOG_INFO, "[PlaySubphase] remaining P:%zu N:%zu", pendingPlayer_.size(), pendingNpc_.size());
 }
@@ -1,15 +1,16 @@
 #pragma once
 
 #include "bossState.h"
+#include "subphase.h"
 #include <memory>
 #include <vector>
 
-struct PlanAssignment;
-
 /**
  * BossPlayState: Execute both player and NPC plans
  * 
- * Applies card effects in sequence, one subphase per frame.
+ * Each subphase plays the next player card and the next NPC card together
+ * (SubphaseResolver), one subphase per SUBPHASE_DURATION. The state is synced
+ * from Game once on entry; subphases resolve into it and write back in place.
  * Entry: Both plans are locked and valid
  * Exit: All assignments executed
  * Next: BossCardSelectState (new round) or BossEndGameState (game over)
@@ -30,6 +31,10 @@ private:
     float playSubphaseTime_ = 0.0f;
     static constexpr float SUBPHASE_DURATION = 0.5f;
 
+    GameState state_;
+    SubphaseResolver resolver_;
+    std::vector<PlanAssignment> subphase_;
+    std::vector<CardDelta> deltas_;
+
     void runPlaySubphase(Game& game);
-    bool applyAssignment(Game& game, const PlanAssignment& a);
 };
@@ -1,51 +1,85 @@
 #include "card.h"
 #include "ui.h"
+#include "zobrist.h"
+#include "utils/jsonCodec.h"
 #include <algorithm>
 #include <unordered_map>
 #include <unordered_set>
-#include <cmath>
 #include <random>
-#include <sstream>
 
 namespace {
 
-Vector2 applyMoveVector(const Vector2& start, const MoveVector& mv, Facing facing) {
-    int dx = mv.lateral;
-    int dy = mv.forward;
+// Where a step from (fromX, fromY) ends; false when the mover stays put.
+// On-board starts use the grid's destination table; hand-built states may start
+// off the board, in which case the target is clamped directly.
+bool stepTarget(const Grid& grid, int fromX, int fromY, CellDelta step, int& toX, int& toY, bool& blocked) {
+    blocked = false;
+    if (grid.isValidPosition(fromX, fromY)) {
+        int from = Grid::cellIndex(fromX, fromY);
+        int to = grid.moveDestination(fromX, fromY, step, &blocked);
+        if (to == from) return false;
+        toX = to % Grid::SIZE;
+        toY = to / Grid::SIZE;
+        return true;
+    }
+    toX = std::clamp(fromX + step.dx, 0, Grid::SIZE - 1);
+    toY = std::clamp(fromY + step.dy, 0, Grid::SIZE - 1);
+    blocked = grid.isOccupied(toX, toY);
+    return !blocked;
+}
 
-    switch (facing) {
-    case Facing::North:
-        break;
-    case Facing::East: {
-        int ndx = dy;
-        int ndy = -dx;
-        dx = ndx; dy = ndy;
+CardDelta resolveEffect(GameState& state, const CardEffect& effect, const CardMoves* moves, int playerId, bool useMirror) {
+    CardDelta delta;
+    delta.type = effect.type;
+
+    int targetId = effect.type == CardType::Damage ? effect.targetEntityId : playerId;
+    auto it = std::find_if(state.entities.begin(), state.entities.end(),
+        [targetId](const Entity& e) { return e.id == targetId; });
+    if (it == state.entities.end()) {
+        return delta;
+    }
+    int slot = static_cast<int>(it - state.entities.begin());
+
+    delta.entityId = it->id;
+    delta.fromX = static_cast<int16_t>(it->position.x);
+    delta.fromY = static_cast<int16_t>(it->position.y);
+    delta.toX = delta.fromX;
+    delta.toY = delta.fromY;
+
+    switch (effect.type) {
+    case CardType::Move: {
+        CellDelta step = moves ? moves->at(it->facing, useMirror) : moveDelta(effect.move, it->facing);
+        int toX = 0;
+        int toY = 0;
+        if (!stepTarget(state.grid, delta.fromX, delta.fromY, step, toX, toY, delta.blocked)) {
+            break; // blocked, or clamped in place at the board edge
+        }
+        state.entities.edit(slot).position = {toX, toY};
+        state.grid.moveOccupant(delta.fromX, delta.fromY, toX, toY, it->type);
+        state.hash ^= zobristCellKey(slot, delta.fromX, delta.fromY) ^ zobristCellKey(slot, toX, toY);
+        delta.toX = static_cast<int16_t>(toX);
+        delta.toY = static_cast<int16_t>(toY);
         break;
     }
-    case Facing::South:
-        dx = -dx;
-        dy = -dy;
+    case CardType::Damage: {
+        Entity& target = state.entities.edit(slot);
+        int before = target.health;
+        target.health = applyHealthChange(before, -effect.damage);
+        state.hash ^= zobristHealthKey(slot, before) ^ zobristHealthKey(slot, target.health);
+        delta.healthDelta = static_cast<int16_t>(target.health - before);
         break;
-    case Facing::West: {
-        int ndx = -dy;
-        int ndy = dx;
-        dx = ndx; dy = ndy;
+    }
+    case CardType::Heal: {
+        Entity& target = state.entities.edit(slot);
+        int before = target.health;
+        target.health = applyHealthChange(before, effect.heal);
+        state.hash ^= zobristHealthKey(slot, before) ^ zobristHealthKey(slot, target.health);
+        delta.healthDelta = static_cast<int16_t>(target.health - before);
         break;
     }
     }
 
-    return {start.x + static_cast<float>(dx), start.y + static_cast<float>(dy)};
-}
-
-bool positionOccupied(const std::vector<Entity>& entities, int selfId, const Vector2& target) {
-    for (const auto& e : entities) {
-        if (e.id == selfId) continue;
-        if (static_cast<int>(std::round(e.position.x)) == static_cast<int>(std::round(target.x)) &&
-            static_cast<int>(std::round(e.position.y)) == static_cast<int>(std::round(target.y))) {
-            return true;
-        }
-    }
-    return false;
+    return delta;
 }
 
 const Card* findCard(const std::vector<Card>& hand, int cardId) {
@@ -57,47 +91,105 @@ const Card* findCard(const std::vector<Card>& hand, int cardId) {
     return nullptr;
 }
 
-std::unordered_map<int, int> countTotals(const std::vector<Card>& cards) {
-    std::unordered_map<int, int> totals;
-    for (const auto& c : cards) {
-        totals[c.id]++;
-    }
-    return totals;
-}
-
 } // namespace
 
 void Hand::clear() {
-    cards.clear();
-    usage.clear();
+    for (int i = 0; i < slots_; ++i) {
+        int id = slotIds_[i];
+        if (id >= 0 && id < kDirectIds) directSlot_[id] = 0;
+    }
+    total_.fill(0);
+    slots_ = 0;
+    count_ = 0;
+    resetUsage();
 }
 
 void Hand::addCard(const Card& card) {
-    cards.push_back(card);
+    addCard(internCard(card));
+}
+
+void Hand::addCard(CardHandle handle) {
+    if (handle == kInvalidCardHandle) {
+        return;
+    }
+    if (count_ >= kMaxCards) {
+        TraceLog(LOG_WARNING, "Hand is full (%d cards); ignoring card %d", kMaxCards, cardByHandle(handle).id);
+        return;
+    }
+    int id = cardByHandle(handle).id;
+    int slot = slotOf(id);
+    if (slot < 0) {
+        slot = slots_++;
+        slotIds_[slot] = id;
+        slotFirst_[slot] = handle;
+        if (id >= 0 && id < kDirectIds) directSlot_[id] = static_cast<uint8_t>(slot + 1);
+    }
+    int position = count_++;
+    handles_[position] = handle;
+    cardSlot_[position] = static_cast<uint8_t>(slot);
+    cardRank_[position] = total_[slot]++;
+    // Copies ranked below total - used are available; the one at the new boundary joins them,
+    // which is an older copy (not this one) while some are marked used.
+    available_ |= uint64_t{1} << cardAtRank(slot, total_[slot] - used_[slot] - 1);
 }
 
 void Hand::resetUsage() {
-    usage.clear();
+    used_.fill(0);
+    available_ = cards().bits;
 }
 
-int Hand::totalCount(int cardId) const {
-    int count = 0;
-    for (const auto& c : cards) {
-        if (c.id == cardId) {
-            count++;
-        }
+void Hand::copyCards(std::vector<Card>& out) const {
+    out.clear();
+    for (const Card& c : cards()) out.push_back(c);
+}
+
+std::vector<Card> Hand::cardList() const {
+    std::vector<Card> out;
+    out.reserve(count_);
+    copyCards(out);
+    return out;
+}
+
+const Card* Hand::find(int cardId) const {
+    int slot = slotOf(cardId);
+    return slot < 0 ? nullptr : &cardByHandle(slotFirst_[slot]);
+}
+
+CardHandle Hand::findHandle(int cardId) const {
+    int slot = slotOf(cardId);
+    return slot < 0 ? kInvalidCardHandle : slotFirst_[slot];
+}
+
+int Hand::slotOf(int cardId) const {
+    if (cardId >= 0 && cardId < kDirectIds) {
+        return directSlot_[cardId] - 1;
     }
-    return count;
+    for (int i = 0; i < slots_; ++i) {
+        if (slotIds_[i] == cardId) return i;
+    }
+    return -1;
+}
+
+int Hand::cardAtRank(int slot, int rank) const {
+    for (int i = 0; i < count_; ++i) {
+        if (cardSlot_[i] == slot && cardRank_[i] == rank) return i;
+    }
+    return -1;
+}
+
+int Hand::totalCount(int cardId) const {
+    int slot = slotOf(cardId);
+    return slot < 0 ? 0 : total_[slot];
 }
 
 int Hand::usedCount(int cardId) const {
-    auto it = usage.find(cardId);
-    return it == usage.end() ? 0 : it->second;
+    int slot = slotOf(cardId);
+    return slot < 0 ? 0 : used_[slot];
 }
 
 int Hand::availableCount(int cardId) const {
-    int available = totalCount(cardId) - usedCount(cardId);
-    return available < 0 ? 0 : available;
+    int slot = slotOf(cardId);
+    return slot < 0 ? 0 : total_[slot] - used_[slot];
 }
 
 bool Hand::canPlay(int cardId) const {
@@ -105,50 +197,41 @@ bool Hand::canPlay(int cardId) const {
 }
 
 bool Hand::markUsed(int cardId) {
-    if (!canPlay(cardId)) {
+    int slot = slotOf(cardId);
+    if (slot < 0 || used_[slot] >= total_[slot]) {
         return false;
     }
-    usage[cardId]++;
+    used_[slot]++;
+    // The highest-ranked available copy drops out.
+    int position = cardAtRank(slot, total_[slot] - used_[slot]);
+    available_ &= ~(uint64_t{1} << position);
     return true;
 }
 
 bool Hand::unmarkUsed(int cardId) {
-    auto it = usage.find(cardId);
-    if (it == usage.end()) return false;
-    if (it->second <= 1) {
-        usage.erase(it);
-    } else {
-        it->second--;
-    }
+    int slot = slotOf(cardId);
+    if (slot < 0 || used_[slot] == 0) return false;
+    int position = cardAtRank(slot, total_[slot] - used_[slot]);
+    used_[slot]--;
+    available_ |= uint64_t{1} << position;
     return true;
 }
 
-std::vector<Card> Hand::availableCards() const {
-    std::vector<Card> result;
-    auto totals = countTotals(cards);
-    std::unordered_map<int, int> emitted;
-    for (const auto& c : cards) {
-        int remaining = totals[c.id] - usedCount(c.id) - emitted[c.id];
-        if (remaining > 0) {
-            result.push_back(c);
-            emitted[c.id]++;
-        }
+const Card& Hand::availableAt(size_t index) const {
+    uint64_t bits = available_;
+    for (size_t i = 0; i < index; ++i) {
+        bits &= bits - 1;
     }
-    return result;
+    return cardByHandle(handles_[std::countr_zero(bits)]);
 }
 
-std::vector<int> Hand::availableCardIds() const {
-    std::vector<int> ids;
-    auto totals = countTotals(cards);
-    std::unordered_map<int, int> emitted;
-    for (const auto& c : cards) {
-        int remaining = totals[c.id] - usedCount(c.id) - emitted[c.id];
-        if (remaining > 0) {
-            ids.push_back(c.id);
-            emitted[c.id]++;
-        }
+size_t Hand::availableCardIds(std::span<int> out) const {
+    size_t n = 0;
+    for (const Card& c : available()) {
+        if (n == out.size()) break;
+        out[n++] = c.id;
     }
-    return ids;
+    return n;
 }
 
 // T_051: Deck implementations
@@ -157,14 +240,17 @@ void Deck::clear() {
 }
 
 void Deck::addCard(const Card& card) {
-    cards.push_back(card);
+    CardHandle handle = internCard(card);
+    if (handle != kInvalidCardHandle) {
+        cards.push_back(handle);
+    }
 }
 
-Card Deck::draw() {
+CardHandle Deck::draw() {
     if (cards.empty()) {
-        return Card{};  // Return empty card if deck is empty
+        return kInvalidCardHandle;
     }
-    Card drawn = cards.back();
+    CardHandle drawn = cards.back();
     cards.pop_back();
     return drawn;
 }
@@ -199,14 +285,7 @@ MechStats calculateMechStats(int mechId, const Game& game) {
     for (const auto& assignment : game.currentPlan.assignments) {
         if (assignment.mechId != mechId) continue;
         
-        // Find the card
-        const Card* card = nullptr;
-        for (const auto& c : game.hand.cards) {
-            if (c.id == assignment.cardId) {
-                card = &c;
-                break;
-            }
-        }
+        const Card* card = game.hand.find(assignment.cardId);
         if (!card) continue;
         
         // Get effect (mirrored or normal)
@@ -233,67 +312,95 @@ MechStats calculateMechStats(int mechId, const Game& game) {
     return stats;
 }
 
-CardEffect mirrorEffect(const CardEffect& effect) {
-    if (effect.type != CardType::Move) {
-        return effect;
-    }
-    CardEffect mirrored = effect;
-    mirrored.move.lateral = -mirrored.move.lateral;
-    if (mirrored.move.lateral == 0 && mirrored.move.forward != 0) {
-        mirrored.move.forward = -mirrored.move.forward;
+CardDelta resolveCard(GameState& state, const Card& card, int playerId, bool useMirror) {
+    return resolveEffect(state, useMirror ? card.mirroredEffect : card.effect, nullptr, playerId, useMirror);
+}
+
+CardDelta resolveCard(GameState& state, CardHandle card, int playerId, bool useMirror) {
+    const Card& c = cardByHandle(card);
+    return resolveEffect(state, useMirror ? c.mirroredEffect : c.effect, &cardMovesByHandle(card), playerId, useMirror);
+}
+
+CardDelta previewMove(const Grid& grid, const Entity& entity, CellDelta step) {
+    CardDelta delta;
+    delta.entityId = entity.id;
+    delta.fromX = static_cast<int16_t>(entity.position.x);
+    delta.fromY = static_cast<int16_t>(entity.position.y);
+    delta.toX = delta.fromX;
+    delta.toY = delta.fromY;
+    int toX = 0;
+    int toY = 0;
+    if (stepTarget(grid, delta.fromX, delta.fromY, step, toX, toY, delta.blocked)) {
+        delta.toX = static_cast<int16_t>(toX);
+        delta.toY = static_cast<int16_t>(toY);
+    }
+    return delta;
+}
+
+Bitboard legalMoveDestinations(const Grid& grid, const Entity& entity, const Hand& hand) {
+    Bitboard out;
+    int fromX = entity.position.x;
+    int fromY = entity.position.y;
+    for (uint64_t bits = hand.available().bits; bits != 0; bits &= bits - 1) {
+        CardHandle handle = hand.handle(static_cast<size_t>(std::countr_zero(bits)));
+        const Card& card = cardByHandle(handle);
+        const CardMoves& moves = cardMovesByHandle(handle);
+        for (int mirror = 0; mirror < 2; ++mirror) {
+            const CardEffect& effect = mirror ? card.mirroredEffect : card.effect;
+            if (effect.type != CardType::Move) continue;
+            int toX = 0;
+            int toY = 0;
+            bool blocked = false;
+            if (stepTarget(grid, fromX, fromY, moves.at(entity.facing, mirror == 1), toX, toY, blocked)) {
+                out.set(Grid::cellIndex(toX, toY));
+            }
+        }
     }
-    return mirrored;
+    return out;
 }
 
-GameState applyCard(const GameState& state, const Card& card, int playerId, bool useMirror) {
-    GameState newState = state;
-    const CardEffect& effect = useMirror ? card.mirroredEffect : card.effect;
-
-    switch (effect.type) {
-    case CardType::Move: {
-        auto it = std::find_if(newState.entities.begin(), newState.entities.end(),
-            [playerId](const Entity& e) { return e.id == playerId; });
-        if (it != newState.entities.end()) {
-            Vector2 target = applyMoveVector(it->position, effect.move, it->facing);
-            int clampedX = static_cast<int>(std::round(target.x));
-            int clampedY = static_cast<int>(std::round(target.y));
-            clampedX = std::clamp(clampedX, 0, Grid::SIZE - 1);
-            clampedY = std::clamp(clampedY, 0, Grid::SIZE - 1);
-            target = {static_cast<float>(clampedX), static_cast<float>(clampedY)};
-
-            if (!positionOccupied(newState.entities, it->id, target)) {
-                it->position = target;
-            }
-        }
-        break;
+void undoCard(GameState& state, const CardDelta& delta) {
+    if (delta.entityId == -1) {
+        return;
     }
-    case CardType::Damage: {
-        auto it = std::find_if(newState.entities.begin(), newState.entities.end(),
-            [effect](const Entity& e) { return e.id == effect.targetEntityId; });
-        if (it != newState.entities.end()) {
-            it->health -= effect.damage;
-            if (it->health < 0) it->health = 0;
-        }
-        break;
+    auto it = std::find_if(state.entities.begin(), state.entities.end(),
+        [&delta](const Entity& e) { return e.id == delta.entityId; });
+    if (it == state.entities.end()) {
+        return;
     }
-    case CardType::Heal: {
-        auto it = std::find_if(newState.entities.begin(), newState.entities.end(),
-            [playerId](const Entity& e) { return e.id == playerId; });
-        if (it != newState.entities.end()) {
-            it->health += effect.heal;
-            if (it->health > 100) it->health = 100;
-        }
-        break;
+    int slot = static_cast<int>(it - state.entities.begin());
+    Entity& e = state.entities.edit(slot);
+
+    if (delta.toX != delta.fromX || delta.toY != delta.fromY) {
+        e.position = {delta.fromX, delta.fromY};
+        state.grid.moveOccupant(delta.toX, delta.toY, delta.fromX, delta.fromY, e.type);
+        state.hash ^= zobristCellKey(slot, delta.toX, delta.toY) ^ zobristCellKey(slot, delta.fromX, delta.fromY);
     }
+    if (delta.healthDelta != 0) {
+        int before = e.health;
+        e.health -= delta.healthDelta;
+        state.hash ^= zobristHealthKey(slot, before) ^ zobristHealthKey(slot, e.health);
     }
+}
 
+GameState applyCard(const GameState& state, const Card& card, int playerId, bool useMirror,
+                    std::pmr::memory_resource* arena) {
+    GameState newState = state;
+    if (arena) newState.entities.setResource(arena);
+    newState.grid.syncOccupancy(newState.entities);
+    newState.hash = zobristHash(newState);
+    resolveCard(newState, card, playerId, useMirror);
     return newState;
 }
 
-GameState applySequence(const GameState& state, const Sequence& sequence, int playerId) {
+GameState applySequence(const GameState& state, const Sequence& sequence, int playerId,
+                        std::pmr::memory_resource* arena) {
     GameState currentState = state;
+    if (arena) currentState.entities.setResource(arena);
+    currentState.grid.syncOccupancy(currentState.entities);
+    currentState.hash = zobristHash(currentState);
     for (const auto& card : sequence) {
-        currentState = applyCard(currentState, card, playerId);
+        resolveCard(currentState, card, playerId);
     }
     return currentState;
 }
@@ -343,17 +450,79 @@ bool TurnPlan::validate(const std::vector<Card>& hand, const std::vector<int>& m
     return true;
 }
 
-GameState TurnPlan::apply(const GameState& state, const std::vector<Card>& hand, const Grid& grid) const {
+GameState TurnPlan::apply(const GameState& state, const std::vector<Card>& hand, const Grid& grid,
+                          std::pmr::memory_resource* arena) const {
     GameState current = state;
+    if (arena) current.entities.setResource(arena);
+    current.grid.syncOccupancy(current.entities);
+    current.hash = zobristHash(current);
+    resolve(current, hand);
+    current.grid = grid;
+    current.grid.syncOccupancy(current.entities);
+    return current;
+}
+
+void TurnPlan::resolve(GameState& state, const std::vector<Card>& hand, std::vector<CardDelta>* deltas) const {
     for (const auto& a : assignments) {
         const Card* c = findCard(hand, a.cardId);
         if (!c) {
             continue;
         }
-        current = applyCard(current, *c, a.mechId, a.useMirror);
+        CardDelta delta = resolveCard(state, *c, a.mechId, a.useMirror);
+        if (deltas) {
+            deltas->push_back(delta);
+        }
+    }
+}
+
+bool TurnPlan::validate(const Hand& hand, const std::vector<int>& mechIds, std::string* error) const {
+    if (assignments.size() > 3) {
+        if (error) *error = "Too many mech assignments (max 3)";
+        return false;
+    }
+    // At most three assignments: pairwise checks instead of hash sets.
+    for (size_t i = 0; i < assignments.size(); ++i) {
+        const auto& a = assignments[i];
+        if (a.mechId < 0) {
+            if (error) *error = "Invalid mech id";
+            return false;
+        }
+        if (!mechIds.empty() && std::find(mechIds.begin(), mechIds.end(), a.mechId) == mechIds.end()) {
+            if (error) *error = "Mech id not present in roster";
+            return false;
+        }
+        int sameCard = 1;
+        for (size_t j = 0; j < i; ++j) {
+            if (assignments[j].mechId == a.mechId) {
+                if (error) *error = "Duplicate mech assignment";
+                return false;
+            }
+            sameCard += assignments[j].cardId == a.cardId;
+        }
+        int total = hand.totalCount(a.cardId);
+        if (a.cardId < 0 || total == 0) {
+            if (error) *error = "Card not available in hand";
+            return false;
+        }
+        if (sameCard > total) {
+            if (error) *error = "Card used more times than available";
+            return false;
+        }
+    }
+    return true;
+}
+
+void TurnPlan::resolve(GameState& state, const Hand& hand, std::vector<CardDelta>* deltas) const {
+    for (const auto& a : assignments) {
+        CardHandle c = hand.findHandle(a.cardId);
+        if (c == kInvalidCardHandle) {
+            continue;
+        }
+        CardDelta delta = resolveCard(state, c, a.mechId, a.useMirror);
+        if (deltas) {
+            deltas->push_back(delta);
+        }
     }
-    current.grid = grid;
-    return current;
 }
 
 TurnPlan buildRandomPlan(const std::vector<int>& mechIds, Hand& hand, uint32_t seed, float mirrorChance) {
@@ -361,12 +530,12 @@ TurnPlan buildRandomPlan(const std::vector<int>& mechIds, Hand& hand, uint32_t s
     std::mt19937 rng(seed);
 
     for (int mechId : mechIds) {
-        auto options = hand.availableCardIds();
-        if (options.empty()) {
+        size_t options = hand.availableSize();
+        if (options == 0) {
             break;
         }
-        std::uniform_int_distribution<size_t> pick(0, options.size() - 1);
-        int chosenCardId = options[pick(rng)];
+        std::uniform_int_distribution<size_t> pick(0, options - 1);
+        int chosenCardId = hand.availableAt(pick(rng)).id;
         bool useMirror = std::bernoulli_distribution(mirrorChance)(rng);
         if (hand.markUsed(chosenCardId)) {
             plan.assignments.push_back({mechId, chosenCardId, useMirror});
@@ -385,166 +554,206 @@ std::string cardTypeToString(CardType t) {
     return "Move";
 }
 
+bool cardTypeFromString(std::string_view s, CardType& out) {
+    if (s == "Move") out = CardType::Move;
+    else if (s == "Damage") out = CardType::Damage;
+    else if (s == "Heal") out = CardType::Heal;
+    else return false;
+    return true;
+}
+
 CardType cardTypeFromString(const std::string& s) {
-    if (s == "Damage") return CardType::Damage;
-    if (s == "Heal") return CardType::Heal;
-    return CardType::Move;
+    CardType type = CardType::Move;
+    cardTypeFromString(std::string_view(s), type);
+    return type;
 }
 
 namespace {
 
-std::string boolString(bool v) { return v ? "true" : "false"; }
-
-bool extractString(const std::string& src, const std::string& key, std::string& out) {
-    std::string pattern = "\"" + key + "\"";
-    size_t pos = src.find(pattern);
-    if (pos == std::string::npos) return false;
-    pos = src.find('"', pos + pattern.size());
-    if (pos == std::string::npos) return false;
-    size_t start = pos + 1;
-    size_t end = src.find('"', start);
-    if (end == std::string::npos) return false;
-    out = src.substr(start, end - start);
-    return true;
-}
-
-bool extractInt(const std::string& src, const std::string& key, int& out) {
-    std::string pattern = "\"" + key + "\"";
-    size_t pos = src.find(pattern);
-    if (pos == std::string::npos) return false;
-    pos = src.find(':', pos);
-    if (pos == std::string::npos) return false;
-    pos++;
-    while (pos < src.size() && src[pos] == ' ') pos++;
-    try {
-        out = std::stoi(src.substr(pos));
-        return true;
-    } catch (...) {
-        return false;
+bool readMove(JsonReader& reader, MoveVector& out) {
+    if (!reader.beginObject()) return false;
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "forward") reader.readInt(out.forward);
+        else if (key == "lateral") reader.readInt(out.lateral);
+        else reader.skipValue();
     }
+    return reader.ok();
 }
 
-bool extractBool(const std::string& src, const std::string& key, bool& out) {
-    std::string pattern = "\"" + key + "\"";
-    size_t pos = src.find(pattern);
-    if (pos == std::string::npos) return false;
-    pos = src.find(':', pos);
-    if (pos == std::string::npos) return false;
-    pos++;
-    while (pos < src.size() && src[pos] == ' ') pos++;
-    if (src.compare(pos, 4, "true") == 0) { out = true; return true; }
-    if (src.compare(pos, 5, "false") == 0) { out = false; return true; }
-    return false;
+bool readAssignment(JsonReader& reader, PlanAssignment& out) {
+    if (!reader.beginObject()) return false;
+    bool hasMech = false, hasCard = false;
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "mechId") hasMech = reader.readInt(out.mechId);
+        else if (key == "cardId") hasCard = reader.readInt(out.cardId);
+        else if (key == "useMirror") reader.readBool(out.useMirror);
+        else reader.skipValue();
+    }
+    return reader.ok() && hasMech && hasCard;
 }
 
 } // namespace
 
-std::string serializeCard(const Card& card) {
-    std::ostringstream oss;
-    oss << "{\"id\":" << card.id
-        << ",\"name\":\"" << card.name << "\""
-        << ",\"type\":\"" << cardTypeToString(card.type) << "\""
-        << ",\"move\":{\"forward\":" << card.effect.move.forward << ",\"lateral\":" << card.effect.move.lateral << "}"
-        << ",\"damage\":" << card.effect.damage
-        << ",\"heal\":" << card.effect.heal
-        << "}";
-    return oss.str();
-}
-
-bool deserializeCard(const std::string& json, Card& out) {
-    int id = 0; std::string name; std::string typeStr;
-    if (!extractInt(json, "id", id)) return false;
-    if (!extractString(json, "name", name)) return false;
-    if (!extractString(json, "type", typeStr)) return false;
-    int fwd = 0, lat = 0, dmg = 0, heal = 0;
-    extractInt(json, "forward", fwd);
-    extractInt(json, "lateral", lat);
-    extractInt(json, "damage", dmg);
-    extractInt(json, "heal", heal);
-
-    out.id = id;
-    out.name = name;
-    out.type = cardTypeFromString(typeStr);
-    out.effect.type = out.type;
-    out.effect.move.forward = fwd;
-    out.effect.move.lateral = lat;
-    out.effect.damage = dmg;
-    out.effect.heal = heal;
+void writeCard(JsonWriter& writer, const Card& card) {
+    writer.beginObject()
+        .key("id").value(card.id)
+        .key("name").value(std::string_view(card.name))
+        .key("type").value(cardTypeToString(card.type))
+        .key("move").beginObject()
+            .key("forward").value(card.effect.move.forward)
+            .key("lateral").value(card.effect.move.lateral)
+        .endObject()
+        .key("damage").value(card.effect.damage)
+        .key("heal").value(card.effect.heal)
+        .key("target").value(card.effect.targetEntityId)
+        .endObject();
+}
+
+bool readCard(JsonReader& reader, Card& out) {
+    if (!reader.beginObject()) return false;
+    bool hasId = false, hasName = false, hasType = false;
+    CardEffect effect;
+    std::string_view key;
+    std::string_view text;
+    while (reader.nextKey(key)) {
+        if (key == "id") {
+            hasId = reader.readInt(out.id);
+        } else if (key == "name") {
+            hasName = reader.readString(text);
+            if (text.find('\\') == std::string_view::npos) out.name.assign(text);
+            else JsonReader::unescape(text, out.name);
+        } else if (key == "type") {
+            hasType = reader.readString(text) && cardTypeFromString(text, out.type);
+        } else if (key == "move") {
+            readMove(reader, effect.move);
+        } else if (key == "damage") {
+            reader.readInt(effect.damage);
+        } else if (key == "heal") {
+            reader.readInt(effect.heal);
+        } else if (key == "target") {
+            reader.readInt(effect.targetEntityId);
+        } else {
+            reader.skipValue();
+        }
+    }
+    if (!reader.ok() || !hasId || !hasName || !hasType) return false;
+    effect.type = out.type;
+    out.effect = effect;
     out.mirroredEffect = mirrorEffect(out.effect);
     return true;
 }
 
-std::string serializeHand(const Hand& hand) {
-    std::ostringstream oss;
-    oss << "{\"cards\":[";
-    for (size_t i = 0; i < hand.cards.size(); ++i) {
-        if (i > 0) oss << ",";
-        oss << serializeCard(hand.cards[i]);
-    }
-    oss << "]}";
-    return oss.str();
+void writeHand(JsonWriter& writer, const Hand& hand) {
+    writer.beginObject().key("cards").beginArray();
+    for (const Card& card : hand.cards()) writeCard(writer, card);
+    writer.endArray().endObject();
 }
 
-bool deserializeHand(const std::string& json, Hand& out) {
+bool readHand(JsonReader& reader, Hand& out) {
     out.clear();
-    size_t start = json.find('[');
-    size_t end = json.rfind(']');
-    if (start == std::string::npos || end == std::string::npos || end <= start) return false;
-    size_t pos = start + 1;
-    while (pos < end) {
-        size_t objStart = json.find('{', pos);
-        if (objStart == std::string::npos || objStart >= end) break;
-        size_t objEnd = json.find('}', objStart);
-        if (objEnd == std::string::npos || objEnd > end) return false;
-        Card c;
-        if (!deserializeCard(json.substr(objStart, objEnd - objStart + 1), c)) return false;
-        out.addCard(c);
-        pos = objEnd + 1;
-        size_t comma = json.find(',', pos);
-        if (comma != std::string::npos && comma < end) pos = comma + 1;
+    if (!reader.beginObject()) return false;
+    bool hasCards = false;
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key != "cards") {
+            reader.skipValue();
+            continue;
+        }
+        hasCards = reader.beginArray();
+        Card card;
+        while (reader.nextElement()) {
+            if (!readCard(reader, card)) return false;
+            // Hands may only name registered cards; decoding never grows the registry.
+            CardHandle handle = findCardHandle(card);
+            if (handle == kInvalidCardHandle) return false;
+            out.addCard(handle);
+        }
     }
     out.resetUsage();
-    return true;
+    return reader.ok() && hasCards;
 }
 
-std::string serializeTurnPlan(const TurnPlan& plan) {
-    std::ostringstream oss;
-    oss << "{\"assignments\":[";
-    for (size_t i = 0; i < plan.assignments.size(); ++i) {
-        const auto& a = plan.assignments[i];
-        if (i > 0) oss << ",";
-        oss << "{\"mechId\":" << a.mechId
-            << ",\"cardId\":" << a.cardId
-            << ",\"useMirror\":" << boolString(a.useMirror) << "}";
+void writeTurnPlan(JsonWriter& writer, const TurnPlan& plan) {
+    writer.beginObject().key("assignments").beginArray();
+    for (const auto& a : plan.assignments) {
+        writer.beginObject()
+            .key("mechId").value(a.mechId)
+            .key("cardId").value(a.cardId)
+            .key("useMirror").value(a.useMirror)
+            .endObject();
     }
-    oss << "]}";
-    return oss.str();
+    writer.endArray().endObject();
 }
 
-bool deserializeTurnPlan(const std::string& json, TurnPlan& out) {
+bool readTurnPlan(JsonReader& reader, TurnPlan& out) {
     out.assignments.clear();
-    size_t start = json.find('[');
-    size_t end = json.rfind(']');
-    if (start == std::string::npos || end == std::string::npos || end <= start) return false;
-    size_t pos = start + 1;
-    while (pos < end) {
-        size_t objStart = json.find('{', pos);
-        if (objStart == std::string::npos || objStart >= end) break;
-        size_t objEnd = json.find('}', objStart);
-        if (objEnd == std::string::npos || objEnd > end) return false;
-        std::string slice = json.substr(objStart, objEnd - objStart + 1);
-        PlanAssignment a;
-        int mech = -1, cardId = -1; bool mirror = false;
-        if (!extractInt(slice, "mechId", mech)) return false;
-        if (!extractInt(slice, "cardId", cardId)) return false;
-        extractBool(slice, "useMirror", mirror);
-        a.mechId = mech;
-        a.cardId = cardId;
-        a.useMirror = mirror;
-        out.assignments.push_back(a);
-        pos = objEnd + 1;
-        size_t comma = json.find(',', pos);
-        if (comma != std::string::npos && comma < end) pos = comma + 1;
+    if (!reader.beginObject()) return false;
+    bool hasAssignments = false;
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key != "assignments") {
+            reader.skipValue();
+            continue;
+        }
+        hasAssignments = reader.beginArray();
+        while (reader.nextElement()) {
+            PlanAssignment a;
+            if (!readAssignment(reader, a)) return false;
+            out.assignments.push_back(a);
+        }
     }
-    return true;
-}
\ No newline at end of file
+    return reader.ok() && hasAssignments;
+}
+
+void serializeCard(const Card& card, std::string& out) {
+    out.clear();
+    JsonWriter writer(out);
+    writeCard(writer, card);
+}
+
+std::string serializeCard(const Card& card) {
+    std::string out;
+    serializeCard(card, out);
+    return out;
+}
+
+bool deserializeCard(std::string_view json, Card& out) {
+    JsonReader reader(json);
+    return readCard(reader, out);
+}
+
+void serializeHand(const Hand& hand, std::string& out) {
+    out.clear();
+    JsonWriter writer(out);
+    writeHand(writer, hand);
+}
+
+std::string serializeHand(const Hand& hand) {
+    std::string out;
+    serializeHand(hand, out);
+    return out;
+}
+
+bool deserializeHand(std::string_view json, Hand& out) {
+    JsonReader reader(json);
+    return readHand(reader, out);
+}
+
+void serializeTurnPlan(const TurnPlan& plan, std::string& out) {
+    out.clear();
+    JsonWriter writer(out);
+    writeTurnPlan(writer, plan);
+}
+
+std::string serializeTurnPlan(const TurnPlan& plan) {
+    std::string out;
+    serializeTurnPlan(plan, out);
+    return out;
+}
+
+bool deserializeTurnPlan(std::string_view json, TurnPlan& out) {
+    JsonReader reader(json);
+    return readTurnPlan(reader, out);
+}
@@ -1,13 +1,21 @@
 #pragma once
 
+#include <array>
+#include <bit>
+#include <memory_resource>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <functional>
-#include <unordered_map>
 #include <cstdint>
 #include "entity.h"
+#include "entityList.h"
 #include "grid.h"
 
+class JsonReader;
+class JsonWriter;
+
 enum class CardType {
     Move,
     Damage,
@@ -17,6 +25,8 @@ enum class CardType {
 struct MoveVector {
     int forward = 0; // +Y forward, -Y backward
     int lateral = 0; // +X right, -X left
+
+    bool operator==(const MoveVector&) const = default;
 };
 
 struct CardEffect {
@@ -25,6 +35,8 @@ struct CardEffect {
     int targetEntityId = -1; // Used for damage/heal
     int damage = 0;
     int heal = 0;
+
+    bool operator==(const CardEffect&) const = default;
 };
 
 struct Card {
@@ -33,34 +45,131 @@ struct Card {
     CardType type = CardType::Move;
     CardEffect effect{};
     CardEffect mirroredEffect{}; // precomputed for faster use
+
+    bool operator==(const Card&) const = default;
 };
 
+/**
+ * Index of an interned card in the card registry (cardRegistry.h). Handles are
+ * stable for the life of the process and the card behind one never changes.
+ */
+using CardHandle = uint16_t;
+constexpr CardHandle kInvalidCardHandle = 0xFFFF;
+
+// Registry lookup; handle must come from the registry.
+const Card& cardByHandle(CardHandle handle);
+// Add card to the registry, or return the handle of an identical card already there.
+CardHandle internCard(const Card& card);
+// Handle of an identical card already in the registry, or kInvalidCardHandle. Decoders use this.
+CardHandle findCardHandle(const Card& card);
+
+/**
+ * Cards in hand plus per-turn usage. The hand stores registry handles, so it
+ * is a fixed-size value with no heap storage. Counters live in fixed arrays
+ * indexed by a dense slot per distinct card id (ids below kDirectIds map to
+ * their slot directly), and the set of playable cards is a bitmask over hand
+ * positions that markUsed/unmarkUsed update incrementally, so queries never
+ * allocate.
+ *
+ * A card at hand position i is available while fewer copies of its id are
+ * used than its rank among same-id cards, which keeps available() in hand
+ * order with the first copies of each id listed first.
+ */
 struct Hand {
-    std::vector<Card> cards;
-    std::unordered_map<int, int> usage;
+    static constexpr int kMaxCards = 64;
+    static constexpr int kDirectIds = 256;
+
+    // Iterates hand positions (or set bits of a position mask) as cards.
+    class CardIterator {
+    public:
+        CardIterator(const CardHandle* handles, uint64_t bits) : handles_(handles), bits_(bits) {}
+        const Card& operator*() const { return cardByHandle(handles_[std::countr_zero(bits_)]); }
+        const Card* operator->() const { return &**this; }
+        CardIterator& operator++() {
+            bits_ &= bits_ - 1;
+            return *this;
+        }
+        bool operator==(const CardIterator& other) const { return bits_ == other.bits_; }
+        bool operator!=(const CardIterator& other) const { return bits_ != other.bits_; }
+
+    private:
+        const CardHandle* handles_;
+        uint64_t bits_;
+    };
+
+    struct CardRange {
+        const CardHandle* handles;
+        uint64_t bits;
+        CardIterator begin() const { return {handles, bits}; }
+        CardIterator end() const { return {handles, 0}; }
+        size_t size() const { return static_cast<size_t>(std::popcount(bits)); }
+        bool empty() const { return bits == 0; }
+        // Only for full ranges (cards()), where bit i is hand position i.
+        const Card& operator[](size_t i) const { return cardByHandle(handles[i]); }
+        const Card& front() const { return *begin(); }
+        const Card& back() const { return cardByHandle(handles[63 - std::countl_zero(bits)]); }
+    };
 
     void clear();
+    // Ignored (with a warning) once the hand holds kMaxCards cards.
     void addCard(const Card& card);
+    void addCard(CardHandle handle);
     void resetUsage();
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    CardHandle handle(size_t position) const { return handles_[position]; }
+    // Every card in hand order.
+    CardRange cards() const { return {handles_.data(), count_ == 64 ? ~uint64_t{0} : (uint64_t{1} << count_) - 1}; }
+    // Owning copy of the cards, for code that works on plain card lists (AI, replays).
+    void copyCards(std::vector<Card>& out) const;
+    std::vector<Card> cardList() const;
+    // First card in hand with this id, or null / kInvalidCardHandle.
+    const Card* find(int cardId) const;
+    CardHandle findHandle(int cardId) const;
+
     int totalCount(int cardId) const;
     int usedCount(int cardId) const;
     int availableCount(int cardId) const;
     bool canPlay(int cardId) const;
     bool markUsed(int cardId);
     bool unmarkUsed(int cardId);
-    std::vector<Card> availableCards() const;
-    std::vector<int> availableCardIds() const;
+
+    // Playable cards, one entry per unused copy, in hand order.
+    CardRange available() const { return {handles_.data(), available_}; }
+    size_t availableSize() const { return static_cast<size_t>(std::popcount(available_)); }
+    // The index-th entry of available(); index must be < availableSize().
+    const Card& availableAt(size_t index) const;
+    // Writes available() ids into out (up to out.size()); returns the number written.
+    size_t availableCardIds(std::span<int> out) const;
+
+private:
+    int slotOf(int cardId) const;
+    int cardAtRank(int slot, int rank) const;
+
+    std::array<CardHandle, kMaxCards> handles_{};
+    std::array<uint8_t, kDirectIds> directSlot_{}; // slot + 1 for ids in [0, kDirectIds)
+    std::array<int, kMaxCards> slotIds_{};
+    std::array<CardHandle, kMaxCards> slotFirst_{}; // first card with the slot's id
+    std::array<uint8_t, kMaxCards> total_{};
+    std::array<uint8_t, kMaxCards> used_{};
+    std::array<uint8_t, kMaxCards> cardSlot_{}; // per hand position
+    std::array<uint8_t, kMaxCards> cardRank_{}; // copies of the same id before this one
+    uint64_t available_ = 0;                     // bit i: position i is playable
+    uint8_t count_ = 0;
+    uint8_t slots_ = 0;
 };
 
 /**
  * T_051: Deck struct for managing card drawing
  */
 struct Deck {
-    std::vector<Card> cards;
+    std::vector<CardHandle> cards;
 
     void clear();
     void addCard(const Card& card);
-    Card draw();
+    // kInvalidCardHandle when the deck is empty.
+    CardHandle draw();
     int remaining() const;
     void shuffle(uint32_t seed);
 };
@@ -69,36 +178,166 @@ struct PlanAssignment {
     int mechId = -1;
     int cardId = -1;
     bool useMirror = false;
+
+    bool operator==(const PlanAssignment&) const = default;
 };
 
 using Sequence = std::vector<Card>;
 
+/**
+ * Simulation state. Entities and grid cells are structurally shared, so
+ * copying a GameState is an O(1) fork; a branch pays only for the entity
+ * chunks it writes (see EntityList).
+ */
 struct GameState {
     Grid grid;
-    std::vector<Entity> entities;
+    EntityList entities;
     int currentTurn = 0;
+    uint64_t hash = 0; // Zobrist hash (zobrist.h), kept current by card resolution
 };
 
-CardEffect mirrorEffect(const CardEffect& effect);
+/**
+ * Compact record of what resolving one card changed. entityId is -1 when the
+ * card had no target in the state. Positions are integer grid cells.
+ */
+struct CardDelta {
+    int entityId = -1;
+    CardType type = CardType::Move;
+    int16_t fromX = 0;
+    int16_t fromY = 0;
+    int16_t toX = 0;
+    int16_t toY = 0;
+    int16_t healthDelta = 0;
+    bool blocked = false; // Move was rejected by an occupied destination
+};
+
+constexpr int kMaxHealth = 100;
+
+// Health after a change: floors at 0, and a heal caps at kMaxHealth, pulling
+// an entity above the cap back down to it. Every resolver applies this rule.
+constexpr int applyHealthChange(int health, int change) {
+    int after = health + change;
+    if (after < 0) after = 0;
+    if (change > 0 && after > kMaxHealth) after = kMaxHealth;
+    return after;
+}
+
+// Move cards mirror left/right; pure forward/back moves flip direction instead.
+constexpr CardEffect mirrorEffect(const CardEffect& effect) {
+    if (effect.type != CardType::Move) {
+        return effect;
+    }
+    CardEffect mirrored = effect;
+    mirrored.move.lateral = -mirrored.move.lateral;
+    if (mirrored.move.lateral == 0 && mirrored.move.forward != 0) {
+        mirrored.move.forward = -mirrored.move.forward;
+    }
+    return mirrored;
+}
+
+// Board-space step of a move for a mover with the given facing (facing North,
+// forward is +y and lateral is +x). Rows hold the (lateral, forward)
+// coefficients of dx and dy per facing.
+constexpr CellDelta moveDelta(const MoveVector& move, Facing facing) {
+    constexpr int basis[4][4] = {{1, 0, 0, 1}, {0, 1, -1, 0}, {-1, 0, 0, -1}, {0, -1, 1, 0}};
+    const int* b = basis[static_cast<int>(facing) & 3];
+    auto narrow = [](int v) { return static_cast<int8_t>(v < -127 ? -127 : (v > 127 ? 127 : v)); };
+    return {narrow(b[0] * move.lateral + b[1] * move.forward), narrow(b[2] * move.lateral + b[3] * move.forward)};
+}
+
+/**
+ * A card's board steps for every (facing, mirror) pair, so resolving a move is
+ * a table lookup. Non-move cards have all-zero steps.
+ */
+struct CardMoves {
+    std::array<CellDelta, 8> steps{}; // [facing * 2 + mirror]
+
+    constexpr CellDelta at(Facing facing, bool mirror) const { return steps[(static_cast<int>(facing) & 3) * 2 + (mirror ? 1 : 0)]; }
+};
+
+constexpr CardMoves cardMoves(const CardEffect& effect, const CardEffect& mirrored) {
+    CardMoves moves;
+    for (int f = 0; f < 4; ++f) {
+        if (effect.type == CardType::Move) moves.steps[f * 2] = moveDelta(effect.move, static_cast<Facing>(f));
+        if (mirrored.type == CardType::Move) moves.steps[f * 2 + 1] = moveDelta(mirrored.move, static_cast<Facing>(f));
+    }
+    return moves;
+}
+
+// Precomputed steps of a registered card (filled in when the card is interned).
+const CardMoves& cardMovesByHandle(CardHandle handle);
+
 std::string cardTypeToString(CardType t);
+// Unknown names fall back to Move; the string_view overload reports them instead.
 CardType cardTypeFromString(const std::string& s);
+bool cardTypeFromString(std::string_view s, CardType& out);
 
 struct TurnPlan {
     std::vector<PlanAssignment> assignments;
     bool validate(const std::vector<Card>& hand, std::string* error = nullptr) const;
     bool validate(const std::vector<Card>& hand, const std::vector<int>& mechIds, std::string* error = nullptr) const;
-    GameState apply(const GameState& state, const std::vector<Card>& hand, const Grid& grid) const;
+    // Copying resolve; arena is as for applyCard.
+    GameState apply(const GameState& state, const std::vector<Card>& hand, const Grid& grid,
+                    std::pmr::memory_resource* arena = nullptr) const;
+    // Resolve all assignments in place (same occupancy contract as resolveCard). When
+    // deltas is given, one record per resolved card is appended; callers reuse the
+    // vector so steady-state turns do not allocate.
+    void resolve(GameState& state, const std::vector<Card>& hand, std::vector<CardDelta>* deltas = nullptr) const;
+    // Same rules against a Hand: card counts and lookups come from its tables.
+    bool validate(const Hand& hand, const std::vector<int>& mechIds, std::string* error = nullptr) const;
+    void resolve(GameState& state, const Hand& hand, std::vector<CardDelta>* deltas = nullptr) const;
 };
 
 TurnPlan buildRandomPlan(const std::vector<int>& mechIds, Hand& hand, uint32_t seed, float mirrorChance = 0.5f);
 
-// Lightweight JSON-ish helpers (for tests/tools; no persistence layer yet).
+// JSON codec for cards, hands and plans (single-pass reader, streaming writer; see
+// utils/jsonCodec.h). The buffer overloads clear and refill out, reusing its
+// capacity, so per-turn logging does not allocate once warmed up. Readers accept
+// keys in any order, skip unknown keys and return false on malformed input. Hand
+// readers also reject cards that are not already in the registry.
+void writeCard(JsonWriter& writer, const Card& card);
+bool readCard(JsonReader& reader, Card& out);
+void writeHand(JsonWriter& writer, const Hand& hand);
+bool readHand(JsonReader& reader, Hand& out);
+void writeTurnPlan(JsonWriter& writer, const TurnPlan& plan);
+bool readTurnPlan(JsonReader& reader, TurnPlan& out);
+
 std::string serializeCard(const Card& card);
-bool deserializeCard(const std::string& json, Card& out);
+void serializeCard(const Card& card, std::string& out);
+bool deserializeCard(std::string_view json, Card& out);
 std::string serializeHand(const Hand& hand);
-bool deserializeHand(const std::string& json, Hand& out);
+void serializeHand(const Hand& hand, std::string& out);
+bool deserializeHand(std::string_view json, Hand& out);
 std::string serializeTurnPlan(const TurnPlan& plan);
-bool deserializeTurnPlan(const std::string& json, TurnPlan& out);
+void serializeTurnPlan(const TurnPlan& plan, std::string& out);
+bool deserializeTurnPlan(std::string_view json, TurnPlan& out);
+
+// Mutating resolution: applies the card to state directly and reports the change.
+// Collision checks read state.grid occupancy, which must be in sync with
+// state.entities (see Grid::syncOccupancy); resolution keeps it in sync after.
+// state.hash is updated incrementally, so it is only meaningful if it was seeded
+// with zobristHash(state).
+CardDelta resolveCard(GameState& state, const Card& card, int playerId, bool useMirror = false);
+// Same, for a registered card: the move step comes from its CardMoves table.
+CardDelta resolveCard(GameState& state, CardHandle card, int playerId, bool useMirror = false);
+
+// What a move of step would do to entity on grid, without changing anything
+// (fromX/fromY, toX/toY and blocked filled as resolveCard would).
+CardDelta previewMove(const Grid& grid, const Entity& entity, CellDelta step);
+// Cells entity can reach with one available move card from hand, either side.
+// Blocked and clamped-in-place moves are left out.
+Bitboard legalMoveDestinations(const Grid& grid, const Entity& entity, const Hand& hand);
+
+// Revert a delta returned by resolveCard on the same state (most recent first when
+// undoing several). Restores position, health, occupancy and hash; lets search
+// walk a tree in place instead of copying states.
+void undoCard(GameState& state, const CardDelta& delta);
 
-GameState applyCard(const GameState& state, const Card& card, int playerId, bool useMirror = false);
-GameState applySequence(const GameState& state, const Sequence& sequence, int playerId);
\ No newline at end of file
+// Copy-returning wrappers over resolveCard (state is copied once per call).
+// When arena is given, the entity chunks the result writes are allocated from
+// it (see common/arena.h), and the result must be dropped before the arena is
+// reset. Otherwise the result allocates where state does.
+GameState applyCard(const GameState& state, const Card& card, int playerId, bool useMirror = false,
+                    std::pmr::memory_resource* arena = nullptr);
+GameState applySequence(const GameState& state, const Sequence& sequence, int playerId,
+                        std::pmr::memory_resource* arena = nullptr);
\ No newline at end of file
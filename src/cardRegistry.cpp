@@ -0,0 +1,141 @@
+#include "cardRegistry.h"
+#include "raylib.h" // TraceLog
+#include "utils/jsonCodec.h"
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+uint64_t mixId(int cardId) {
+    uint64_t x = static_cast<uint32_t>(cardId) + 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+} // namespace
+
+CardRegistry::CardRegistry() {
+    for (auto& slot : byId_) slot.store(kInvalidCardHandle, std::memory_order_relaxed);
+    for (const CardDef& def : kBuiltinCards) {
+        Card card;
+        card.id = def.id;
+        card.name = std::string(def.name);
+        card.type = def.type;
+        card.effect = def.effect;
+        card.mirroredEffect = def.mirroredEffect;
+        intern(card);
+    }
+}
+
+size_t CardRegistry::indexSlot(int cardId) const {
+    size_t slot = mixId(cardId) & (kIndexSize - 1);
+    for (;;) {
+        CardHandle handle = byId_[slot].load(std::memory_order_acquire);
+        if (handle == kInvalidCardHandle || get(handle).id == cardId) return slot;
+        slot = (slot + 1) & (kIndexSize - 1);
+    }
+}
+
+CardHandle CardRegistry::intern(const Card& card) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t slot = indexSlot(card.id);
+    CardHandle last = kInvalidCardHandle;
+    for (CardHandle h = byId_[slot].load(std::memory_order_relaxed); h != kInvalidCardHandle;
+         h = entry(h).nextSameId.load(std::memory_order_relaxed)) {
+        if (get(h) == card) return h;
+        last = h;
+    }
+    size_t count = count_.load(std::memory_order_relaxed);
+    if (count >= static_cast<size_t>(kMaxCards)) {
+        TraceLog(LOG_WARNING, "Card registry is full; dropping card %d (%s)", card.id, card.name.c_str());
+        return kInvalidCardHandle;
+    }
+    auto& chunk = chunks_[count / kChunkSize];
+    if (!chunk) {
+        chunk = std::make_unique<Entry[]>(kChunkSize);
+    }
+    Entry& added = chunk[count % kChunkSize];
+    added.card = card;
+    added.moves = cardMoves(card.effect, card.mirroredEffect);
+    count_.store(count + 1, std::memory_order_release);
+
+    // Publish only after the entry is complete; readers acquire through the index or the chain.
+    CardHandle handle = static_cast<CardHandle>(count);
+    if (last == kInvalidCardHandle) byId_[slot].store(handle, std::memory_order_release);
+    else entry(last).nextSameId.store(handle, std::memory_order_release);
+    return handle;
+}
+
+CardHandle CardRegistry::find(int cardId) const {
+    return byId_[indexSlot(cardId)].load(std::memory_order_acquire);
+}
+
+CardHandle CardRegistry::lookup(const Card& card) const {
+    for (CardHandle h = find(card.id); h != kInvalidCardHandle; h = entry(h).nextSameId.load(std::memory_order_acquire)) {
+        if (get(h) == card) return h;
+    }
+    return kInvalidCardHandle;
+}
+
+int CardRegistry::loadDefinitions(std::string_view json, std::string* error) {
+    JsonReader reader(json);
+    if (!reader.beginObject()) {
+        if (error) *error = "Card definitions must be a JSON object";
+        return -1;
+    }
+    int loaded = 0;
+    std::string_view key;
+    Card card;
+    while (reader.nextKey(key)) {
+        if (key != "cards") {
+            reader.skipValue();
+            continue;
+        }
+        if (!reader.beginArray()) break;
+        while (reader.nextElement()) {
+            if (!readCard(reader, card)) {
+                if (error) *error = "Malformed card definition";
+                return -1;
+            }
+            if (intern(card) != kInvalidCardHandle) loaded++;
+        }
+    }
+    if (!reader.ok()) {
+        if (error) *error = std::string(reader.error());
+        return -1;
+    }
+    return loaded;
+}
+
+int CardRegistry::loadFile(const std::string& path, std::string* error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        if (error) *error = "Cannot open " + path;
+        return -1;
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    return loadDefinitions(contents.str(), error);
+}
+
+CardRegistry& cardRegistry() {
+    static CardRegistry registry;
+    return registry;
+}
+
+const Card& cardByHandle(CardHandle handle) {
+    return cardRegistry().get(handle);
+}
+
+const CardMoves& cardMovesByHandle(CardHandle handle) {
+    return cardRegistry().moves(handle);
+}
+
+CardHandle internCard(const Card& card) {
+    return cardRegistry().intern(card);
+}
+
+CardHandle findCardHandle(const Card& card) {
+    return cardRegistry().lookup(card);
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include "card.h"
+
+/**
+ * Built-in card definition. Kept as plain literals so the whole table,
+ * including each card's mirrored effect, is evaluated at compile time.
+ */
+struct CardDef {
+    int id = 0;
+    std::string_view name;
+    CardType type = CardType::Move;
+    CardEffect effect{};
+    CardEffect mirroredEffect{};
+    CardMoves moves{};
+};
+
+constexpr CardDef makeMoveCardDef(int id, std::string_view name, MoveVector move) {
+    CardEffect effect{CardType::Move, move};
+    CardEffect mirrored = mirrorEffect(effect);
+    return {id, name, CardType::Move, effect, mirrored, cardMoves(effect, mirrored)};
+}
+
+// Starter hand; registered first, so kBuiltinCards[i] has handle i.
+inline constexpr std::array<CardDef, 6> kBuiltinCards = {{
+    makeMoveCardDef(1, "Advance", {1, 0}),
+    makeMoveCardDef(2, "StrafeLeft", {0, -1}),
+    makeMoveCardDef(3, "StrafeRight", {0, 1}),
+    makeMoveCardDef(4, "Lunge", {2, 0}),
+    makeMoveCardDef(5, "Retreat", {-1, 0}),
+    makeMoveCardDef(6, "HookLeft", {1, -1}),
+}};
+
+static_assert(kBuiltinCards[0].mirroredEffect.move.forward == -1, "straight moves mirror to their opposite");
+static_assert(kBuiltinCards[5].mirroredEffect.move.lateral == 1, "hooks mirror sideways");
+static_assert(kBuiltinCards[3].moves.at(Facing::East, false) == CellDelta{2, 0}, "lunge east steps +x");
+
+constexpr CardHandle builtinCardHandle(size_t index) { return static_cast<CardHandle>(index); }
+
+/**
+ * Process-wide, append-only card database. Each distinct card is stored once
+ * and named by a 16-bit handle; the card behind a handle never changes, so
+ * reads need no locking. Storage is a fixed table of chunks that never move.
+ * Interning is serialised by a mutex and dedupes identical cards, so adding
+ * the same card twice yields the same handle. Each entry also carries the
+ * card's CardMoves table.
+ *
+ * Cards with the same id but different contents get separate handles, chained
+ * from a fixed hash index on id, so find and lookup never scan the table.
+ * Decoders use lookup rather than intern: untrusted payloads can only name
+ * cards that were registered, not grow the registry.
+ */
+class CardRegistry {
+public:
+    static constexpr int kChunkSize = 256;
+    static constexpr int kMaxChunks = 64;
+    static constexpr int kMaxCards = kChunkSize * kMaxChunks - 1; // 0xFFFF is kInvalidCardHandle
+
+    CardRegistry(); // registers kBuiltinCards
+
+    // kInvalidCardHandle (with a warning) once the registry is full.
+    CardHandle intern(const Card& card);
+    const Card& get(CardHandle handle) const { return entry(handle).card; }
+    const CardMoves& moves(CardHandle handle) const { return entry(handle).moves; }
+    // First card registered with this id, or kInvalidCardHandle.
+    CardHandle find(int cardId) const;
+    // Handle of an identical registered card, or kInvalidCardHandle; never adds.
+    CardHandle lookup(const Card& card) const;
+    size_t size() const { return count_.load(std::memory_order_acquire); }
+
+    /**
+     * Registers cards from JSON in the hand format ({"cards":[...]}) and
+     * returns how many were read, or -1 with error set on malformed input.
+     */
+    int loadDefinitions(std::string_view json, std::string* error = nullptr);
+    int loadFile(const std::string& path, std::string* error = nullptr);
+
+private:
+    // Open-addressed on id; power of two at least twice kMaxCards.
+    static constexpr int kIndexSize = 1 << 15;
+
+    struct Entry {
+        Card card;
+        CardMoves moves;
+        std::atomic<CardHandle> nextSameId{kInvalidCardHandle};
+    };
+
+    const Entry& entry(CardHandle handle) const { return chunks_[handle / kChunkSize][handle % kChunkSize]; }
+    Entry& entry(CardHandle handle) { return chunks_[handle / kChunkSize][handle % kChunkSize]; }
+    // Index slot holding the first handle with this id, or the empty slot where it would go.
+    size_t indexSlot(int cardId) const;
+
+    std::array<std::unique_ptr<Entry[]>, kMaxChunks> chunks_;
+    std::array<std::atomic<CardHandle>, kIndexSize> byId_;
+    std::atomic<size_t> count_{0};
+    mutable std::mutex mutex_;
+};
+
+CardRegistry& cardRegistry();
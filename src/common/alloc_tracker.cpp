@@ -0,0 +1,200 @@
+#include "alloc_tracker.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace {
+
+std::atomic<bool> gEnabled{false};
+std::atomic<uint64_t> gAllocations{0};
+std::atomic<uint64_t> gBytes{0};
+std::atomic<uint64_t> gFrees{0};
+
+// Trivially constructed, so touching them from operator new never allocates.
+thread_local AllocCounts tlCounts;
+thread_local int tlScopes = 0;
+
+// Frame bookkeeping; guarded by gFrameMutex (locking it does not allocate).
+std::mutex gFrameMutex;
+AllocCounts gFrameStart;
+AllocFrameStats gCurrent;
+AllocFrameStats gLast;
+
+AllocCounts globalCounts() {
+    AllocCounts c;
+    c.allocations = gAllocations.load(std::memory_order_relaxed);
+    c.bytes = gBytes.load(std::memory_order_relaxed);
+    c.frees = gFrees.load(std::memory_order_relaxed);
+    return c;
+}
+
+AllocCounts operator-(const AllocCounts& a, const AllocCounts& b) {
+    return {a.allocations - b.allocations, a.bytes - b.bytes, a.frees - b.frees};
+}
+
+void recordAlloc(std::size_t size) {
+    bool global = gEnabled.load(std::memory_order_relaxed);
+    if (!global && tlScopes == 0) return;
+    tlCounts.allocations++;
+    tlCounts.bytes += size;
+    if (global) {
+        gAllocations.fetch_add(1, std::memory_order_relaxed);
+        gBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+}
+
+void recordFree(void* p) {
+    if (!p) return;
+    bool global = gEnabled.load(std::memory_order_relaxed);
+    if (!global && tlScopes == 0) return;
+    tlCounts.frees++;
+    if (global) gFrees.fetch_add(1, std::memory_order_relaxed);
+}
+
+void* rawAlloc(std::size_t size, std::size_t alignment) {
+    if (size == 0) size = 1;
+    if (alignment <= alignof(std::max_align_t)) return std::malloc(size);
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    // aligned_alloc wants a multiple of the alignment.
+    return std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+#endif
+}
+
+void rawFree(void* p, std::size_t alignment) {
+#ifdef _WIN32
+    if (alignment > alignof(std::max_align_t)) {
+        _aligned_free(p);
+        return;
+    }
+#else
+    (void)alignment;
+#endif
+    std::free(p);
+}
+
+void* allocate(std::size_t size, std::size_t alignment) {
+    for (;;) {
+        if (void* p = rawAlloc(size, alignment)) {
+            recordAlloc(size);
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void* allocateNoThrow(std::size_t size, std::size_t alignment) noexcept {
+    try {
+        return allocate(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void release(void* p, std::size_t alignment) noexcept {
+    recordFree(p);
+    rawFree(p, alignment);
+}
+
+constexpr std::size_t kDefaultAlign = alignof(std::max_align_t);
+
+} // namespace
+
+void allocTrackingSetEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(gFrameMutex);
+    if (enabled == gEnabled.load(std::memory_order_relaxed)) return;
+    gEnabled.store(enabled, std::memory_order_relaxed);
+    gFrameStart = globalCounts();
+    gCurrent = AllocFrameStats{};
+    gLast = AllocFrameStats{};
+}
+
+bool allocTrackingEnabled() {
+    return gEnabled.load(std::memory_order_relaxed);
+}
+
+AllocCounts allocTotals() {
+    return globalCounts();
+}
+
+void allocFrameBegin() {
+    if (!allocTrackingEnabled()) return;
+    std::lock_guard<std::mutex> lock(gFrameMutex);
+    AllocCounts now = globalCounts();
+    AllocFrameStats done = gCurrent;
+    done.frame = gLast.frame + 1;
+    done.total = now - gFrameStart;
+    done.peak = done.total.allocations >= gLast.peak.allocations ? done.total : gLast.peak;
+    gLast = done;
+    gCurrent = AllocFrameStats{};
+    gFrameStart = now;
+}
+
+const AllocFrameStats& allocLastFrame() {
+    return gLast;
+}
+
+AllocScope::AllocScope(const char* name) : name_(name) {
+    tlScopes++;
+    start_ = tlCounts;
+}
+
+AllocScope::~AllocScope() {
+    AllocCounts c = counts();
+    tlScopes--;
+    if (!name_ || !allocTrackingEnabled()) return;
+    std::lock_guard<std::mutex> lock(gFrameMutex);
+    for (int i = 0; i < gCurrent.scopeCount; ++i) {
+        AllocScopeCounts& s = gCurrent.scopes[i];
+        if (s.name == name_ || std::strcmp(s.name, name_) == 0) {
+            s.counts.allocations += c.allocations;
+            s.counts.bytes += c.bytes;
+            s.counts.frees += c.frees;
+            return;
+        }
+    }
+    if (gCurrent.scopeCount < AllocFrameStats::kMaxScopes) {
+        gCurrent.scopes[gCurrent.scopeCount++] = {name_, c};
+    }
+}
+
+AllocCounts AllocScope::counts() const {
+    return tlCounts - start_;
+}
+
+// Global replacements. Every form funnels into allocate()/release() above.
+void* operator new(std::size_t size) { return allocate(size, kDefaultAlign); }
+void* operator new[](std::size_t size) { return allocate(size, kDefaultAlign); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocateNoThrow(size, kDefaultAlign); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocateNoThrow(size, kDefaultAlign); }
+void* operator new(std::size_t size, std::align_val_t al) { return allocate(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al) { return allocate(size, static_cast<std::size_t>(al)); }
+void* operator new(std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept {
+    return allocateNoThrow(size, static_cast<std::size_t>(al));
+}
+void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept {
+    return allocateNoThrow(size, static_cast<std::size_t>(al));
+}
+
+void operator delete(void* p) noexcept { release(p, kDefaultAlign); }
+void operator delete[](void* p) noexcept { release(p, kDefaultAlign); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { release(p, kDefaultAlign); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { release(p, kDefaultAlign); }
+void operator delete(void* p, std::size_t) noexcept { release(p, kDefaultAlign); }
+void operator delete[](void* p, std::size_t) noexcept { release(p, kDefaultAlign); }
+void operator delete(void* p, std::align_val_t al) noexcept { release(p, static_cast<std::size_t>(al)); }
+void operator delete[](void* p, std::align_val_t al) noexcept { release(p, static_cast<std::size_t>(al)); }
+void operator delete(void* p, std::size_t, std::align_val_t al) noexcept { release(p, static_cast<std::size_t>(al)); }
+void operator delete[](void* p, std::size_t, std::align_val_t al) noexcept { release(p, static_cast<std::size_t>(al)); }
+void operator delete(void* p, std::align_val_t al, const std::nothrow_t&) noexcept {
+    release(p, static_cast<std::size_t>(al));
+}
+void operator delete[](void* p, std::align_val_t al, const std::nothrow_t&) noexcept {
+    release(p, static_cast<std::size_t>(al));
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Opt-in heap allocation tracking.
+ *
+ * alloc_tracker.cpp replaces the global operator new/delete, so linking it
+ * into a target is enough to install the hook. Counting costs one relaxed
+ * load per allocation until something asks for it:
+ *
+ *  - allocTrackingSetEnabled(true) counts every thread into process totals
+ *    and per-frame stats (allocFrameBegin marks frame boundaries);
+ *  - an AllocScope counts the allocations of its own thread while it is
+ *    alive, whether or not global tracking is on. Tests use it to assert a
+ *    code path allocates nothing.
+ *
+ * Frees are counted as observed; memory allocated before tracking started
+ * may be freed while it is on.
+ */
+struct AllocCounts {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0; // requested sizes, not allocator overhead
+    uint64_t frees = 0;
+};
+
+struct AllocScopeCounts {
+    const char* name = nullptr;
+    AllocCounts counts;
+};
+
+struct AllocFrameStats {
+    static constexpr int kMaxScopes = 16;
+
+    uint64_t frame = 0;   // frames completed since tracking was enabled
+    AllocCounts total;    // every thread, whole frame
+    AllocCounts peak;     // the frame with the most allocations so far
+    AllocScopeCounts scopes[kMaxScopes]; // named scopes, in first-seen order
+    int scopeCount = 0;
+};
+
+void allocTrackingSetEnabled(bool enabled);
+bool allocTrackingEnabled();
+
+// Process-wide counts since tracking was first enabled.
+AllocCounts allocTotals();
+
+// Closes the current frame (if tracking is on) and starts the next one.
+void allocFrameBegin();
+// Stats of the last completed frame; zeroed while tracking is off.
+const AllocFrameStats& allocLastFrame();
+
+/**
+ * Counts the calling thread's allocations from construction on. A named
+ * scope also adds its counts to the current frame's table when it closes,
+ * if global tracking is on; scopes sharing a name are summed, and nested
+ * scopes are inclusive. Names must outlive the frame (string literals).
+ */
+class AllocScope {
+public:
+    explicit AllocScope(const char* name = nullptr);
+    ~AllocScope();
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+
+    AllocCounts counts() const;
+
+private:
+    const char* name_;
+    AllocCounts start_;
+};
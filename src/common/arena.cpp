@@ -0,0 +1,54 @@
+#include "arena.h"
+#include <algorithm>
+
+Arena::Arena(size_t blockSize, std::pmr::memory_resource* upstream)
+    : upstream_(upstream), blockSize_(std::max<size_t>(blockSize, 256)) {}
+
+Arena::~Arena() {
+    release();
+}
+
+void Arena::reset() {
+    current_ = 0;
+    offset_ = 0;
+    stats_.bytesUsed = 0;
+    stats_.resets++;
+}
+
+void Arena::release() {
+    for (const Block& b : blocks_) {
+        upstream_->deallocate(b.data, b.size, alignof(std::max_align_t));
+    }
+    blocks_.clear();
+    stats_.bytesReserved = 0;
+    stats_.blocks = 0;
+    reset();
+}
+
+void* Arena::do_allocate(size_t bytes, size_t alignment) {
+    bytes = std::max<size_t>(bytes, 1);
+    // Bump through the blocks kept from earlier decisions before asking upstream.
+    for (; current_ < blocks_.size(); ++current_, offset_ = 0) {
+        const Block& b = blocks_[current_];
+        uintptr_t base = reinterpret_cast<uintptr_t>(b.data);
+        uintptr_t start = (base + offset_ + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        size_t end = static_cast<size_t>(start - base) + bytes;
+        if (end <= b.size) {
+            stats_.bytesUsed += end - offset_;
+            stats_.peakBytes = std::max(stats_.peakBytes, stats_.bytesUsed);
+            offset_ = end;
+            return reinterpret_cast<void*>(start);
+        }
+    }
+
+    // Out of blocks: grow geometrically so a deep search settles on a few blocks.
+    size_t size = std::max(blockSize_ << std::min<size_t>(blocks_.size(), 4), bytes + alignment);
+    Block block{static_cast<std::byte*>(upstream_->allocate(size, alignof(std::max_align_t))), size};
+    blocks_.push_back(block);
+    stats_.bytesReserved += size;
+    stats_.blocks = blocks_.size();
+    stats_.upstreamAllocations++;
+    current_ = blocks_.size() - 1;
+    offset_ = 0;
+    return do_allocate(bytes, alignment);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+struct ArenaStats {
+    size_t bytesUsed = 0;     // handed out since the last reset, alignment padding included
+    size_t peakBytes = 0;     // highest bytesUsed seen since construction
+    size_t bytesReserved = 0; // total size of the blocks held
+    size_t blocks = 0;
+    uint64_t upstreamAllocations = 0; // blocks ever requested from the upstream resource
+    uint64_t resets = 0;
+};
+
+/**
+ * Monotonic bump allocator for per-decision scratch (search states, compiled
+ * plans, pmr containers).
+ *
+ * Memory comes from a list of blocks taken from an upstream resource. Freeing
+ * is a no-op, and reset() rewinds to the start of the first block in O(1).
+ * Blocks are kept across resets, so once an arena has grown to a decision's
+ * peak, later decisions never touch the global allocator.
+ *
+ * Everything allocated from the arena, including shared_ptr control blocks of
+ * GameState forks, must be destroyed before reset(). Not thread-safe: use one
+ * arena per thread.
+ */
+class Arena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t kDefaultBlockSize = 64 * 1024;
+
+    explicit Arena(size_t blockSize = kDefaultBlockSize,
+                   std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~Arena() override;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Forget every allocation; blocks stay reserved for the next decision.
+    void reset();
+    // Reset and hand every block back to the upstream resource.
+    void release();
+
+    size_t bytesUsed() const { return stats_.bytesUsed; }
+    size_t peakBytes() const { return stats_.peakBytes; }
+    const ArenaStats& stats() const { return stats_; }
+
+private:
+    struct Block {
+        std::byte* data = nullptr;
+        size_t size = 0;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    std::pmr::memory_resource* upstream_;
+    size_t blockSize_;
+    std::vector<Block> blocks_;
+    size_t current_ = 0; // block being bumped
+    size_t offset_ = 0;  // first free byte in blocks_[current_]
+    ArenaStats stats_;
+};
+
+/**
+ * Resets an arena when it goes out of scope. Declare it before anything that
+ * allocates from the arena so those objects are destroyed first.
+ */
+class ArenaScope {
+public:
+    explicit ArenaScope(Arena& arena) : arena_(arena) {}
+    ~ArenaScope() { arena_.reset(); }
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    Arena& arena_;
+};
@@ -0,0 +1,119 @@
+#include "jobsystem.h"
+#include "profiler.h"
+
+namespace {
+
+thread_local const JobSystem* tlsOwner = nullptr;
+thread_local int tlsIndex = 0;
+
+} // namespace
+
+JobSystem::JobSystem(int workerCount) {
+    if (workerCount <= 0) {
+        workerCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    }
+    queues_.reserve(workerCount + 1);
+    for (int i = 0; i <= workerCount; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    workers_.reserve(workerCount);
+    for (int i = 1; i <= workerCount; ++i) {
+        workers_.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stop_.store(true, std::memory_order_relaxed);
+    }
+    sleepCv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+int JobSystem::currentThreadIndex() const {
+    return tlsOwner == this ? tlsIndex : 0;
+}
+
+void JobSystem::run(TaskGroup& group, Job job) {
+    group.pending_.fetch_add(1, std::memory_order_relaxed);
+    Queue& queue = *queues_[currentThreadIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back({std::move(job), &group});
+    }
+    {
+        // Taking the sleep lock orders the increment against a worker's predicate check.
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        queued_.fetch_add(1, std::memory_order_relaxed);
+    }
+    sleepCv_.notify_one();
+}
+
+void JobSystem::wait(TaskGroup& group) {
+    int self = currentThreadIndex();
+    while (!group.done()) {
+        if (!tryRunOne(self)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::workerLoop(int index) {
+    tlsOwner = this;
+    tlsIndex = index;
+    profilerSetThreadName("job worker " + std::to_string(index));
+    for (;;) {
+        if (tryRunOne(index)) continue;
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepCv_.wait(lock, [this]() {
+            return stop_.load(std::memory_order_relaxed) || queued_.load(std::memory_order_relaxed) > 0;
+        });
+        if (stop_.load(std::memory_order_relaxed) && queued_.load(std::memory_order_relaxed) == 0) return;
+    }
+}
+
+bool JobSystem::tryRunOne(int self) {
+    Task task;
+    if (popLocal(self, task) || steal(self, task)) {
+        execute(task);
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::popLocal(int self, Task& out) {
+    Queue& queue = *queues_[self];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    out = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool JobSystem::steal(int self, Task& out) {
+    int count = static_cast<int>(queues_.size());
+    for (int offset = 1; offset < count; ++offset) {
+        Queue& queue = *queues_[(self + offset) % count];
+        std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+        if (!lock.owns_lock() || queue.tasks.empty()) continue;
+        out = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::execute(Task& task) {
+    task.fn();
+    task.group->pending_.fetch_sub(1, std::memory_order_release);
+}
+
+JobSystem& jobSystem() {
+    static JobSystem pool;
+    return pool;
+}
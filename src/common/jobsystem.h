@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Counts outstanding jobs submitted under it. Wait on it with JobSystem::wait;
+// the group must outlive its jobs.
+class TaskGroup {
+public:
+    bool done() const { return pending_.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> pending_{0};
+};
+
+// Work-stealing thread pool. Each worker owns a deque: it pushes and pops at the
+// back (LIFO, cache-warm), idle workers steal from the front of other deques.
+// Threads outside the pool submit into a shared injection deque. wait() runs
+// queued jobs on the calling thread until the group drains, so nested
+// parallelFor and waiting from inside a job never deadlock. Jobs must not throw.
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    // workerCount 0 = hardware threads minus one (the submitting thread helps), at least 1.
+    explicit JobSystem(int workerCount = 0);
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    int workerCount() const { return static_cast<int>(workers_.size()); }
+    // Workers plus the submitting thread: the useful degree of parallelism.
+    int threadCount() const { return workerCount() + 1; }
+
+    void run(TaskGroup& group, Job job);
+    void wait(TaskGroup& group);
+
+    // Calls fn(chunkBegin, chunkEnd) over [begin, end) in chunks of at most grain
+    // items and returns once every chunk has run.
+    template <typename Fn>
+    void parallelFor(int begin, int end, int grain, Fn&& fn) {
+        if (end <= begin) return;
+        grain = std::max(1, grain);
+        if (end - begin <= grain) {
+            fn(begin, end);
+            return;
+        }
+        TaskGroup group;
+        for (int chunk = begin; chunk < end; chunk += grain) {
+            int chunkEnd = std::min(end, chunk + grain);
+            run(group, [&fn, chunk, chunkEnd]() { fn(chunk, chunkEnd); });
+        }
+        wait(group);
+    }
+
+    // 1..workerCount on this pool's workers, 0 on any other thread.
+    int currentThreadIndex() const;
+
+private:
+    struct Task {
+        Job fn;
+        TaskGroup* group = nullptr;
+    };
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(int index);
+    bool tryRunOne(int self);
+    bool popLocal(int self, Task& out);
+    bool steal(int self, Task& out);
+    void execute(Task& task);
+
+    std::vector<std::unique_ptr<Queue>> queues_; // [0] = injection queue for outside threads
+    std::vector<std::thread> workers_;
+    std::atomic<int> queued_{0};
+    std::atomic<bool> stop_{false};
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCv_;
+};
+
+// Process-wide pool shared by simulation, AI and asset building.
+JobSystem& jobSystem();
@@ -0,0 +1,172 @@
+#include "profiler.h"
+#include "utils/jsonCodec.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace {
+
+// One per thread that ever opened a zone or set its name; never freed, so a
+// finished thread's events stay exportable.
+struct ThreadRing {
+    uint32_t id = 0;
+    std::string name;
+    // Written by the owning thread under gRegistryMutex; the owner alone
+    // reads them without the lock.
+    uint64_t generation = 0;
+    std::vector<ProfileEvent> events;
+    std::atomic<uint64_t> claimed{0}; // slot writes started this generation
+    std::atomic<uint64_t> head{0};    // slot writes finished this generation
+};
+
+std::atomic<bool> gRecording{false};
+std::atomic<uint64_t> gGeneration{0};
+std::atomic<size_t> gCapacity{kProfilerDefaultEvents};
+std::mutex gRegistryMutex;
+std::vector<std::unique_ptr<ThreadRing>> gRings;
+thread_local ThreadRing* tlRing = nullptr;
+
+ThreadRing& threadRing() {
+    if (!tlRing) {
+        std::lock_guard<std::mutex> lock(gRegistryMutex);
+        auto ring = std::make_unique<ThreadRing>();
+        ring->id = static_cast<uint32_t>(gRings.size() + 1);
+        tlRing = ring.get();
+        gRings.push_back(std::move(ring));
+    }
+    return *tlRing;
+}
+
+void record(const char* name, int64_t startNs, int64_t endNs) {
+    ThreadRing& ring = threadRing();
+    uint64_t generation = gGeneration.load(std::memory_order_acquire);
+    if (ring.generation != generation) {
+        // First zone since profilerStart: size and clear the ring.
+        std::lock_guard<std::mutex> lock(gRegistryMutex);
+        ring.events.assign(gCapacity.load(std::memory_order_relaxed), ProfileEvent{});
+        ring.claimed.store(0, std::memory_order_relaxed);
+        ring.head.store(0, std::memory_order_relaxed);
+        ring.generation = generation;
+    }
+    uint64_t head = ring.head.load(std::memory_order_relaxed);
+    ring.claimed.store(head + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    ring.events[head % ring.events.size()] = {name, startNs, endNs - startNs, ring.id};
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+// Copies one ring's live events; caller holds gRegistryMutex.
+void collectRing(const ThreadRing& ring, std::vector<ProfileEvent>& out) {
+    const uint64_t capacity = ring.events.size();
+    if (capacity == 0) return;
+    uint64_t before = ring.head.load(std::memory_order_acquire);
+    uint64_t first = before > capacity ? before - capacity : 0;
+    size_t base = out.size();
+    for (uint64_t i = first; i < before; ++i) out.push_back(ring.events[i % capacity]);
+    // Drop anything the owner started overwriting while we copied.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t claimed = ring.claimed.load(std::memory_order_relaxed);
+    uint64_t valid = claimed > capacity ? claimed - capacity : 0;
+    if (valid > first) {
+        size_t stale = static_cast<size_t>(std::min(valid, before) - first);
+        out.erase(out.begin() + base, out.begin() + base + stale);
+    }
+}
+
+} // namespace
+
+int64_t profilerNowNs() {
+    static const auto epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+void profilerStart(size_t eventsPerThread) {
+    profilerNowNs(); // pin the epoch
+    std::lock_guard<std::mutex> lock(gRegistryMutex);
+    gCapacity.store(std::max<size_t>(eventsPerThread, 1), std::memory_order_relaxed);
+    gGeneration.fetch_add(1, std::memory_order_release);
+    gRecording.store(true, std::memory_order_relaxed);
+}
+
+void profilerStop() {
+    gRecording.store(false, std::memory_order_relaxed);
+}
+
+bool profilerRecording() {
+    return gRecording.load(std::memory_order_relaxed);
+}
+
+void profilerSetThreadName(std::string_view name) {
+    ThreadRing& ring = threadRing();
+    std::lock_guard<std::mutex> lock(gRegistryMutex);
+    ring.name.assign(name);
+}
+
+void profilerCollect(std::vector<ProfileEvent>& out) {
+    out.clear();
+    std::lock_guard<std::mutex> lock(gRegistryMutex);
+    uint64_t generation = gGeneration.load(std::memory_order_relaxed);
+    for (const auto& ring : gRings) {
+        if (ring->generation == generation) collectRing(*ring, out);
+    }
+}
+
+void profilerWriteChromeTrace(std::string& out) {
+    std::vector<ProfileEvent> events;
+    profilerCollect(events);
+    std::vector<std::pair<uint32_t, std::string>> names;
+    {
+        std::lock_guard<std::mutex> lock(gRegistryMutex);
+        for (const auto& ring : gRings) {
+            if (!ring->name.empty()) names.emplace_back(ring->id, ring->name);
+        }
+    }
+
+    out.clear();
+    JsonWriter w(out);
+    w.beginObject().key("displayTimeUnit").value("ms").key("traceEvents").beginArray();
+    for (const auto& [id, name] : names) {
+        w.beginObject();
+        w.key("name").value("thread_name").key("ph").value("M");
+        w.key("pid").value(1).key("tid").value(static_cast<int>(id));
+        w.key("args").beginObject().key("name").value(name).endObject();
+        w.endObject();
+    }
+    for (const ProfileEvent& e : events) {
+        w.beginObject();
+        w.key("name").value(e.name ? e.name : "?").key("ph").value("X");
+        w.key("ts").value(e.startNs / 1000.0).key("dur").value(e.durationNs / 1000.0);
+        w.key("pid").value(1).key("tid").value(static_cast<int>(e.thread));
+        w.endObject();
+    }
+    w.endArray().endObject();
+    out.push_back('\n');
+}
+
+bool profilerSaveChromeTrace(const std::string& path, std::string* error) {
+    std::string json;
+    profilerWriteChromeTrace(json);
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        if (error) *error = "Could not open trace file for writing";
+        return false;
+    }
+    file.write(json.data(), static_cast<std::streamsize>(json.size()));
+    if (!file) {
+        if (error) *error = "Failed to write trace file";
+        return false;
+    }
+    return true;
+}
+
+ProfileZone::ProfileZone(const char* name)
+    : name_(name), startNs_(gRecording.load(std::memory_order_relaxed) ? profilerNowNs() : -1) {}
+
+ProfileZone::~ProfileZone() {
+    if (startNs_ < 0 || !gRecording.load(std::memory_order_relaxed)) return;
+    record(name_, startNs_, profilerNowNs());
+}
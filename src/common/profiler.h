@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Hierarchical CPU zone profiler.
+ *
+ * PROFILE_ZONE("name") times the enclosing scope. While recording, each
+ * closed zone becomes one event in its thread's ring buffer; nesting is
+ * recovered from the timestamps, so zones need no parent bookkeeping. A
+ * ring keeps the newest eventsPerThread zones and overwrites the oldest.
+ *
+ * Recording writes only to the calling thread's ring (single producer,
+ * published with a release store), so zones on different threads never
+ * contend. While stopped, a zone costs one relaxed load and a branch;
+ * defining VRAY_NO_PROFILER compiles the macros out entirely.
+ *
+ * Zone names must be string literals (or otherwise outlive the capture).
+ */
+struct ProfileEvent {
+    const char* name = nullptr;
+    int64_t startNs = 0; // since the profiler epoch (first use in the process)
+    int64_t durationNs = 0;
+    uint32_t thread = 0; // small per-thread id, stable for the process
+};
+
+constexpr size_t kProfilerDefaultEvents = 1 << 16;
+
+// Clears every ring and starts recording. Rings are resized on their
+// thread's next zone.
+void profilerStart(size_t eventsPerThread = kProfilerDefaultEvents);
+void profilerStop();
+bool profilerRecording();
+
+// Names the calling thread in exported traces ("main", "job worker 2").
+void profilerSetThreadName(std::string_view name);
+
+// Events still held by the rings, oldest first per thread. Safe while
+// recording; events overwritten during the copy are dropped.
+void profilerCollect(std::vector<ProfileEvent>& out);
+
+/**
+ * Chrome trace_event JSON (chrome://tracing, Perfetto): one complete ("X")
+ * event per zone with microsecond timestamps, plus thread_name metadata.
+ */
+void profilerWriteChromeTrace(std::string& out);
+bool profilerSaveChromeTrace(const std::string& path, std::string* error = nullptr);
+
+int64_t profilerNowNs();
+
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name);
+    ~ProfileZone();
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* name_;
+    int64_t startNs_;
+};
+
+#if defined(VRAY_NO_PROFILER)
+#define PROFILE_ZONE(name) ((void)0)
+#else
+#define PROFILE_ZONE_CONCAT_(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT_(a, b)
+#define PROFILE_ZONE(name) ProfileZone PROFILE_ZONE_CONCAT(profileZone_, __LINE__)(name)
+#endif
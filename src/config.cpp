@@ -47,6 +47,13 @@ AppConfig AppConfig::LoadFromFile(const std::string& filePath) {
     config.zoom_min = ParseLuaFloat(parser.GetTableValue("input", "zoom_min"), config.zoom_min);
     config.zoom_max = ParseLuaFloat(parser.GetTableValue("input", "zoom_max"), config.zoom_max);
 
+    // Load NPC planner settings from "ai" table
+    config.ai_search = ParseLuaBool(parser.GetTableValue("ai", "search"), config.ai_search);
+    config.ai_budget_ms = ParseLuaFloat(parser.GetTableValue("ai", "budget_ms"), config.ai_budget_ms);
+
+    // Load diagnostics from "debug" table
+    config.debug_alloc_tracking = ParseLuaBool(parser.GetTableValue("debug", "alloc_tracking"), config.debug_alloc_tracking);
+
     config.Validate();
     return config;
 }
@@ -80,6 +87,9 @@ void AppConfig::Validate() {
     }
     zoom_min = std::max(0.1f, std::min(100.0f, zoom_min));
     zoom_max = std::max(0.1f, std::min(200.0f, zoom_max));
+
+    // Clamp NPC search budget
+    ai_budget_ms = std::max(0.5f, std::min(1000.0f, ai_budget_ms));
 }
 
 AppConfig::AppConfig()
@@ -96,5 +106,8 @@ AppConfig::AppConfig()
       rotation_speed(2.5f),
       zoom_speed(3.0f),
       zoom_min(5.0f),
-      zoom_max(80.0f) {
+      zoom_max(80.0f),
+      ai_search(false),
+      ai_budget_ms(8.0f),
+      debug_alloc_tracking(false) {
 }
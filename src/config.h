@@ -31,6 +31,13 @@ struct AppConfig {
     float zoom_min;
     float zoom_max;
 
+    // NPC planning
+    bool ai_search;          // time-budgeted search instead of random picks
+    float ai_budget_ms;      // search budget per NPC turn
+
+    // Diagnostics
+    bool debug_alloc_tracking; // count heap allocations per frame from startup (F3 toggles)
+
     // Constructor with defaults
     AppConfig();
 
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <string>
-#include "raylib.h" // For Vector2
 
 enum EntityType {
     PLAYER,
@@ -16,10 +15,22 @@ enum class Facing {
     West  = 3
 };
 
+/**
+ * Simulation position: an integer board cell. Kept exact so every platform
+ * resolves the same moves, which lockstep peers and replay checksums rely on.
+ * Rendering interpolates separately (see WorldEntity).
+ */
+struct GridPos {
+    int x = 0;
+    int y = 0;
+
+    bool operator==(const GridPos&) const = default;
+};
+
 struct Entity {
     int id;
     EntityType type;
-    Vector2 position; // Grid coordinates (0-11)
+    GridPos position; // Grid cell (0-11)
     std::string name;
     int health = 100; // Example state
     Facing facing = Facing::North;
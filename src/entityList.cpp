@@ -0,0 +1,106 @@
+#include "entityList.h"
+#include <atomic>
+
+namespace {
+
+// use_count() is a relaxed read. Pair a "sole owner" answer with an acquire
+// fence so reads made through a fork that was just released happen before
+// this write.
+template <typename T>
+bool soleOwner(const std::shared_ptr<T>& p) {
+    if (p.use_count() != 1) return false;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return true;
+}
+
+} // namespace
+
+template <typename T, typename... Args>
+std::shared_ptr<T> EntityList::allocate(Args&&... args) const {
+    return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(resource_), std::forward<Args>(args)...);
+}
+
+EntityList::EntityList(std::initializer_list<Entity> entities) {
+    reserve(entities.size());
+    for (const Entity& e : entities) push_back(e);
+}
+
+EntityList::EntityList(const std::vector<Entity>& entities) {
+    reserve(entities.size());
+    for (const Entity& e : entities) push_back(e);
+}
+
+EntityList::EntityList(std::vector<Entity>&& entities) {
+    reserve(entities.size());
+    for (Entity& e : entities) push_back(std::move(e));
+    entities.clear();
+}
+
+EntityList::Root& EntityList::mutableRoot() {
+    if (!root_) {
+        root_ = allocate<Root>(resource_);
+    } else if (!soleOwner(root_)) {
+        root_ = allocate<Root>(*root_, resource_);
+    }
+    return *root_;
+}
+
+EntityList::Chunk& EntityList::mutableChunk(size_t chunk) {
+    std::shared_ptr<Chunk>& slot = mutableRoot().chunks[chunk];
+    if (!soleOwner(slot)) slot = allocate<Chunk>(*slot);
+    return *slot;
+}
+
+Entity& EntityList::appendSlot() {
+    size_t chunk = size_ / kChunkSize;
+    Root& root = mutableRoot();
+    if (chunk == root.chunks.size()) root.chunks.push_back(allocate<Chunk>());
+    return mutableChunk(chunk).items[size_++ % kChunkSize];
+}
+
+void EntityList::resize(size_t count) {
+    if (count < size_) {
+        if (count == 0) {
+            clear();
+            return;
+        }
+        // Slots past the end stay allocated; trailing chunks are dropped.
+        mutableRoot().chunks.resize((count + kChunkSize - 1) / kChunkSize);
+        size_ = count;
+        return;
+    }
+    while (size_ < count) appendSlot() = Entity{};
+}
+
+void EntityList::reserve(size_t count) {
+    mutableRoot().chunks.reserve((count + kChunkSize - 1) / kChunkSize);
+}
+
+void EntityList::clear() {
+    root_.reset();
+    size_ = 0;
+}
+
+std::vector<Entity> EntityList::takeVector() {
+    std::vector<Entity> out;
+    out.reserve(size_);
+    if (root_ && soleOwner(root_)) {
+        for (size_t i = 0; i < size_; ++i) {
+            std::shared_ptr<Chunk>& chunk = root_->chunks[i / kChunkSize];
+            Entity& e = chunk->items[i % kChunkSize];
+            if (soleOwner(chunk)) {
+                out.push_back(std::move(e));
+            } else {
+                out.push_back(e);
+            }
+        }
+    } else {
+        out.assign(begin(), end());
+    }
+    clear();
+    return out;
+}
+
+bool EntityList::sharesSlot(const EntityList& other, size_t i) const {
+    return i < size_ && i < other.size_ && &(*this)[i] == &other[i];
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+#include "entity.h"
+
+/**
+ * Persistent entity sequence for GameState.
+ *
+ * Entities live in fixed-size chunks. A root table points at the chunks, and
+ * the list points at the root. Copying a list copies one pointer, so forking
+ * a GameState is O(1). The first write to a fork copies the root table once.
+ * Each later write copies only the chunk holding that entity if another fork
+ * still shares it.
+ *
+ * Reads look like std::vector, and nothing reachable through operator[] or an
+ * iterator is mutable, so reading never copies. Writes are explicit: edit(i)
+ * returns a mutable entity. The append and resize members also write. Slots
+ * keep their indices across forks, which zobrist keys rely on.
+ *
+ * Root tables and chunks come from the list's memory resource (the heap by
+ * default). Copies inherit it. Search code points a fork at an Arena so its
+ * chunk copies are bump-allocated; such a fork must be destroyed before the
+ * arena is reset.
+ *
+ * Forks may be handed to other threads. A single list is not synchronised.
+ */
+class EntityList {
+public:
+    static constexpr size_t kChunkSize = 4;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Entity;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Entity*;
+        using reference = const Entity&;
+
+        const_iterator() = default;
+        const_iterator(const EntityList* list, size_t index) : list_(list), index_(index) {}
+
+        reference operator*() const { return (*list_)[index_]; }
+        pointer operator->() const { return &(*list_)[index_]; }
+        reference operator[](difference_type n) const { return (*list_)[index_ + n]; }
+        const_iterator& operator++() { ++index_; return *this; }
+        const_iterator operator++(int) { const_iterator t = *this; ++index_; return t; }
+        const_iterator& operator--() { --index_; return *this; }
+        const_iterator operator--(int) { const_iterator t = *this; --index_; return t; }
+        const_iterator& operator+=(difference_type n) { index_ += n; return *this; }
+        const_iterator& operator-=(difference_type n) { index_ -= n; return *this; }
+        const_iterator operator+(difference_type n) const { return {list_, index_ + n}; }
+        const_iterator operator-(difference_type n) const { return {list_, index_ - n}; }
+        difference_type operator-(const_iterator o) const {
+            return static_cast<difference_type>(index_) - static_cast<difference_type>(o.index_);
+        }
+        bool operator==(const const_iterator& o) const { return index_ == o.index_ && list_ == o.list_; }
+        auto operator<=>(const const_iterator& o) const { return index_ <=> o.index_; }
+
+    private:
+        const EntityList* list_ = nullptr;
+        size_t index_ = 0;
+    };
+    using iterator = const_iterator;
+    using value_type = Entity;
+    using size_type = size_t;
+
+    EntityList() = default;
+    EntityList(std::initializer_list<Entity> entities);
+    EntityList(const std::vector<Entity>& entities);
+    EntityList(std::vector<Entity>&& entities);
+    explicit EntityList(std::pmr::memory_resource* resource) : resource_(resource) {}
+
+    // Where later copies of the root table and chunks are allocated. Storage
+    // already shared with other forks is left where it is.
+    std::pmr::memory_resource* resource() const { return resource_; }
+    void setResource(std::pmr::memory_resource* resource) { resource_ = resource; }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    const Entity& operator[](size_t i) const { return root_->chunks[i / kChunkSize]->items[i % kChunkSize]; }
+    // Copy-on-write access: detaches the root table and the chunk holding i
+    // from any other fork first.
+    Entity& edit(size_t i) { return mutableChunk(i / kChunkSize).items[i % kChunkSize]; }
+    const Entity& front() const { return (*this)[0]; }
+    const Entity& back() const { return (*this)[size_ - 1]; }
+
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, size_}; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    void push_back(const Entity& e) { appendSlot() = e; }
+    void push_back(Entity&& e) { appendSlot() = std::move(e); }
+    template <typename It>
+    void insert(const_iterator pos, It first, It last);
+    void resize(size_t count);
+    void reserve(size_t count);
+    void clear();
+
+    // Moves the entities out when no other fork shares them, copies otherwise.
+    // The list is left empty.
+    std::vector<Entity> takeVector();
+
+    // True when both lists read the same storage for slot i (no copy was made).
+    bool sharesSlot(const EntityList& other, size_t i) const;
+
+private:
+    struct Chunk {
+        std::array<Entity, kChunkSize> items{};
+    };
+    struct Root {
+        std::pmr::vector<std::shared_ptr<Chunk>> chunks;
+
+        explicit Root(std::pmr::memory_resource* resource) : chunks(resource) {}
+        Root(const Root& other, std::pmr::memory_resource* resource) : chunks(other.chunks, resource) {}
+    };
+
+    std::shared_ptr<Root> root_;
+    size_t size_ = 0;
+    std::pmr::memory_resource* resource_ = std::pmr::new_delete_resource();
+
+    template <typename T, typename... Args>
+    std::shared_ptr<T> allocate(Args&&... args) const;
+
+    Root& mutableRoot();
+    Chunk& mutableChunk(size_t chunk);
+    Entity& appendSlot();
+};
+
+template <typename It>
+void EntityList::insert(const_iterator pos, It first, It last) {
+    size_t at = static_cast<size_t>(pos - begin());
+    std::vector<Entity> tail(begin() + at, end());
+    resize(at);
+    for (; first != last; ++first) push_back(*first);
+    for (auto& e : tail) push_back(std::move(e));
+}
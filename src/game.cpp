@@ -1,7 +1,8 @@
 #include "game.h"
+#include "cardRegistry.h"
 #include "ui.h"
+#include "zobrist.h"
 #include <algorithm>
-#include <cmath>
 #include <sstream>
 #include "raylib.h" // TraceLog
 
@@ -9,7 +10,14 @@ namespace {
 
 void log_spawn(const Entity& e) {
     const char* who = (e.type == PLAYER) ? "Player" : (e.type == ENEMY ? "Enemy" : "Object");
-    TraceLog(LOG_INFO, "[Spawn] %s %d at (%.0f,%.0f)", who, e.id, e.position.x, e.position.y);
+    TraceLog(LOG_INFO, "[Spawn] %s %d at (%d,%d)", who, e.id, e.position.x, e.position.y);
+}
+
+// Debug turns bypass the recorded play path, so the replay would no longer reproduce the session.
+void stop_replay_recording(Game& game) {
+    if (!game.replay) return;
+    game.replay.reset();
+    TraceLog(LOG_INFO, "Debug turn used; replay recording stopped");
 }
 
 std::vector<int> collect_enemy_mech_ids(const std::vector<Entity>& entities) {
@@ -32,12 +40,10 @@ std::vector<int> collect_player_mech_ids(const std::vector<Entity>& entities) {
     return ids;
 }
 
-std::string format_plan(const TurnPlan& plan, const std::vector<Card>& hand) {
+std::string format_plan(const TurnPlan& plan, const Hand& hand) {
     auto findName = [&hand](int cardId) -> std::string {
-        for (const auto& c : hand) {
-            if (c.id == cardId) return c.name;
-        }
-        return "?";
+        const Card* c = hand.find(cardId);
+        return c ? c->name : "?";
     };
     std::ostringstream oss;
     for (size_t i = 0; i < plan.assignments.size(); ++i) {
@@ -51,6 +57,56 @@ std::string format_plan(const TurnPlan& plan, const std::vector<Card>& hand) {
 
 } // namespace
 
+GameState take_state(Game& game) {
+    GameState state;
+    state.grid = game.grid;
+    state.entities = EntityList(std::move(game.entities));
+    state.currentTurn = game.turnNumber;
+    // Callers may have edited game.entities directly; rebuild occupancy and hash once here.
+    state.grid.syncOccupancy(state.entities);
+    state.hash = zobristHash(state);
+    return state;
+}
+
+void restore_state(Game& game, GameState&& state) {
+    game.grid = state.grid;
+    game.entities = state.entities.takeVector();
+}
+
+void sync_state(const Game& game, GameState& state) {
+    state.grid = game.grid;
+    if (state.entities.size() != game.entities.size()) {
+        state.entities.resize(game.entities.size());
+    }
+    for (size_t i = 0; i < game.entities.size(); ++i) {
+        const Entity& src = game.entities[i];
+        const Entity& cur = state.entities[i];
+        if (cur.id == src.id && cur.type == src.type && cur.position == src.position && cur.health == src.health &&
+            cur.facing == src.facing && cur.name == src.name) {
+            continue; // untouched slots stay shared and keep their strings
+        }
+        state.entities.edit(i) = src;
+    }
+    state.currentTurn = game.turnNumber;
+    state.grid.syncOccupancy(state.entities);
+    state.hash = zobristHash(state);
+}
+
+void write_state(Game& game, const GameState& state) {
+    game.grid = state.grid;
+    if (game.entities.size() != state.entities.size()) {
+        game.entities.assign(state.entities.begin(), state.entities.end());
+        return;
+    }
+    for (size_t i = 0; i < game.entities.size(); ++i) {
+        const Entity& src = state.entities[i];
+        Entity& dst = game.entities[i];
+        dst.position = src.position;
+        dst.health = src.health;
+        dst.facing = src.facing;
+    }
+}
+
 void begin_turn(Game& game) {
     game.hand.resetUsage();
 }
@@ -64,20 +120,20 @@ void init_game(Game& game) {
 
     game.entities.clear();
     // Align with world spawn tiles: heroes on bottom-left cluster
-    Entity p1 = {1, PLAYER, {1.0f, 6.0f}, "Mech A"};
-    Entity p2 = {2, PLAYER, {2.0f, 6.0f}, "Mech B"};
-    Entity p3 = {3, PLAYER, {1.0f, 5.0f}, "Mech C"};
+    Entity p1 = {1, PLAYER, {1, 6}, "Mech A"};
+    Entity p2 = {2, PLAYER, {2, 6}, "Mech B"};
+    Entity p3 = {3, PLAYER, {1, 5}, "Mech C"};
     p1.facing = Facing::North;
     p2.facing = Facing::North;
     p3.facing = Facing::North;
     // Enemies on bottom-right cluster
-    Entity enemy1  = {4, ENEMY,  {6.0f, 6.0f}, "Enemy1"};
+    Entity enemy1  = {4, ENEMY,  {6, 6}, "Enemy1"};
     enemy1.facing = Facing::South;
-    Entity enemy2  = {5, ENEMY,  {5.0f, 6.0f}, "Enemy2"};
+    Entity enemy2  = {5, ENEMY,  {5, 6}, "Enemy2"};
     enemy2.facing = Facing::South;
-    Entity enemy3  = {6, ENEMY,  {6.0f, 5.0f}, "Enemy3"};
+    Entity enemy3  = {6, ENEMY,  {6, 5}, "Enemy3"};
     enemy3.facing = Facing::South;
-    Entity obj    = {10, OBJECT, {8.0f, 8.0f}, "Object1"};
+    Entity obj    = {10, OBJECT, {8, 8}, "Object1"};
     game.entities.push_back(p1);
     game.entities.push_back(p2);
     game.entities.push_back(p3);
@@ -85,28 +141,16 @@ void init_game(Game& game) {
     game.entities.push_back(enemy2);
     game.entities.push_back(enemy3);
     game.entities.push_back(obj);
+    game.grid.syncOccupancy(game.entities);
 
     for (const auto& e : game.entities) {
         log_spawn(e);
     }
 
     game.hand.clear();
-    auto makeMoveCard = [](int id, const char* name, MoveVector mv) {
-        Card c;
-        c.id = id;
-        c.name = name;
-        c.type = CardType::Move;
-        c.effect = {CardType::Move, mv};
-        c.mirroredEffect = mirrorEffect(c.effect);
-        return c;
-    };
-
-    game.hand.addCard(makeMoveCard(1, "Advance", {1, 0}));
-    game.hand.addCard(makeMoveCard(2, "StrafeLeft", {0, -1}));
-    game.hand.addCard(makeMoveCard(3, "StrafeRight", {0, 1}));
-    game.hand.addCard(makeMoveCard(4, "Lunge", {2, 0}));
-    game.hand.addCard(makeMoveCard(5, "Retreat", {-1, 0}));
-    game.hand.addCard(makeMoveCard(6, "HookLeft", {1, -1}));
+    for (size_t i = 0; i < kBuiltinCards.size(); ++i) {
+        game.hand.addCard(builtinCardHandle(i));
+    }
 
     game.turnNumber = 1;
     begin_turn(game);
@@ -127,18 +171,20 @@ void update_game(Game& game, float dt) {
 void handle_input(Game& game, const Platform& platform) {
     // Keyboard input for triggering a sample round (debug)
     if (platform.input->IsKeyPressed(KEY_ONE)) {
-        if (game.hand.cards.size() >= 2) {
+        if (game.hand.size() >= 2) {
+            stop_replay_recording(game);
             TurnPlan plan;
             auto players = collect_player_mech_ids(game.entities);
             int mechId = players.empty() ? 1 : players.front();
-            plan.assignments.push_back({mechId, game.hand.cards[0].id, false});
-            plan.assignments.push_back({mechId, game.hand.cards[1].id, true});
+            plan.assignments.push_back({mechId, game.hand.cards()[0].id, false});
+            plan.assignments.push_back({mechId, game.hand.cards()[1].id, true});
             resolve_round(game, plan);
         }
     }
 
     // Keyboard input for triggering AI random turn (debug)
     if (platform.input->IsKeyPressed(KEY_TWO)) {
+        stop_replay_recording(game);
         execute_ai_random_turn(game, 42u);
         advance_turn(game);
     }
@@ -147,10 +193,7 @@ void handle_input(Game& game, const Platform& platform) {
 void handle_ui_actions(Game& game, const CardActions& actions, bool allowResolve) {
     // Step 1: select a card (no assignment yet)
     if (actions.selectCardId != -1) {
-        const Card* cardPtr = nullptr;
-        for (const auto& c : game.hand.cards) {
-            if (c.id == actions.selectCardId) { cardPtr = &c; break; }
-        }
+        const Card* cardPtr = game.hand.find(actions.selectCardId);
         if (cardPtr) {
             game.pendingCardId = cardPtr->id;
             game.pendingMirror = actions.mirrorNext;
@@ -160,10 +203,7 @@ void handle_ui_actions(Game& game, const CardActions& actions, bool allowResolve
     // Step 2: assign selected card to a mech
     if (actions.assignCardToMech != -1 && game.pendingCardId != -1) {
         int mechId = actions.assignCardToMech;
-        const Card* cardPtr = nullptr;
-        for (const auto& c : game.hand.cards) {
-            if (c.id == game.pendingCardId) { cardPtr = &c; break; }
-        }
+        const Card* cardPtr = game.hand.find(game.pendingCardId);
         if (cardPtr) {
             int existingIdx = -1;
             for (size_t i = 0; i < game.currentPlan.assignments.size(); ++i) {
@@ -237,17 +277,16 @@ void execute_ai_random_turn(Game& game, uint32_t seed, float mirrorChance) {
 
     TurnPlan plan = buildRandomPlan(mechIds, game.hand, seed, mirrorChance);
     std::string error;
-    if (!plan.validate(game.hand.cards, mechIds, &error)) {
+    if (!plan.validate(game.hand, mechIds, &error)) {
         TraceLog(LOG_WARNING, "AI plan invalid: %s", error.c_str());
         return;
     }
 
-    GameState gs{game.grid, game.entities};
-    gs = plan.apply(gs, game.hand.cards, game.grid);
-    game.grid = gs.grid;
-    game.entities = gs.entities;
+    GameState gs = take_state(game);
+    plan.resolve(gs, game.hand);
+    restore_state(game, std::move(gs));
     game.lastAiPlan = plan;
-    game.lastAiPlanText = format_plan(plan, game.hand.cards);
+    game.lastAiPlanText = format_plan(plan, game.hand);
     begin_turn(game);
     TraceLog(LOG_INFO, "AI random turn executed (%zu assignments)", plan.assignments.size());
 }
@@ -258,14 +297,13 @@ void resolve_round(Game& game, const TurnPlan& playerPlan, uint32_t seed, float
     std::vector<int> playerMechs = collect_player_mech_ids(game.entities);
 
     std::string playerErr;
-    if (!playerPlan.validate(game.hand.cards, playerMechs, &playerErr)) {
+    if (!playerPlan.validate(game.hand, playerMechs, &playerErr)) {
         TraceLog(LOG_WARNING, "Player plan invalid: %s", playerErr.c_str());
     } else {
-        GameState gs{game.grid, game.entities};
         TraceLog(LOG_INFO, "Player applying plan (%zu cards)", playerPlan.assignments.size());
-        gs = playerPlan.apply(gs, game.hand.cards, game.grid);
-        game.grid = gs.grid;
-        game.entities = gs.entities;
+        GameState gs = take_state(game);
+        playerPlan.resolve(gs, game.hand);
+        restore_state(game, std::move(gs));
     }
 
     // Clear player plan and hand usage to allow AI use if sharing hand
@@ -1,12 +1,16 @@
 #pragma once
 
 #include "platform/platform.h"
+#include <memory>
 #include <vector>
 #include "grid.h"
 #include "entity.h"
 #include "card.h"
 
 struct CardActions;
+class NpcPlanner;
+class NpcPlanTask;
+struct ReplayLog;
 
 struct Game {
     Grid grid;
@@ -23,8 +27,25 @@ struct Game {
     int turnNumber = 0;
     float planetRot = 0.0f;
     float cloudsRot = 0.0f;
+    std::shared_ptr<NpcPlanner> npcPlanner; // null = seeded random planner
+    float npcBudgetMs = 8.0f;               // per-turn search budget
+    std::shared_ptr<NpcPlanTask> npcTask;   // background NPC planning, created on first use
+    std::shared_ptr<ReplayLog> replay;      // when set, every played turn is recorded
 };
 
+// Move the simulation state (grid, entities, turn) out of Game without copying
+// entities; pair with restore_state once resolution is done.
+GameState take_state(Game& game);
+void restore_state(Game& game, GameState&& state);
+
+// In-place counterparts for code that resolves into one GameState over many
+// frames. sync_state overwrites state from Game through state's own storage
+// (no allocation when state is unshared and the entity count is unchanged),
+// then rebuilds occupancy and hash. write_state copies positions, health and
+// facing back into the existing game.entities, plus the grid.
+void sync_state(const Game& game, GameState& state);
+void write_state(Game& game, const GameState& state);
+
 // Reset per-turn state (hand usage, sequence).
 void begin_turn(Game& game);
 
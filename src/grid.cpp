@@ -1,12 +1,16 @@
 #include "grid.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+
+int Bitboard::count() const {
+    return std::popcount(words[0]) + std::popcount(words[1]) + std::popcount(words[2]);
+}
 
 Grid::Grid() {
-    // Initialize all cells to empty
-    for (auto& row : cells) {
-        for (auto& cell : row) {
-            cell.type = 0;
-        }
-    }
+    // Every board starts on the same empty table; setCell detaches on first write
+    static const std::shared_ptr<CellTable> empty = std::make_shared<CellTable>();
+    cells_ = empty;
 }
 
 bool Grid::isValidPosition(int x, int y) const {
@@ -14,14 +18,108 @@ bool Grid::isValidPosition(int x, int y) const {
 }
 
 void Grid::setCell(int x, int y, int type) {
-    if (isValidPosition(x, y)) {
-        cells[y][x].type = type;
+    if (!isValidPosition(x, y) || (*cells_)[cellIndex(x, y)].type == type) return;
+    if (cells_.use_count() != 1) {
+        cells_ = std::make_shared<CellTable>(*cells_);
+    } else {
+        std::atomic_thread_fence(std::memory_order_acquire); // pairs with other copies' release
     }
+    (*cells_)[cellIndex(x, y)].type = type;
 }
 
 int Grid::getCell(int x, int y) const {
     if (isValidPosition(x, y)) {
-        return cells[y][x].type;
+        return (*cells_)[cellIndex(x, y)].type;
     }
     return -1; // Invalid
-}
\ No newline at end of file
+}
+
+void Grid::clearOccupancy() {
+    occupied_.reset();
+    for (auto& team : teams_) {
+        team.reset();
+    }
+}
+
+void Grid::placeOccupant(int x, int y, EntityType team) {
+    if (!isValidPosition(x, y)) return;
+    int idx = cellIndex(x, y);
+    occupied_.set(idx);
+    teams_[team].set(idx);
+}
+
+void Grid::removeOccupant(int x, int y, EntityType team) {
+    if (!isValidPosition(x, y)) return;
+    int idx = cellIndex(x, y);
+    teams_[team].clear(idx);
+    if (!(teams_[PLAYER].test(idx) || teams_[ENEMY].test(idx) || teams_[OBJECT].test(idx))) {
+        occupied_.clear(idx);
+    }
+}
+
+void Grid::moveOccupant(int fromX, int fromY, int toX, int toY, EntityType team) {
+    removeOccupant(fromX, fromY, team);
+    placeOccupant(toX, toY, team);
+}
+
+bool Grid::isOccupied(int x, int y) const {
+    return isValidPosition(x, y) && occupied_.test(cellIndex(x, y));
+}
+
+bool Grid::canSpawnAt(int x, int y) const {
+    return isValidPosition(x, y) && !occupied_.test(cellIndex(x, y));
+}
+
+bool Grid::hasAdjacent(int x, int y, EntityType team) const {
+    return (neighborMask(x, y) & teams_[team]).any();
+}
+
+const Bitboard& Grid::neighborMask(int x, int y) {
+    static const std::array<Bitboard, CELLS> table = [] {
+        std::array<Bitboard, CELLS> t{};
+        for (int cy = 0; cy < SIZE; ++cy) {
+            for (int cx = 0; cx < SIZE; ++cx) {
+                Bitboard& b = t[cellIndex(cx, cy)];
+                if (cx > 0) b.set(cellIndex(cx - 1, cy));
+                if (cx < SIZE - 1) b.set(cellIndex(cx + 1, cy));
+                if (cy > 0) b.set(cellIndex(cx, cy - 1));
+                if (cy < SIZE - 1) b.set(cellIndex(cx, cy + 1));
+            }
+        }
+        return t;
+    }();
+    static const Bitboard empty{};
+    if (x < 0 || x >= SIZE || y < 0 || y >= SIZE) return empty;
+    return table[cellIndex(x, y)];
+}
+
+int Grid::clampedDestination(int cell, CellDelta step) {
+    constexpr int span = 2 * kMoveReach + 1;
+    static const std::array<std::array<uint8_t, span * span>, CELLS> table = [] {
+        std::array<std::array<uint8_t, span * span>, CELLS> t{};
+        for (int c = 0; c < CELLS; ++c) {
+            for (int dy = -kMoveReach; dy <= kMoveReach; ++dy) {
+                for (int dx = -kMoveReach; dx <= kMoveReach; ++dx) {
+                    int tx = std::clamp(c % SIZE + dx, 0, SIZE - 1);
+                    int ty = std::clamp(c / SIZE + dy, 0, SIZE - 1);
+                    t[c][(dy + kMoveReach) * span + dx + kMoveReach] = static_cast<uint8_t>(cellIndex(tx, ty));
+                }
+            }
+        }
+        return t;
+    }();
+    if (step.dx >= -kMoveReach && step.dx <= kMoveReach && step.dy >= -kMoveReach && step.dy <= kMoveReach) {
+        return table[cell][(step.dy + kMoveReach) * span + step.dx + kMoveReach];
+    }
+    int tx = std::clamp(cell % SIZE + step.dx, 0, SIZE - 1);
+    int ty = std::clamp(cell / SIZE + step.dy, 0, SIZE - 1);
+    return cellIndex(tx, ty);
+}
+
+int Grid::moveDestination(int x, int y, CellDelta step, bool* blocked) const {
+    int from = cellIndex(x, y);
+    int to = clampedDestination(from, step);
+    bool hit = to != from && occupied_.test(to);
+    if (blocked) *blocked = hit;
+    return hit ? from : to;
+}
@@ -2,19 +2,104 @@
 
 #include <vector>
 #include <array>
+#include <cstdint>
+#include <memory>
+#include "entity.h"
 
 struct GridCell {
     // Placeholder for cell data, e.g., terrain type, occupancy
     int type = 0; // 0 = empty, 1 = occupied, etc.
 };
 
+/**
+ * 144-bit cell set for the 12x12 board, one bit per cell (index y * SIZE + x).
+ */
+struct Bitboard {
+    std::array<uint64_t, 3> words{};
+
+    void set(int index) { words[index >> 6] |= (1ull << (index & 63)); }
+    void clear(int index) { words[index >> 6] &= ~(1ull << (index & 63)); }
+    bool test(int index) const { return (words[index >> 6] >> (index & 63)) & 1ull; }
+    bool any() const { return (words[0] | words[1] | words[2]) != 0; }
+    int count() const;
+    void reset() { words = {}; }
+
+    Bitboard operator&(const Bitboard& o) const {
+        return {{words[0] & o.words[0], words[1] & o.words[1], words[2] & o.words[2]}};
+    }
+    Bitboard operator|(const Bitboard& o) const {
+        return {{words[0] | o.words[0], words[1] | o.words[1], words[2] | o.words[2]}};
+    }
+    bool operator==(const Bitboard& o) const = default;
+};
+
+/**
+ * Board-space step in cells (+x east, +y north).
+ */
+struct CellDelta {
+    int8_t dx = 0;
+    int8_t dy = 0;
+
+    bool operator==(const CellDelta&) const = default;
+};
+
+/**
+ * 12x12 board: per-cell types plus occupancy bitboards. Cell types sit in a
+ * shared, copy-on-write table (all boards start on one empty table), so
+ * copying a Grid copies the bitboards and one pointer.
+ */
 class Grid {
 public:
     static constexpr int SIZE = 12;
-    std::array<std::array<GridCell, SIZE>, SIZE> cells;
+    static constexpr int CELLS = SIZE * SIZE;
+    static constexpr int TEAMS = 3; // indexed by EntityType
 
     Grid();
     bool isValidPosition(int x, int y) const;
     void setCell(int x, int y, int type);
     int getCell(int x, int y) const;
-};
\ No newline at end of file
+
+    static constexpr int cellIndex(int x, int y) { return y * SIZE + x; }
+
+    // Occupancy bitboards. Card resolution keeps these in sync with entity moves;
+    // call syncOccupancy after editing an entity list directly.
+    template <typename Entities>
+    void syncOccupancy(const Entities& entities);
+    void placeOccupant(int x, int y, EntityType team);
+    void removeOccupant(int x, int y, EntityType team);
+    void moveOccupant(int fromX, int fromY, int toX, int toY, EntityType team);
+
+    bool isOccupied(int x, int y) const;
+    bool canSpawnAt(int x, int y) const;
+    bool hasAdjacent(int x, int y, EntityType team) const;
+    const Bitboard& occupancy() const { return occupied_; }
+    const Bitboard& teamOccupancy(EntityType team) const { return teams_[team]; }
+
+    // 4-neighbourhood of a cell as a mask (empty for off-board cells).
+    static const Bitboard& neighborMask(int x, int y);
+
+    // Cell index a step lands on from an on-board cell, clamped to the board.
+    // Steps within kMoveReach on both axes come from a precomputed per-cell table.
+    static constexpr int kMoveReach = 3;
+    static int clampedDestination(int cell, CellDelta step);
+    // Where a move from (x, y) ends: the clamped cell when it is free, otherwise
+    // (x, y) itself. blocked reports an occupied destination.
+    int moveDestination(int x, int y, CellDelta step, bool* blocked = nullptr) const;
+
+private:
+    using CellTable = std::array<GridCell, CELLS>;
+
+    std::shared_ptr<CellTable> cells_;
+    Bitboard occupied_;
+    std::array<Bitboard, TEAMS> teams_{};
+
+    void clearOccupancy();
+};
+
+template <typename Entities>
+void Grid::syncOccupancy(const Entities& entities) {
+    clearOccupancy();
+    for (const Entity& e : entities) {
+        placeOccupant(e.position.x, e.position.y, e.type);
+    }
+}
@@ -5,6 +5,7 @@
 #include "app.h"
 #include "game.h"
 #include "card.h"
+#include "cardRegistry.h"
 #include "camControl.h"
 #include "render.h"
 #include "ui.h"
@@ -13,6 +14,10 @@
 #include "world/world.h"
 #include "boss/boss.h"
 #include "config.h"
+#include "ai/npc_planner.h"
+#include "sim/replay.h"
+#include "common/alloc_tracker.h"
+#include "common/profiler.h"
 #include <cmath>
 #include <algorithm>
 #include <string>
@@ -21,6 +26,7 @@
 #include <iomanip>
 #include <sstream>
 #include <exception>
+#include <cstring>
 
 namespace {
     std::string TimestampUtc()
@@ -52,12 +58,10 @@ namespace {
     }
 
     // Map grid coordinates from Game entities onto the 3D world coordinates for actors.
-    Vector3 GridToWorldPos(const World& world, const Vector2& gridPos) {
+    Vector3 GridToWorldPos(const World& world, GridPos gridPos) {
         auto idx = [](int x, int y) { return y * World::kTilesWide + x; };
-        int gx = static_cast<int>(std::round(gridPos.x));
-        int gy = static_cast<int>(std::round(gridPos.y));
-        gx = std::clamp(gx, 0, World::kTilesWide - 1);
-        gy = std::clamp(gy, 0, World::kTilesHigh - 1);
+        int gx = std::clamp(gridPos.x, 0, World::kTilesWide - 1);
+        int gy = std::clamp(gridPos.y, 0, World::kTilesHigh - 1);
 
         float baseY = ActorBaseHeight(world.tiles[idx(gx, gy)]); // align mech feet to slab surface
         float wx = (gx - World::kTilesWide * 0.5f + 0.5f) * World::kTileSize;
@@ -66,52 +70,66 @@ namespace {
     }
 
     void SyncWorldActorsFromGame(const Game& game, World& world) {
-        // Collect actors in render world
-        std::vector<WorldEntity*> worldPlayers;
-        std::vector<WorldEntity*> worldEnemies;
-        for (auto& we : world.entities) {
-            if (!we.isActor) continue;
-            if (we.isEnemy) {
-                worldEnemies.push_back(&we);
-            } else {
-                worldPlayers.push_back(&we);
-            }
-        }
-
-        // Collect actors in game state
-        std::vector<const Entity*> gamePlayers;
-        std::vector<const Entity*> gameEnemies;
-        for (const auto& e : game.entities) {
-            if (e.type == PLAYER) {
-                gamePlayers.push_back(&e);
-            } else if (e.type == ENEMY) {
-                gameEnemies.push_back(&e);
-            }
-        }
-
-        auto applyPositions = [&](const std::vector<const Entity*>& src, std::vector<WorldEntity*>& dst) {
-            size_t n = std::min(src.size(), dst.size());
-            for (size_t i = 0; i < n; ++i) {
-                Vector3 wpos = GridToWorldPos(world, src[i]->position);
-                dst[i]->targetPos = wpos;
-                dst[i]->startPos = wpos;
-                dst[i]->position = wpos;
+        // Pair the n-th game entity of a side with the n-th world actor of the
+        // same side. Walks both lists in place; this runs every frame, so it
+        // must not allocate.
+        auto applyPositions = [&](EntityType side, bool enemyActors) {
+            auto actor = world.entities.begin();
+            for (const auto& e : game.entities) {
+                if (e.type != side) continue;
+                while (actor != world.entities.end() && !(actor->isActor && actor->isEnemy == enemyActors)) ++actor;
+                if (actor == world.entities.end()) return;
+                Vector3 wpos = GridToWorldPos(world, e.position);
+                actor->targetPos = wpos;
+                actor->startPos = wpos;
+                actor->position = wpos;
+                ++actor;
             }
         };
 
-        applyPositions(gamePlayers, worldPlayers);
-        applyPositions(gameEnemies, worldEnemies);
+        applyPositions(PLAYER, false);
+        applyPositions(ENEMY, true);
     }
 }
 
-int main() {
+int main(int argc, char** argv) {
     std::string fatalMessage;
     bool fatal = false;
 
+    // --profile [FILE]: record CPU zones from startup and write a Chrome trace on exit.
+    // F4 starts and stops a capture at runtime; stopping writes the trace.
+    std::string tracePath = "profile_trace.json";
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--profile") != 0) continue;
+        if (i + 1 < argc && argv[i + 1][0] != '-') tracePath = argv[++i];
+        profilerStart();
+    }
+    profilerSetThreadName("main");
+    auto saveTrace = [&]() {
+        profilerStop();
+        std::string traceError;
+        if (profilerSaveChromeTrace(tracePath, &traceError)) {
+            TraceLog(LOG_INFO, "Wrote CPU profile to %s", tracePath.c_str());
+        } else {
+            TraceLog(LOG_WARNING, "Failed to save CPU profile: %s", traceError.c_str());
+        }
+    };
+
     try {
         // Load configuration from Lua file (falls back to defaults if missing/invalid)
         AppConfig config = AppConfig::LoadFromFile("vars.lua");
 
+        // Data-driven cards (optional) join the built-in table before any hand or deck is built
+        if (std::ifstream("cards.json").good()) {
+            std::string cardError;
+            int loaded = cardRegistry().loadFile("cards.json", &cardError);
+            if (loaded < 0) {
+                TraceLog(LOG_WARNING, "cards.json ignored: %s", cardError.c_str());
+            } else {
+                TraceLog(LOG_INFO, "Loaded %d card definitions from cards.json", loaded);
+            }
+        }
+
         // Create and initialize the platform context
         Platform platform = Platform::CreateRaylibPlatform();
         platform.window->Init(config.window_width, config.window_height, "vray ver1");
@@ -122,6 +140,23 @@ int main() {
         // Create Game State and Boss before AppContext
         Game game;
         init_game(game);
+        if (config.ai_search) {
+            game.npcPlanner = makeNpcPlanner(NpcPlannerKind::Search);
+        }
+        game.npcBudgetMs = config.ai_budget_ms;
+        allocTrackingSetEnabled(config.debug_alloc_tracking);
+
+        // Record every played turn so a session can be replayed headlessly (vray_sim --replay)
+        {
+            game.replay = std::make_shared<ReplayLog>();
+            GameState initial = take_state(game);
+            std::string replayError;
+            if (!beginReplay(*game.replay, initial, game.hand.cardList(), ReplayOrder::Simultaneous, 0, 0.5f, &replayError)) {
+                TraceLog(LOG_WARNING, "Replay recording disabled: %s", replayError.c_str());
+                game.replay.reset();
+            }
+            restore_state(game, std::move(initial));
+        }
 
         Boss boss;
         boss.begin(game);
@@ -136,6 +171,7 @@ int main() {
         };
 
         // Initialize 3D camera with config values
+        ctx.ui.showAllocOverlay = config.debug_alloc_tracking;
         initializeCameraWithConfig(ctx.camera, config);
         ctx.camera.projection = CAMERA_PERSPECTIVE;
 
@@ -149,18 +185,64 @@ int main() {
         float totalElapsedTime = 0.0f;
         DragState dragState;  // T_052: Drag state for card UI
         CardTooltip cardTooltip;  // T_058: Card tooltip state
+        FrameTimeHistory frameTimes;
 
         try {
             while (!platform.window->ShouldClose()) {
+                PROFILE_ZONE("frame");
                 float dt = GetFrameTime();
                 totalElapsedTime += dt;
+                allocFrameBegin();
+
+                // F4: start a CPU profile capture, or stop it and write the trace
+                if (platform.input->IsKeyPressed(KEY_F4)) {
+                    if (profilerRecording()) {
+                        saveTrace();
+                    } else {
+                        profilerStart();
+                    }
+                }
+
+                // Last frame's duration feeds the HUD graph; this frame's counters start over
+                ctx.stats.frameMs = dt * 1000.0f;
+                ctx.stats.allocs = allocLastFrame().total;
+                frameTimes.push(ctx.stats.frameMs);
+
+                // F2: performance HUD
+                if (platform.input->IsKeyPressed(KEY_F2)) ctx.ui.showPerfHud = !ctx.ui.showPerfHud;
+
+                // F3: allocation overlay; tracking runs only while it is shown
+                if (platform.input->IsKeyPressed(KEY_F3)) {
+                    ctx.ui.showAllocOverlay = !ctx.ui.showAllocOverlay;
+                    allocTrackingSetEnabled(ctx.ui.showAllocOverlay);
+                }
 
                 // --- Update ---
+                double updateStart = GetTime();
                 updateCameraWithConfig(ctx.camera, config);
-                update_game(game, dt);
-                World_Update(world, totalElapsedTime);
-                handle_input(game, platform);
-                SyncWorldActorsFromGame(game, world);
+                {
+                    PROFILE_ZONE("update_game");
+                    AllocScope scope("update_game");
+                    update_game(game, dt);
+                }
+                {
+                    PROFILE_ZONE("World_Update");
+                    AllocScope scope("World_Update");
+                    World_Update(world, totalElapsedTime);
+                }
+                {
+                    PROFILE_ZONE("handle_input");
+                    AllocScope scope("handle_input");
+                    handle_input(game, platform);
+                }
+                {
+                    PROFILE_ZONE("SyncWorldActorsFromGame");
+                    AllocScope scope("SyncWorldActorsFromGame");
+                    SyncWorldActorsFromGame(game, world);
+                }
+                ctx.stats.updateMs = static_cast<float>((GetTime() - updateStart) * 1000.0);
+                ctx.stats.gameEntities = static_cast<int>(game.entities.size());
+                ctx.stats.worldEntities = static_cast<int>(world.entities.size());
 
                 // Prepare card UI panel (drawn later in draw phase)
                 GameUIPanel uiLayout;
@@ -180,7 +262,11 @@ int main() {
 
                 // --- Draw ---
                 platform.window->BeginFrame();
-                Render_DrawFrame(ctx, world);
+                {
+                    PROFILE_ZONE("Render_DrawFrame");
+                    AllocScope scope("Render_DrawFrame");
+                    Render_DrawFrame(ctx, world);
+                }
 
                 // Determine phase for card UI rendering based on current state
                 const char* stateName = boss.getCurrentStateName();
@@ -192,7 +278,12 @@ int main() {
                 }
 
                 // Draw card UI and collect actions
-                draw_cardui(uiLayout, currentPhase, winW, winH, game, cardUiActions, dragState, cardTooltip);
+                double uiStart = GetTime();
+                {
+                    PROFILE_ZONE("draw_cardui");
+                    AllocScope scope("draw_cardui");
+                    draw_cardui(uiLayout, currentPhase, winW, winH, game, cardUiActions, dragState, cardTooltip);
+                }
 
                 // T_058: Draw tooltip on hover
                 CardTooltip_Draw(cardTooltip, game);
@@ -202,9 +293,25 @@ int main() {
 
                 // Update drag state AFTER drop logic
                 HandPanel_UpdateDrag(dragState);
+                ctx.stats.uiMs = static_cast<float>((GetTime() - uiStart) * 1000.0);
 
                 // Now let the boss state machine consume this frame's UI actions
-                boss.update(game, cardUiActions, dt);
+                {
+                    PROFILE_ZONE("boss.update");
+                    AllocScope scope("boss.update");
+                    double bossStart = GetTime();
+                    boss.update(game, cardUiActions, dt);
+                    ctx.stats.updateMs += static_cast<float>((GetTime() - bossStart) * 1000.0);
+                }
+
+                // HUD over everything else; the bare FPS counter when it is off
+                int overlayY = 32;
+                if (ctx.ui.showPerfHud) {
+                    overlayY = 10 + DrawPerfHud(ctx.stats, frameTimes, 10, 10) + 6;
+                } else {
+                    DrawFPS(10, 10);
+                }
+                if (ctx.ui.showAllocOverlay) DrawAllocOverlay(allocLastFrame(), 10, overlayY);
 
                 platform.window->EndFrame();
             }
@@ -217,6 +324,13 @@ int main() {
         }
 
         // Cleanup
+        if (profilerRecording()) saveTrace();
+        if (game.replay) {
+            std::string replayError;
+            if (!saveReplay(*game.replay, "last_replay.vrpl", &replayError)) {
+                TraceLog(LOG_WARNING, "Failed to save replay: %s", replayError.c_str());
+            }
+        }
         Render_Cleanup(ctx);
     } catch (const std::exception& ex) {
         fatal = true;
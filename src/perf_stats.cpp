@@ -0,0 +1,25 @@
+#include "perf_stats.h"
+#include <algorithm>
+#include <cmath>
+
+void FrameTimeHistory::push(float ms) {
+    samples_[next_] = ms;
+    next_ = (next_ + 1) % kCapacity;
+    count_ = std::min(count_ + 1, kCapacity);
+}
+
+float FrameTimeHistory::percentile(float p) const {
+    if (count_ == 0) return 0.0f;
+    std::array<float, kCapacity> sorted;
+    for (int i = 0; i < count_; ++i) sorted[i] = at(i);
+    int rank = static_cast<int>(std::ceil(std::clamp(p, 0.0f, 100.0f) / 100.0f * count_));
+    int index = std::clamp(rank - 1, 0, count_ - 1);
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.begin() + count_);
+    return sorted[index];
+}
+
+float FrameTimeHistory::max() const {
+    float worst = 0.0f;
+    for (int i = 0; i < count_; ++i) worst = std::max(worst, at(i));
+    return worst;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "raylib.h" // Model
+#include "common/alloc_tracker.h"
+#include <array>
+#include <cstdint>
+
+/**
+ * Per-frame counters shown by the performance HUD. Render code fills
+ * `render` while it draws; the main loop fills the phase timings and the
+ * simulation totals. Everything is plain data so filling it costs a few adds.
+ */
+struct RenderStats {
+    int drawCalls = 0;   // raylib issues one per mesh of a drawn model
+    int uniformSets = 0; // SetShaderValue calls
+    int modelsDrawn = 0;
+    int64_t triangles = 0;
+
+    // One DrawModel/DrawModelEx call.
+    void countModel(const Model& model) {
+        modelsDrawn++;
+        for (int i = 0; i < model.meshCount; ++i) {
+            drawCalls++;
+            triangles += model.meshes[i].triangleCount;
+        }
+    }
+    // A single draw that is not a model (fullscreen pass, gizmo).
+    void countDraw(int64_t tris) {
+        drawCalls++;
+        triangles += tris;
+    }
+};
+
+struct FrameStats {
+    // CPU milliseconds
+    float frameMs = 0.0f; // whole frame, including the wait for vsync
+    float updateMs = 0.0f; // game, world, input and boss state machine
+    float sceneMs = 0.0f;  // Render_DrawScene
+    float postMs = 0.0f;   // post passes and the final blit
+    float uiMs = 0.0f;     // card UI, tooltip and overlays
+
+    RenderStats render;
+    int gameEntities = 0;  // entities in the simulation
+    int worldEntities = 0; // render-side actors and props
+    AllocCounts allocs;    // last completed frame; zero while tracking is off
+};
+
+/**
+ * Rolling window of frame times for the HUD graph and percentiles. Fixed
+ * storage, so pushing and querying never allocate.
+ */
+class FrameTimeHistory {
+public:
+    static constexpr int kCapacity = 240;
+
+    void push(float ms);
+    int size() const { return count_; }
+    // i = 0 is the oldest sample still held.
+    float at(int i) const { return samples_[(next_ + kCapacity - count_ + i) % kCapacity]; }
+    // Nearest-rank percentile over the window, p in [0, 100]; 0 when empty.
+    float percentile(float p) const;
+    float max() const;
+
+private:
+    std::array<float, kCapacity> samples_{};
+    int next_ = 0;
+    int count_ = 0;
+};
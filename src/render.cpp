@@ -7,6 +7,7 @@
 #include "mesh.h"
 #include "world/world.h"
 #include "app.h"
+#include "common/profiler.h"
 
 // Detect faction from mech color
 static int GetFactionFromColor(Color c) {
@@ -125,21 +126,27 @@ void Render_HandleResize(AppContext& ctx, int width, int height) {
     ctx.targets.post = LoadRenderTexture(rtWidth, rtHeight);
 }
 
+// SetShaderValue, counted for the performance HUD
+static void SetUniform(RenderStats& stats, Shader shader, int loc, const void* value, int type) {
+    SetShaderValue(shader, loc, value, type);
+    stats.uniformSets++;
+}
+
 // Sets up shader uniforms like Light and Camera position
 static void ApplyGlobalUniforms(AppContext& ctx, const World& world) {
     float camPos[3] = { ctx.camera.position.x, ctx.camera.position.y, ctx.camera.position.z };
-    SetShaderValue(ctx.shaders.flat, ctx.shaders.flatViewPosLoc, camPos, SHADER_UNIFORM_VEC3);
+    SetUniform(ctx.stats.render, ctx.shaders.flat, ctx.shaders.flatViewPosLoc, camPos, SHADER_UNIFORM_VEC3);
 
     if (world.lightCount > 0) {
         const Light& mainLight = world.lights[world.activeLight];
         // Manually set lightPos for the flat shader
         float lightPos[3] = { mainLight.position.x, mainLight.position.y, mainLight.position.z };
-        SetShaderValue(ctx.shaders.flat, ctx.shaders.flatLightPosLoc, lightPos, SHADER_UNIFORM_VEC3);
+        SetUniform(ctx.stats.render, ctx.shaders.flat, ctx.shaders.flatLightPosLoc, lightPos, SHADER_UNIFORM_VEC3);
     }
 }
 
 // Draws a texture to a target (or screen) using a specific shader
-static void ApplyEffect(Shader shader, RenderTexture2D source, RenderTexture2D* destination, int width, int height) {
+static void ApplyEffect(RenderStats& stats, Shader shader, RenderTexture2D source, RenderTexture2D* destination, int width, int height) {
     if (destination) BeginTextureMode(*destination);
     
     BeginShaderMode(shader);
@@ -148,47 +155,52 @@ static void ApplyEffect(Shader shader, RenderTexture2D source, RenderTexture2D*
             Rectangle{0, 0, (float)width, (float)height},
             Vector2{0, 0}, 0.0f, WHITE);
     EndShaderMode();
+    stats.countDraw(2);
 
     if (destination) EndTextureMode();
 }
 
 // Simple copy pass without a shader (default pipeline)
-static void ApplyCopy(RenderTexture2D source, RenderTexture2D* destination, int width, int height) {
+static void ApplyCopy(RenderStats& stats, RenderTexture2D source, RenderTexture2D* destination, int width, int height) {
     if (destination) BeginTextureMode(*destination);
 
     DrawTexturePro(source.texture,
         Rectangle{0, 0, (float)source.texture.width, -(float)source.texture.height},
         Rectangle{0, 0, (float)width, (float)height},
         Vector2{0, 0}, 0.0f, WHITE);
+    stats.countDraw(2);
 
     if (destination) EndTextureMode();
 }
 
 static void Render_DrawScene(AppContext& app, const World& world) {
+    PROFILE_ZONE("Render_DrawScene");
     RenderTargets& targets = app.targets;
     RenderShaders& shaders = app.shaders;
+    RenderStats& stats = app.stats.render;
     BeginTextureMode(targets.scene);
         ClearBackground(RAYWHITE);
         BeginShaderMode(shaders.flat);
         BeginMode3D(app.camera);
             // Default palette off for non-actors
             int paletteEnabled = 0;
-            SetShaderValue(shaders.flat, shaders.flatPaletteEnabledLoc, &paletteEnabled, SHADER_UNIFORM_INT);
+            SetUniform(stats, shaders.flat, shaders.flatPaletteEnabledLoc, &paletteEnabled, SHADER_UNIFORM_INT);
             float paletteStrength = app.ui.paletteEnabled ? app.ui.paletteStrength : 0.0f;
-            SetShaderValue(shaders.flat, shaders.flatPaletteStrengthLoc, &paletteStrength, SHADER_UNIFORM_FLOAT);
+            SetUniform(stats, shaders.flat, shaders.flatPaletteStrengthLoc, &paletteStrength, SHADER_UNIFORM_FLOAT);
             // 1. Draw entities (Models use the flat shader assigned in World_Init)
             if (app.ui.showEntities) {
                 for (const auto& entity : world.entities) {
                     if (app.ui.paletteEnabled && entity.isActor) {
                         paletteEnabled = 1;
-                        SetShaderValue(shaders.flat, shaders.flatPaletteEnabledLoc, &paletteEnabled, SHADER_UNIFORM_INT);
+                        SetUniform(stats, shaders.flat, shaders.flatPaletteEnabledLoc, &paletteEnabled, SHADER_UNIFORM_INT);
                         int paletteIdx = GetFactionFromColor(entity.color);
-                        SetShaderValue(shaders.flat, shaders.flatPaletteIndexLoc, &paletteIdx, SHADER_UNIFORM_INT);
+                        SetUniform(stats, shaders.flat, shaders.flatPaletteIndexLoc, &paletteIdx, SHADER_UNIFORM_INT);
                     } else {
                         paletteEnabled = 0;
-                        SetShaderValue(shaders.flat, shaders.flatPaletteEnabledLoc, &paletteEnabled, SHADER_UNIFORM_INT);
+                        SetUniform(stats, shaders.flat, shaders.flatPaletteEnabledLoc, &paletteEnabled, SHADER_UNIFORM_INT);
                     }
                     DrawModel(entity.model, entity.position, entity.scale.x, entity.color);
+                    stats.countModel(entity.model);
                 }
             }
 
@@ -196,8 +208,8 @@ static void Render_DrawScene(AppContext& app, const World& world) {
             if (app.ui.showEnvironment) {
                 // Ensure palette is off for ground/props
                 paletteEnabled = 0;
-                SetShaderValue(shaders.flat, shaders.flatPaletteEnabledLoc, &paletteEnabled, SHADER_UNIFORM_INT);
-                World_DrawGround(world, app);
+                SetUniform(stats, shaders.flat, shaders.flatPaletteEnabledLoc, &paletteEnabled, SHADER_UNIFORM_INT);
+                World_DrawGround(world, app, &stats);
             }
 
             // 3. Draw Light Indicator (The Toggle)
@@ -208,6 +220,7 @@ static void Render_DrawScene(AppContext& app, const World& world) {
                 // Draw sphere without the flat shader so it glows in the bloom pass.
                 EndShaderMode();
                 DrawSphere(lightPos, 0.25f, lightCol);
+                stats.countDraw(18 * 16 * 2); // DrawSphere: 16 rings (+2 caps) x 16 slices
                 BeginShaderMode(shaders.flat);
             }
         EndMode3D();
@@ -216,11 +229,19 @@ static void Render_DrawScene(AppContext& app, const World& world) {
 }
 
 void Render_DrawFrame(AppContext& ctx, World& world) {
+    ctx.stats.render = RenderStats{};
+    double sceneStart = GetTime();
+
     // --- STEP 1: PREPARE SHADERS ---
-    ApplyGlobalUniforms(ctx, world);
+    {
+        PROFILE_ZONE("ApplyGlobalUniforms");
+        ApplyGlobalUniforms(ctx, world);
+    }
 
     // --- STEP 2: SCENE PASS (3D Geometry) ---
     Render_DrawScene(ctx, world);
+    double postStart = GetTime();
+    ctx.stats.sceneMs = static_cast<float>((postStart - sceneStart) * 1000.0);
 
     // --- STEP 3: POST-PROCESS PASS (2D Effects) ---
     RenderTexture2D* src = &ctx.targets.scene;
@@ -228,12 +249,14 @@ void Render_DrawFrame(AppContext& ctx, World& world) {
 
     // Pass A: Bloom (Scene -> Post)
     if (ctx.ui.bloomEnabled) {
-        SetShaderValue(ctx.shaders.bloom, GetShaderLocation(ctx.shaders.bloom, "intensity"), &ctx.ui.bloomIntensity, SHADER_UNIFORM_FLOAT);
-        ApplyEffect(ctx.shaders.bloom, *src, dst, ctx.targets.width, ctx.targets.height);
+        PROFILE_ZONE("post.bloom");
+        SetUniform(ctx.stats.render, ctx.shaders.bloom, GetShaderLocation(ctx.shaders.bloom, "intensity"), &ctx.ui.bloomIntensity, SHADER_UNIFORM_FLOAT);
+        ApplyEffect(ctx.stats.render, ctx.shaders.bloom, *src, dst, ctx.targets.width, ctx.targets.height);
         src = dst;
         dst = &ctx.targets.scene; // ping-pong for subsequent passes
     } else {
-        ApplyCopy(*src, dst, ctx.targets.width, ctx.targets.height);
+        PROFILE_ZONE("post.copy");
+        ApplyCopy(ctx.stats.render, *src, dst, ctx.targets.width, ctx.targets.height);
         src = dst;
         dst = &ctx.targets.scene;
     }
@@ -243,12 +266,14 @@ void Render_DrawFrame(AppContext& ctx, World& world) {
     ClearBackground(BLACK);
     
     if (ctx.ui.pastelEnabled) {
-        SetShaderValue(ctx.shaders.pastel, GetShaderLocation(ctx.shaders.pastel, "intensity"), &ctx.ui.pastelIntensity, SHADER_UNIFORM_FLOAT);
-        ApplyEffect(ctx.shaders.pastel, *src, nullptr, ctx.window->GetWidth(), ctx.window->GetHeight());
+        PROFILE_ZONE("post.pastel");
+        SetUniform(ctx.stats.render, ctx.shaders.pastel, GetShaderLocation(ctx.shaders.pastel, "intensity"), &ctx.ui.pastelIntensity, SHADER_UNIFORM_FLOAT);
+        ApplyEffect(ctx.stats.render, ctx.shaders.pastel, *src, nullptr, ctx.window->GetWidth(), ctx.window->GetHeight());
     } else {
-        ApplyCopy(*src, nullptr, ctx.window->GetWidth(), ctx.window->GetHeight());
+        PROFILE_ZONE("post.present");
+        ApplyCopy(ctx.stats.render, *src, nullptr, ctx.window->GetWidth(), ctx.window->GetHeight());
     }
 
-    // Draw UI/HUD here (UI_Draw will overlay afterward)
-    DrawFPS(10, 10);
+    ctx.stats.postMs = static_cast<float>((GetTime() - postStart) * 1000.0);
+    // The FPS counter / performance HUD is drawn by the caller, over the UI.
 }
\ No newline at end of file
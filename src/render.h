@@ -10,7 +10,7 @@ void Render_Init(AppContext& ctx);
 // Recreate render targets for a resize or scale change
 void Render_HandleResize(AppContext& ctx, int width, int height);
 
-// Draw one full frame (3D scene + post + HUD)
+// Draw one full frame (3D scene + post); fills ctx.stats render counters and timings
 void Render_DrawFrame(AppContext& ctx, World& world);
 
 // Free GPU resources
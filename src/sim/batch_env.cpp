@@ -0,0 +1,234 @@
+#include "batch_env.h"
+#include "zobrist.h"
+#include <algorithm>
+#include <limits>
+
+BatchEnv::BatchEnv(size_t games, const std::vector<Card>& hand, BatchEnvConfig config) : config_(config) {
+    for (const Card& c : hand) {
+        if (findCard(c.id)) continue; // first copy wins, as in the scalar lookup
+        CompiledCard card;
+        card.id = c.id;
+        const CardMoves moves = cardMoves(c.effect, c.mirroredEffect);
+        for (int mirror = 0; mirror < 2; ++mirror) {
+            const CardEffect& effect = mirror ? c.mirroredEffect : c.effect;
+            CompiledEffect& out = card.effects[mirror];
+            out.type = effect.type;
+            out.amount = effect.type == CardType::Damage ? effect.damage : effect.heal;
+            out.targetId = effect.targetEntityId;
+            for (int f = 0; f < 4; ++f) out.steps[f] = moves.at(static_cast<Facing>(f), mirror == 1);
+        }
+        hand_.push_back(card);
+    }
+
+    size_t slots = games * kMaxEntities;
+    id_.assign(slots, -1);
+    team_.assign(slots, OBJECT);
+    x_.assign(slots, 0);
+    y_.assign(slots, 0);
+    facing_.assign(slots, 0);
+    health_.assign(slots, 0);
+    name_.assign(slots, std::string());
+
+    count_.assign(games, 0);
+    turn_.assign(games, 0);
+    startTurn_.assign(games, 0);
+    done_.assign(games, 1); // empty until reset
+    balance_.assign(games, 0);
+}
+
+const BatchEnv::CompiledCard* BatchEnv::findCard(int cardId) const {
+    for (const CompiledCard& c : hand_) {
+        if (c.id == cardId) return &c;
+    }
+    return nullptr;
+}
+
+bool BatchEnv::reset(size_t game, const GameState& state, std::string* error) {
+    if (state.entities.size() > static_cast<size_t>(kMaxEntities)) {
+        if (error) *error = "Too many entities for a batch game (max " + std::to_string(kMaxEntities) + ")";
+        return false;
+    }
+    constexpr int lo = std::numeric_limits<int8_t>::min();
+    constexpr int hi = std::numeric_limits<int8_t>::max();
+    for (const Entity& e : state.entities) {
+        if (e.position.x < lo || e.position.x > hi || e.position.y < lo || e.position.y > hi) {
+            if (error) *error = "Entity position outside int8 range";
+            return false;
+        }
+    }
+
+    size_t base = game * kMaxEntities;
+    for (int s = 0; s < kMaxEntities; ++s) {
+        size_t i = base + s;
+        if (static_cast<size_t>(s) < state.entities.size()) {
+            const Entity& e = state.entities[s];
+            id_[i] = e.id;
+            team_[i] = static_cast<uint8_t>(e.type);
+            x_[i] = static_cast<int8_t>(e.position.x);
+            y_[i] = static_cast<int8_t>(e.position.y);
+            facing_[i] = static_cast<uint8_t>(static_cast<int>(e.facing) & 3);
+            health_[i] = e.health;
+            name_[i] = e.name;
+        } else {
+            id_[i] = -1;
+            name_[i].clear();
+        }
+    }
+    count_[game] = static_cast<uint8_t>(state.entities.size());
+    turn_[game] = 0;
+    startTurn_[game] = state.currentTurn;
+    done_[game] = finished(game) ? 1 : 0;
+    return true;
+}
+
+bool BatchEnv::resetAll(const GameState& state, std::string* error) {
+    for (size_t g = 0; g < size(); ++g) {
+        if (!reset(g, state, error)) return false;
+    }
+    return true;
+}
+
+void BatchEnv::resolve(size_t game, const PlanAssignment& assignment) {
+    const CompiledCard* card = findCard(assignment.cardId);
+    if (!card) return;
+    const CompiledEffect& effect = card->effects[assignment.useMirror ? 1 : 0];
+
+    const size_t base = game * kMaxEntities;
+    const int n = count_[game];
+    const int targetId = effect.type == CardType::Damage ? effect.targetId : assignment.mechId;
+    int slot = -1;
+    for (int s = 0; s < n; ++s) {
+        if (id_[base + s] == targetId) {
+            slot = s;
+            break;
+        }
+    }
+    if (slot < 0) return;
+    const size_t i = base + slot;
+
+    switch (effect.type) {
+    case CardType::Move: {
+        const CellDelta step = effect.steps[facing_[i]];
+        int toX = 0;
+        int toY = 0;
+        if (x_[i] >= 0 && x_[i] < Grid::SIZE && y_[i] >= 0 && y_[i] < Grid::SIZE) {
+            int from = Grid::cellIndex(x_[i], y_[i]);
+            int to = Grid::clampedDestination(from, step);
+            if (to == from) return;
+            toX = to % Grid::SIZE;
+            toY = to / Grid::SIZE;
+        } else {
+            toX = std::clamp(x_[i] + step.dx, 0, Grid::SIZE - 1);
+            toY = std::clamp(y_[i] + step.dy, 0, Grid::SIZE - 1);
+        }
+        // applyCard rebuilds occupancy from the entities, so any entity on the
+        // destination blocks. Off-board entities never match an on-board cell.
+        bool blocked = false;
+        for (int s = 0; s < n; ++s) {
+            blocked |= (x_[base + s] == toX) & (y_[base + s] == toY);
+        }
+        if (blocked) return;
+        x_[i] = static_cast<int8_t>(toX);
+        y_[i] = static_cast<int8_t>(toY);
+        break;
+    }
+    case CardType::Damage:
+        health_[i] = applyHealthChange(health_[i], -effect.amount);
+        break;
+    case CardType::Heal:
+        health_[i] = applyHealthChange(health_[i], effect.amount);
+        break;
+    }
+}
+
+void BatchEnv::playSide(std::span<const TurnPlan> plans) {
+    const size_t games = std::min(size(), plans.size());
+    size_t longest = 0;
+    for (size_t g = 0; g < games; ++g) longest = std::max(longest, plans[g].assignments.size());
+
+    for (size_t k = 0; k < longest; ++k) {
+        for (size_t g = 0; g < games; ++g) {
+            const auto& assignments = plans[g].assignments;
+            if (done_[g] || k >= assignments.size()) continue;
+            resolve(g, assignments[k]);
+        }
+    }
+}
+
+int BatchEnv::healthBalance(size_t game) const {
+    const size_t base = game * kMaxEntities;
+    int balance = 0;
+    for (int s = 0; s < count_[game]; ++s) {
+        int sign = team_[base + s] == PLAYER ? 1 : (team_[base + s] == ENEMY ? -1 : 0);
+        balance += sign * health_[base + s];
+    }
+    return balance;
+}
+
+bool BatchEnv::finished(size_t game) const {
+    const size_t base = game * kMaxEntities;
+    bool playerAlive = false;
+    bool enemyAlive = false;
+    for (int s = 0; s < count_[game]; ++s) {
+        bool alive = health_[base + s] > 0;
+        playerAlive |= alive && team_[base + s] == PLAYER;
+        enemyAlive |= alive && team_[base + s] == ENEMY;
+    }
+    return !playerAlive || !enemyAlive || turn_[game] >= config_.maxTurns;
+}
+
+void BatchEnv::step(std::span<const TurnPlan> player, std::span<const TurnPlan> npc,
+                    std::span<float> rewards, std::span<uint8_t> done) {
+    for (size_t g = 0; g < size(); ++g) balance_[g] = healthBalance(g);
+
+    playSide(player);
+    playSide(npc);
+
+    for (size_t g = 0; g < size(); ++g) {
+        float reward = 0.0f;
+        if (!done_[g]) {
+            reward = static_cast<float>(healthBalance(g) - balance_[g]) / 100.0f;
+            turn_[g]++;
+            done_[g] = finished(g) ? 1 : 0;
+        }
+        if (g < rewards.size()) rewards[g] = reward;
+        if (g < done.size()) done[g] = done_[g];
+    }
+}
+
+void BatchEnv::observe(std::span<float> out) const {
+    const float cellScale = 1.0f / (Grid::SIZE - 1);
+    const float turnScale = config_.maxTurns > 0 ? 1.0f / config_.maxTurns : 0.0f;
+    for (size_t g = 0; g < size() && (g + 1) * kObservationSize <= out.size(); ++g) {
+        float* obs = out.data() + g * kObservationSize;
+        std::fill(obs, obs + kObservationSize, 0.0f);
+        const size_t base = g * kMaxEntities;
+        for (int s = 0; s < count_[g]; ++s) {
+            const size_t i = base + s;
+            float* f = obs + s * kSlotFeatures;
+            f[0] = 1.0f;
+            f[1 + team_[i]] = 1.0f;
+            f[4] = x_[i] * cellScale;
+            f[5] = y_[i] * cellScale;
+            f[6 + facing_[i]] = 1.0f;
+            f[10] = health_[i] / 100.0f;
+        }
+        obs[kObservationSize - 1] = turn_[g] * turnScale;
+    }
+}
+
+void BatchEnv::exportState(size_t game, GameState& out) const {
+    out = GameState{};
+    const size_t base = game * kMaxEntities;
+    out.entities.reserve(count_[game]);
+    for (int s = 0; s < count_[game]; ++s) {
+        const size_t i = base + s;
+        Entity e{id_[i], static_cast<EntityType>(team_[i]), {x_[i], y_[i]}, name_[i]};
+        e.health = health_[i];
+        e.facing = static_cast<Facing>(facing_[i]);
+        out.entities.push_back(std::move(e));
+    }
+    out.currentTurn = startTurn_[game] + turn_[game];
+    out.grid.syncOccupancy(out.entities);
+    out.hash = zobristHash(out);
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include "card.h"
+
+struct BatchEnvConfig {
+    int maxTurns = 30; // a game is done after this many steps
+};
+
+/**
+ * Many independent games stepped in lockstep, for training and evaluating
+ * policies.
+ *
+ * Games are stored as structure-of-arrays. Each game owns kMaxEntities slots,
+ * and slot s of game g lives at index g * kMaxEntities + s in every per-slot
+ * array (ids, teams, cells, facings, health). Stepping never allocates.
+ *
+ * One step plays the player plan and then the npc plan of every game, like a
+ * PlayerFirst replay turn. Each assignment resolves exactly as applyCard would
+ * on the same state:
+ *   - damage targets the effect's entity, moves and heals the assignment's mech
+ *   - a move lands on the clamped cell unless any entity already stands there
+ *   - health floors at 0 and heals cap at 100
+ *   - assignments naming a card missing from the hand or an unknown mech do nothing
+ * Assignments run in lockstep across games (assignment k of every game, then
+ * k + 1), which keeps each game's own order.
+ *
+ * Rewards are from the player side: the change in (player health - enemy
+ * health) over the step, in units of 100 health. A game is done once either
+ * side has no living mech or maxTurns steps were played. Done games ignore
+ * their plans until they are reset.
+ */
+class BatchEnv {
+public:
+    static constexpr int kMaxEntities = 8;
+    // Per slot: present, team one-hot (3), x, y (0..1), facing one-hot (4), health (0..1).
+    static constexpr int kSlotFeatures = 11;
+    // Every slot, then turn / maxTurns.
+    static constexpr int kObservationSize = kMaxEntities * kSlotFeatures + 1;
+
+    BatchEnv(size_t games, const std::vector<Card>& hand, BatchEnvConfig config = {});
+
+    size_t size() const { return count_.size(); }
+
+    // Load one game from a scalar state. Fails, leaving the game unchanged,
+    // when the state has more than kMaxEntities entities or a position outside
+    // the int8 range.
+    bool reset(size_t game, const GameState& state, std::string* error = nullptr);
+    bool resetAll(const GameState& state, std::string* error = nullptr);
+
+    // Play one turn of every game. player and npc hold one plan per game.
+    // rewards and done, when non-empty, receive one value per game.
+    void step(std::span<const TurnPlan> player, std::span<const TurnPlan> npc,
+              std::span<float> rewards = {}, std::span<uint8_t> done = {});
+
+    // Writes size() * kObservationSize floats, one tensor per game.
+    void observe(std::span<float> out) const;
+
+    bool done(size_t game) const { return done_[game] != 0; }
+    int turn(size_t game) const { return turn_[game]; }
+
+    // Rebuild game as a scalar state (occupancy synced, hash seeded). Grid cell
+    // types are not part of a batch game and come back empty.
+    void exportState(size_t game, GameState& out) const;
+
+private:
+    struct CompiledEffect {
+        CardType type = CardType::Move;
+        int amount = 0;   // damage or heal
+        int targetId = -1; // damage target
+        std::array<CellDelta, 4> steps{}; // by facing
+    };
+    struct CompiledCard {
+        int id = -1;
+        CompiledEffect effects[2]; // [useMirror]
+    };
+
+    const CompiledCard* findCard(int cardId) const;
+    void resolve(size_t game, const PlanAssignment& assignment);
+    void playSide(std::span<const TurnPlan> plans);
+    int healthBalance(size_t game) const;
+    bool finished(size_t game) const;
+
+    BatchEnvConfig config_;
+    std::vector<CompiledCard> hand_;
+
+    // Per slot.
+    std::vector<int32_t> id_;
+    std::vector<uint8_t> team_;
+    std::vector<int8_t> x_;
+    std::vector<int8_t> y_;
+    std::vector<uint8_t> facing_;
+    std::vector<int32_t> health_;
+    std::vector<std::string> name_; // only read by exportState
+
+    // Per game.
+    std::vector<uint8_t> count_;
+    std::vector<int32_t> turn_;
+    std::vector<int32_t> startTurn_;
+    std::vector<uint8_t> done_;
+    std::vector<int32_t> balance_; // healthBalance before the current step
+};
@@ -0,0 +1,194 @@
+#include "match_runner.h"
+#include "game.h"
+#include "common/jobsystem.h"
+#include "common/profiler.h"
+#include "replay.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace {
+
+uint32_t mixSeed(uint64_t x) {
+    // splitmix64 finaliser; keeps neighbouring match/turn seeds uncorrelated
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return static_cast<uint32_t>(x ^ (x >> 31));
+}
+
+// Card ids for the strike and repair cards added to the starter hand.
+constexpr int kPlayerStrikeIdBase = 100; // + target slot; aimed at enemy mechs
+constexpr int kEnemyStrikeIdBase = 110;  // aimed at player mechs
+constexpr int kRepairCardId = 120;
+constexpr int kStrikeDamage = 25;
+constexpr int kRepairHeal = 15;
+
+Card effectCard(int id, std::string name, const CardEffect& effect) {
+    Card c;
+    c.id = id;
+    c.name = std::move(name);
+    c.type = effect.type;
+    c.effect = effect;
+    c.mirroredEffect = mirrorEffect(effect);
+    return c;
+}
+
+// One hand per side: the starter moves, a strike at each opposing mech and a
+// repair. handCards receives every card once, for resolution and replays.
+void buildSideHands(const Game& game, Hand& playerHand, Hand& enemyHand, std::vector<Card>& handCards) {
+    handCards = game.hand.cardList();
+    playerHand = game.hand;
+    enemyHand = game.hand;
+
+    int playerStrikes = 0;
+    int enemyStrikes = 0;
+    for (const auto& e : game.entities) {
+        if (e.type == OBJECT) continue;
+        CardEffect strike;
+        strike.type = CardType::Damage;
+        strike.targetEntityId = e.id;
+        strike.damage = kStrikeDamage;
+        bool playerTarget = e.type == PLAYER;
+        int id = playerTarget ? kEnemyStrikeIdBase + enemyStrikes++ : kPlayerStrikeIdBase + playerStrikes++;
+        handCards.push_back(effectCard(id, "Strike " + e.name, strike));
+        (playerTarget ? enemyHand : playerHand).addCard(handCards.back());
+    }
+
+    CardEffect repair;
+    repair.type = CardType::Heal;
+    repair.heal = kRepairHeal;
+    handCards.push_back(effectCard(kRepairCardId, "Repair", repair));
+    playerHand.addCard(handCards.back());
+    enemyHand.addCard(handCards.back());
+}
+
+int sideHealth(const EntityList& entities, EntityType side) {
+    int total = 0;
+    for (const auto& e : entities) {
+        if (e.type == side) total += e.health;
+    }
+    return total;
+}
+
+void collectMechIds(const EntityList& entities, EntityType side, std::vector<int>& out) {
+    out.clear();
+    for (const auto& e : entities) {
+        if (e.type == side && e.health > 0) out.push_back(e.id);
+    }
+}
+
+// Padded so per-lane counters never share a cache line.
+struct alignas(64) LaneStats {
+    SimStats stats;
+};
+
+} // namespace
+
+void SimStats::merge(const SimStats& other) {
+    matches += other.matches;
+    turns += other.turns;
+    playerWins += other.playerWins;
+    enemyWins += other.enemyWins;
+    draws += other.draws;
+}
+
+uint32_t matchSeed(uint32_t baseSeed, int matchIndex) {
+    return mixSeed((static_cast<uint64_t>(baseSeed) << 32) | static_cast<uint32_t>(matchIndex));
+}
+
+MatchResult runMatch(const MatchConfig& config, uint32_t seed, ReplayLog* record) {
+    PROFILE_ZONE("runMatch");
+    Game game;
+    init_game(game);
+
+    MatchResult result;
+    std::vector<int> playerMechs;
+    std::vector<int> enemyMechs;
+    playerMechs.reserve(3);
+    enemyMechs.reserve(3);
+
+    Hand playerHand;
+    Hand enemyHand;
+    std::vector<Card> handCards;
+    buildSideHands(game, playerHand, enemyHand, handCards);
+
+    GameState state = take_state(game);
+    const ReplayOrder order = config.simultaneous ? ReplayOrder::Simultaneous : ReplayOrder::PlayerFirst;
+    if (record) {
+        beginReplay(*record, state, handCards, order, seed, config.mirrorChance);
+    }
+    for (int turn = 0; turn < config.maxTurns; ++turn) {
+        collectMechIds(state.entities, PLAYER, playerMechs);
+        collectMechIds(state.entities, ENEMY, enemyMechs);
+        if (playerMechs.empty() || enemyMechs.empty()) break;
+
+        uint64_t turnKey = (static_cast<uint64_t>(seed) << 32) | static_cast<uint32_t>(turn * 2);
+        playerHand.resetUsage();
+        TurnPlan playerPlan = buildRandomPlan(playerMechs, playerHand, mixSeed(turnKey), config.mirrorChance);
+        enemyHand.resetUsage();
+        TurnPlan enemyPlan = buildRandomPlan(enemyMechs, enemyHand, mixSeed(turnKey + 1), config.mirrorChance);
+
+        resolveReplayTurn(state, handCards, playerPlan, enemyPlan, order);
+        if (record) {
+            recordReplayTurn(*record, playerPlan, enemyPlan, state);
+        }
+        result.turns++;
+    }
+
+    result.playerHealth = sideHealth(state.entities, PLAYER);
+    result.enemyHealth = sideHealth(state.entities, ENEMY);
+    if (result.playerHealth > result.enemyHealth) {
+        result.outcome = MatchOutcome::PlayerWin;
+    } else if (result.enemyHealth > result.playerHealth) {
+        result.outcome = MatchOutcome::EnemyWin;
+    }
+    restore_state(game, std::move(state));
+    return result;
+}
+
+SimStats runMatches(const MatchConfig& config) {
+    JobSystem& jobs = jobSystem();
+    int lanes = config.threadCount > 0 ? config.threadCount : jobs.threadCount();
+    lanes = std::max(1, std::min(lanes, std::max(1, config.matchCount)));
+
+    std::vector<LaneStats> perLane(lanes);
+    std::atomic<int> nextMatch{0};
+    constexpr int kBatch = 64; // matches claimed per atomic increment
+
+    auto lane = [&](int laneIndex) {
+        SimStats& local = perLane[laneIndex].stats;
+        for (;;) {
+            int begin = nextMatch.fetch_add(kBatch, std::memory_order_relaxed);
+            if (begin >= config.matchCount) break;
+            int end = std::min(begin + kBatch, config.matchCount);
+            for (int i = begin; i < end; ++i) {
+                MatchResult r = runMatch(config, matchSeed(config.baseSeed, i));
+                local.matches++;
+                local.turns += r.turns;
+                switch (r.outcome) {
+                case MatchOutcome::PlayerWin: local.playerWins++; break;
+                case MatchOutcome::EnemyWin: local.enemyWins++; break;
+                case MatchOutcome::Draw: local.draws++; break;
+                }
+            }
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    // One job per lane; lanes pull batches, so a slow lane never strands work.
+    jobs.parallelFor(0, lanes, 1, [&](int begin, int end) {
+        for (int l = begin; l < end; ++l) lane(l);
+    });
+    auto end = std::chrono::steady_clock::now();
+
+    SimStats total;
+    for (const auto& w : perLane) {
+        total.merge(w.stats);
+    }
+    total.threads = lanes;
+    total.seconds = std::chrono::duration<double>(end - start).count();
+    return total;
+}
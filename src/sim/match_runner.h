@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+
+struct ReplayLog;
+
+/**
+ * Headless AI-vs-AI match runner (G_008).
+ *
+ * Each match seeds a fresh Game via init_game and has both sides play
+ * buildRandomPlan turns until one side is wiped out or maxTurns is reached.
+ * Each side plays from its own hand: the starter moves, a 25-damage strike at
+ * each opposing mech and a 15-point repair, so health actually changes. The
+ * side with more total health at the end wins; equal totals are a draw.
+ * No window and no logging on the hot path.
+ */
+struct MatchConfig {
+    int matchCount = 1000;
+    int maxTurns = 30;
+    uint32_t baseSeed = 1;
+    float mirrorChance = 0.5f;
+    int threadCount = 0; // parallel lanes on the shared job pool; 0 = one per pool thread
+    bool simultaneous = false; // resolve each subphase's pair of cards together instead of player first
+};
+
+enum class MatchOutcome {
+    PlayerWin,
+    EnemyWin,
+    Draw
+};
+
+struct MatchResult {
+    MatchOutcome outcome = MatchOutcome::Draw;
+    int turns = 0;
+    int playerHealth = 0;
+    int enemyHealth = 0;
+};
+
+struct SimStats {
+    int64_t matches = 0;
+    int64_t turns = 0;
+    int64_t playerWins = 0;
+    int64_t enemyWins = 0;
+    int64_t draws = 0;
+    int threads = 0;
+    double seconds = 0.0;
+
+    double matchesPerSecond() const { return seconds > 0.0 ? matches / seconds : 0.0; }
+    double turnsPerSecond() const { return seconds > 0.0 ? turns / seconds : 0.0; }
+    void merge(const SimStats& other);
+};
+
+// Deterministic per-match seed derived from the batch seed and match index.
+uint32_t matchSeed(uint32_t baseSeed, int matchIndex);
+
+// Play one full match on the calling thread. When record is given the match is
+// written to it as a PlayerFirst (or Simultaneous) replay.
+MatchResult runMatch(const MatchConfig& config, uint32_t seed, ReplayLog* record = nullptr);
+
+// Play config.matchCount matches spread across the shared job pool.
+SimStats runMatches(const MatchConfig& config);
@@ -0,0 +1,362 @@
+#include "replay.h"
+#include "subphase.h"
+#include "zobrist.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+namespace {
+
+bool fail(std::string* error, const char* msg) {
+    if (error) *error = msg;
+    return false;
+}
+
+template <typename T>
+bool fitsIn(int v) {
+    return v >= std::numeric_limits<T>::min() && v <= std::numeric_limits<T>::max();
+}
+
+const Card* findHandCard(const std::vector<Card>& hand, int cardId) {
+    for (const auto& c : hand) {
+        if (c.id == cardId) return &c;
+    }
+    return nullptr;
+}
+
+void applyAssignment(GameState& state, const std::vector<Card>& hand, const PlanAssignment& a) {
+    if (const Card* card = findHandCard(hand, a.cardId)) {
+        resolveCard(state, *card, a.mechId, a.useMirror);
+    }
+}
+
+struct ByteWriter {
+    std::vector<uint8_t>& out;
+
+    void u8(uint8_t v) { out.push_back(v); }
+    void u16(uint16_t v) {
+        u8(static_cast<uint8_t>(v));
+        u8(static_cast<uint8_t>(v >> 8));
+    }
+    void u32(uint32_t v) {
+        u16(static_cast<uint16_t>(v));
+        u16(static_cast<uint16_t>(v >> 16));
+    }
+    void u64(uint64_t v) {
+        u32(static_cast<uint32_t>(v));
+        u32(static_cast<uint32_t>(v >> 32));
+    }
+    void i8(int v) { u8(static_cast<uint8_t>(static_cast<int8_t>(v))); }
+    void i16(int v) { u16(static_cast<uint16_t>(static_cast<int16_t>(v))); }
+    void f32(float v) {
+        uint32_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        u32(bits);
+    }
+    // Callers check s.size() <= 255 first.
+    void str(const std::string& s) {
+        u8(static_cast<uint8_t>(s.size()));
+        out.insert(out.end(), s.begin(), s.end());
+    }
+};
+
+// Bounds-checked reader; once a read runs past the end every later read returns 0 and ok stays false.
+struct ByteReader {
+    const uint8_t* data;
+    size_t size;
+    size_t pos = 0;
+    bool ok = true;
+
+    uint8_t u8() {
+        if (pos >= size) {
+            ok = false;
+            return 0;
+        }
+        return data[pos++];
+    }
+    uint16_t u16() {
+        uint16_t lo = u8();
+        return static_cast<uint16_t>(lo | (u8() << 8));
+    }
+    uint32_t u32() {
+        uint32_t lo = u16();
+        return lo | (static_cast<uint32_t>(u16()) << 16);
+    }
+    uint64_t u64() {
+        uint64_t lo = u32();
+        return lo | (static_cast<uint64_t>(u32()) << 32);
+    }
+    int i8() { return static_cast<int8_t>(u8()); }
+    int i16() { return static_cast<int16_t>(u16()); }
+    float f32() {
+        uint32_t bits = u32();
+        float v;
+        std::memcpy(&v, &bits, sizeof(v));
+        return v;
+    }
+    std::string str() {
+        size_t n = u8();
+        if (size - pos < n) {
+            ok = false;
+            pos = size;
+            return {};
+        }
+        std::string s(reinterpret_cast<const char*>(data + pos), n);
+        pos += n;
+        return s;
+    }
+};
+
+bool writeEffect(ByteWriter& w, const CardEffect& e, std::string* error) {
+    if (!fitsIn<int8_t>(e.move.forward) || !fitsIn<int8_t>(e.move.lateral)) {
+        return fail(error, "Card move out of range");
+    }
+    if (!fitsIn<int16_t>(e.targetEntityId) || !fitsIn<int16_t>(e.damage) || !fitsIn<int16_t>(e.heal)) {
+        return fail(error, "Card effect value out of range");
+    }
+    w.u8(static_cast<uint8_t>(e.type));
+    w.i8(e.move.forward);
+    w.i8(e.move.lateral);
+    w.i16(e.targetEntityId);
+    w.i16(e.damage);
+    w.i16(e.heal);
+    return true;
+}
+
+bool validCardType(uint8_t type) {
+    return type <= static_cast<uint8_t>(CardType::Heal);
+}
+
+bool readEffect(ByteReader& r, CardEffect& e) {
+    uint8_t type = r.u8();
+    e.type = static_cast<CardType>(type);
+    e.move.forward = r.i8();
+    e.move.lateral = r.i8();
+    e.targetEntityId = r.i16();
+    e.damage = r.i16();
+    e.heal = r.i16();
+    return validCardType(type);
+}
+
+bool writePlan(ByteWriter& w, const TurnPlan& plan, std::string* error) {
+    if (plan.assignments.size() > 255) return fail(error, "Too many plan assignments");
+    w.u8(static_cast<uint8_t>(plan.assignments.size()));
+    for (const auto& a : plan.assignments) {
+        if (!fitsIn<int16_t>(a.mechId) || !fitsIn<int16_t>(a.cardId)) {
+            return fail(error, "Plan id out of range");
+        }
+        w.i16(a.mechId);
+        w.i16(a.cardId);
+        w.u8(a.useMirror ? 1 : 0);
+    }
+    return true;
+}
+
+void readPlan(ByteReader& r, TurnPlan& plan) {
+    plan.assignments.resize(r.u8());
+    for (auto& a : plan.assignments) {
+        a.mechId = r.i16();
+        a.cardId = r.i16();
+        a.useMirror = r.u8() != 0;
+    }
+}
+
+void writeSnapshot(ByteWriter& w, const GameStateSnapshot& s) {
+    w.u32(static_cast<uint32_t>(s.currentTurn));
+    w.u8(s.entityCount);
+    for (int i = 0; i < s.entityCount; ++i) {
+        const EntitySnapshot& e = s.entities[i];
+        w.i16(e.id);
+        w.i16(e.health);
+        w.i8(e.x);
+        w.i8(e.y);
+        w.u8(e.typeFacing);
+        w.u8(e.nameIndex);
+    }
+    for (int8_t cell : s.cells) w.i8(cell);
+}
+
+bool readSnapshot(ByteReader& r, GameStateSnapshot& s) {
+    s = GameStateSnapshot{};
+    s.currentTurn = static_cast<int32_t>(r.u32());
+    s.entityCount = r.u8();
+    if (s.entityCount > GameStateSnapshot::kMaxEntities) return false;
+    for (int i = 0; i < s.entityCount; ++i) {
+        EntitySnapshot& e = s.entities[i];
+        e.id = static_cast<int16_t>(r.i16());
+        e.health = static_cast<int16_t>(r.i16());
+        e.x = static_cast<int8_t>(r.i8());
+        e.y = static_cast<int8_t>(r.i8());
+        e.typeFacing = r.u8();
+        e.nameIndex = r.u8();
+        if ((e.typeFacing & 0x0F) > OBJECT || (e.typeFacing >> 4) > static_cast<int>(Facing::West)) return false;
+    }
+    for (int8_t& cell : s.cells) cell = static_cast<int8_t>(r.i8());
+    return r.ok;
+}
+
+} // namespace
+
+bool beginReplay(ReplayLog& log, const GameState& state, const std::vector<Card>& hand, ReplayOrder order,
+                 uint32_t seed, float mirrorChance, std::string* error) {
+    log = ReplayLog{};
+    log.order = order;
+    log.seed = seed;
+    log.mirrorChance = mirrorChance;
+    log.hand = hand;
+    return packSnapshot(state, log.names, log.initial, error);
+}
+
+void recordReplayTurn(ReplayLog& log, const TurnPlan& player, const TurnPlan& npc, const GameState& after) {
+    log.turns.push_back({player, npc, replayChecksum(after, log.names)});
+}
+
+void resolveReplayTurn(GameState& state, const std::vector<Card>& hand, const TurnPlan& player,
+                       const TurnPlan& npc, ReplayOrder order) {
+    if (order == ReplayOrder::PlayerFirst) {
+        player.resolve(state, hand);
+        npc.resolve(state, hand);
+    } else if (order == ReplayOrder::Simultaneous) {
+        thread_local SubphaseResolver resolver;
+        resolver.resolveTurn(state, hand, player, npc);
+    } else {
+        size_t steps = std::max(player.assignments.size(), npc.assignments.size());
+        for (size_t i = 0; i < steps; ++i) {
+            if (i < player.assignments.size()) applyAssignment(state, hand, player.assignments[i]);
+            if (i < npc.assignments.size()) applyAssignment(state, hand, npc.assignments[i]);
+        }
+    }
+    zobristAdvanceTurn(state);
+}
+
+uint64_t replayChecksum(const GameState& state, NameTable& names) {
+    GameStateSnapshot snapshot;
+    if (!packSnapshot(state, names, snapshot)) {
+        // Unrepresentable states still get a stable, distinct checksum.
+        return ~state.hash;
+    }
+    return snapshotHash(snapshot);
+}
+
+bool writeReplay(const ReplayLog& log, std::vector<uint8_t>& out, std::string* error) {
+    out.clear();
+    ByteWriter w{out};
+    w.u32(ReplayLog::kMagic);
+    w.u16(ReplayLog::kVersion);
+    w.u8(static_cast<uint8_t>(log.order));
+    w.u8(0);
+    w.u32(log.seed);
+    w.f32(log.mirrorChance);
+
+    if (log.names.names.size() > 255) return fail(error, "Too many entity names");
+    w.u8(static_cast<uint8_t>(log.names.names.size()));
+    for (const auto& name : log.names.names) {
+        if (name.size() > 255) return fail(error, "Entity name too long");
+        w.str(name);
+    }
+
+    writeSnapshot(w, log.initial);
+
+    if (log.hand.size() > 255) return fail(error, "Too many cards in hand");
+    w.u8(static_cast<uint8_t>(log.hand.size()));
+    for (const Card& c : log.hand) {
+        if (!fitsIn<int16_t>(c.id)) return fail(error, "Card id out of range");
+        if (c.name.size() > 255) return fail(error, "Card name too long");
+        w.i16(c.id);
+        w.str(c.name);
+        w.u8(static_cast<uint8_t>(c.type));
+        if (!writeEffect(w, c.effect, error) || !writeEffect(w, c.mirroredEffect, error)) return false;
+    }
+
+    if (log.turns.size() > 0xFFFF) return fail(error, "Too many turns");
+    w.u16(static_cast<uint16_t>(log.turns.size()));
+    for (const ReplayTurn& turn : log.turns) {
+        if (!writePlan(w, turn.player, error) || !writePlan(w, turn.npc, error)) return false;
+        w.u64(turn.checksum);
+    }
+    return true;
+}
+
+bool readReplay(const uint8_t* data, size_t size, ReplayLog& out, std::string* error) {
+    out = ReplayLog{};
+    ByteReader r{data, size};
+    if (r.u32() != ReplayLog::kMagic) return fail(error, "Not a replay file");
+    uint16_t version = r.u16();
+    if (version != ReplayLog::kVersion) return fail(error, "Unsupported replay version");
+    uint8_t order = r.u8();
+    if (order > static_cast<uint8_t>(ReplayOrder::Simultaneous)) return fail(error, "Unknown turn order");
+    out.order = static_cast<ReplayOrder>(order);
+    r.u8();
+    out.seed = r.u32();
+    out.mirrorChance = r.f32();
+
+    out.names.names.resize(r.u8());
+    for (auto& name : out.names.names) name = r.str();
+
+    if (!readSnapshot(r, out.initial)) return fail(error, "Truncated or invalid initial state");
+
+    out.hand.resize(r.u8());
+    for (auto& c : out.hand) {
+        c.id = r.i16();
+        c.name = r.str();
+        uint8_t type = r.u8();
+        c.type = static_cast<CardType>(type);
+        bool effectsValid = readEffect(r, c.effect);
+        effectsValid &= readEffect(r, c.mirroredEffect);
+        if (r.ok && (!validCardType(type) || !effectsValid)) return fail(error, "Invalid card type");
+    }
+
+    out.turns.resize(r.u16());
+    for (auto& turn : out.turns) {
+        readPlan(r, turn.player);
+        readPlan(r, turn.npc);
+        turn.checksum = r.u64();
+    }
+    if (!r.ok) return fail(error, "Truncated replay");
+    return true;
+}
+
+bool saveReplay(const ReplayLog& log, const std::string& path, std::string* error) {
+    std::vector<uint8_t> bytes;
+    if (!writeReplay(log, bytes, error)) return false;
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) return fail(error, "Could not open replay file for writing");
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file) return fail(error, "Failed to write replay file");
+    return true;
+}
+
+bool loadReplay(const std::string& path, ReplayLog& out, std::string* error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return fail(error, "Could not open replay file");
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return readReplay(bytes.data(), bytes.size(), out, error);
+}
+
+ReplayResult runReplay(const ReplayLog& log, GameState* finalState) {
+    auto start = std::chrono::steady_clock::now();
+    ReplayResult result;
+    NameTable names = log.names;
+
+    GameState state;
+    unpackSnapshot(log.initial, names, state);
+
+    for (const ReplayTurn& turn : log.turns) {
+        resolveReplayTurn(state, log.hand, turn.player, turn.npc, log.order);
+        result.turnsPlayed++;
+        uint64_t checksum = replayChecksum(state, names);
+        if (checksum != turn.checksum) {
+            result.mismatchTurn = result.turnsPlayed - 1;
+            result.expected = turn.checksum;
+            result.actual = checksum;
+            break;
+        }
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (finalState) *finalState = std::move(state);
+    return result;
+}
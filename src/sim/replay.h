@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "card.h"
+#include "snapshot.h"
+
+/**
+ * Binary replay log (G_007).
+ *
+ * Records the initial state, the hand and seeds, then each turn's player and
+ * NPC plans with a checksum of the state after the turn. runReplay re-executes
+ * the turns headlessly and stops at the first checksum mismatch, so a bug
+ * report reproduces from a file of a few hundred bytes.
+ *
+ * File layout (little-endian, version 1):
+ *   header   u32 magic 'VRPL', u16 version, u8 order, u8 reserved, u32 seed, f32 mirrorChance
+ *   names    u8 count, then per name: u8 length + bytes
+ *   initial  i32 turn, u8 entityCount, 8 bytes per entity, 144 cell bytes
+ *   hand     u8 count, then per card: i16 id, u8 name length + bytes, u8 type, effect, mirrored effect
+ *            effect = u8 type, i8 forward, i8 lateral, i16 target, i16 damage, i16 heal
+ *   turns    u16 count, then per turn: player plan, NPC plan, u64 checksum
+ *            plan = u8 count, then per assignment: i16 mech, i16 card, u8 mirror
+ */
+
+// How a turn's two plans are applied.
+enum class ReplayOrder : uint8_t {
+    Interleaved = 0,  // P0, N0, P1, N1, ... (BossPlayState before simultaneous resolution)
+    PlayerFirst = 1,  // whole player plan, then whole NPC plan (headless matches)
+    Simultaneous = 2  // {P0, N0}, {P1, N1}, ... each pair resolved together (BossPlayState)
+};
+
+struct ReplayTurn {
+    TurnPlan player;
+    TurnPlan npc;
+    uint64_t checksum = 0; // snapshotHash of the state after the turn
+};
+
+struct ReplayLog {
+    static constexpr uint32_t kMagic = 0x4C505256; // "VRPL"
+    static constexpr uint16_t kVersion = 1;
+
+    ReplayOrder order = ReplayOrder::Interleaved;
+    uint32_t seed = 0;
+    float mirrorChance = 0.5f;
+    NameTable names;
+    GameStateSnapshot initial;
+    std::vector<Card> hand;
+    std::vector<ReplayTurn> turns;
+};
+
+struct ReplayResult {
+    int turnsPlayed = 0;
+    int mismatchTurn = -1; // first turn whose checksum differed, -1 if none
+    uint64_t expected = 0;
+    uint64_t actual = 0;
+    double seconds = 0.0;
+
+    bool ok() const { return mismatchTurn < 0; }
+};
+
+// Start a log from the given state; fails if the state cannot be snapshotted.
+bool beginReplay(ReplayLog& log, const GameState& state, const std::vector<Card>& hand, ReplayOrder order,
+                 uint32_t seed = 0, float mirrorChance = 0.5f, std::string* error = nullptr);
+
+// Append a turn; after is the state once both plans have resolved and the turn advanced.
+void recordReplayTurn(ReplayLog& log, const TurnPlan& player, const TurnPlan& npc, const GameState& after);
+
+// Apply both plans in the given order (cards missing from hand are skipped) and advance the turn.
+// Simultaneous turns use a per-thread SubphaseResolver.
+void resolveReplayTurn(GameState& state, const std::vector<Card>& hand, const TurnPlan& player,
+                       const TurnPlan& npc, ReplayOrder order);
+
+// Checksum recorded per turn: snapshotHash of the packed state.
+uint64_t replayChecksum(const GameState& state, NameTable& names);
+
+// Fails instead of truncating when a count, id or name does not fit its encoded width.
+bool writeReplay(const ReplayLog& log, std::vector<uint8_t>& out, std::string* error = nullptr);
+bool readReplay(const uint8_t* data, size_t size, ReplayLog& out, std::string* error = nullptr);
+bool saveReplay(const ReplayLog& log, const std::string& path, std::string* error = nullptr);
+bool loadReplay(const std::string& path, ReplayLog& out, std::string* error = nullptr);
+
+// Re-execute every recorded turn from the initial state, verifying checksums.
+ReplayResult runReplay(const ReplayLog& log, GameState* finalState = nullptr);
@@ -0,0 +1,143 @@
+// vray_sim: headless AI-vs-AI balance runner.
+//
+//   vray_sim [--matches N] [--turns T] [--seed S] [--threads K] [--mirror P] [--record FILE] [--simultaneous]
+//   vray_sim --replay FILE
+//
+// Prints throughput and the win/draw distribution for the batch. --record also
+// writes the batch's first match as a replay; --replay re-executes a replay file
+// and verifies its per-turn checksums (exit code 2 on mismatch). --simultaneous
+// resolves each subphase's player and NPC cards together (SubphaseResolver).
+#include "match_runner.h"
+#include "replay.h"
+#include "common/profiler.h"
+#include "raylib.h" // SetTraceLogLevel
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+
+struct SimOptions {
+    std::string recordPath;
+    std::string replayPath;
+    std::string profilePath;
+};
+
+void PrintUsage() {
+    std::printf("usage: vray_sim [--matches N] [--turns T] [--seed S] [--threads K] [--mirror P] [--record FILE] [--simultaneous]\n");
+    std::printf("               [--profile FILE]   (Chrome trace of the run's CPU zones)\n");
+    std::printf("       vray_sim --replay FILE\n");
+}
+
+bool ParseArgs(int argc, char** argv, MatchConfig& config, SimOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+            return false;
+        }
+        if (std::strcmp(arg, "--simultaneous") == 0) {
+            config.simultaneous = true;
+            continue;
+        }
+        if (!value) {
+            std::fprintf(stderr, "missing value for %s\n", arg);
+            return false;
+        }
+        if (std::strcmp(arg, "--matches") == 0) config.matchCount = std::atoi(value);
+        else if (std::strcmp(arg, "--turns") == 0) config.maxTurns = std::atoi(value);
+        else if (std::strcmp(arg, "--seed") == 0) config.baseSeed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        else if (std::strcmp(arg, "--threads") == 0) config.threadCount = std::atoi(value);
+        else if (std::strcmp(arg, "--mirror") == 0) config.mirrorChance = static_cast<float>(std::atof(value));
+        else if (std::strcmp(arg, "--record") == 0) options.recordPath = value;
+        else if (std::strcmp(arg, "--replay") == 0) options.replayPath = value;
+        else if (std::strcmp(arg, "--profile") == 0) options.profilePath = value;
+        else {
+            std::fprintf(stderr, "unknown option %s\n", arg);
+            return false;
+        }
+        ++i;
+    }
+    return config.matchCount > 0 && config.maxTurns > 0;
+}
+
+double Percent(int64_t part, int64_t whole) {
+    return whole > 0 ? 100.0 * static_cast<double>(part) / static_cast<double>(whole) : 0.0;
+}
+
+int RunReplayFile(const std::string& path) {
+    ReplayLog log;
+    std::string error;
+    if (!loadReplay(path, log, &error)) {
+        std::fprintf(stderr, "replay: %s\n", error.c_str());
+        return 1;
+    }
+    ReplayResult result = runReplay(log);
+    std::printf("turns        %d / %zu\n", result.turnsPlayed, log.turns.size());
+    std::printf("seconds      %.6f\n", result.seconds);
+    if (!result.ok()) {
+        std::printf("MISMATCH     turn %d expected %016llx got %016llx\n", result.mismatchTurn,
+                    static_cast<unsigned long long>(result.expected), static_cast<unsigned long long>(result.actual));
+        return 2;
+    }
+    std::printf("checksums    ok\n");
+    return 0;
+}
+
+bool RecordFirstMatch(const MatchConfig& config, const std::string& path) {
+    ReplayLog log;
+    runMatch(config, matchSeed(config.baseSeed, 0), &log);
+    std::string error;
+    if (!saveReplay(log, path, &error)) {
+        std::fprintf(stderr, "record: %s\n", error.c_str());
+        return false;
+    }
+    std::printf("recorded     %s (%zu turns)\n", path.c_str(), log.turns.size());
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    MatchConfig config;
+    SimOptions options;
+    if (!ParseArgs(argc, argv, config, options)) {
+        PrintUsage();
+        return 1;
+    }
+
+    // Game code logs through TraceLog; keep the hot loop silent.
+    SetTraceLogLevel(LOG_NONE);
+
+    if (!options.replayPath.empty()) {
+        return RunReplayFile(options.replayPath);
+    }
+    if (!options.recordPath.empty() && !RecordFirstMatch(config, options.recordPath)) {
+        return 1;
+    }
+
+    if (!options.profilePath.empty()) {
+        profilerSetThreadName("main");
+        profilerStart();
+    }
+    SimStats stats = runMatches(config);
+    if (!options.profilePath.empty()) {
+        profilerStop();
+        std::string error;
+        if (!profilerSaveChromeTrace(options.profilePath, &error)) {
+            std::fprintf(stderr, "vray_sim: %s: %s\n", options.profilePath.c_str(), error.c_str());
+        }
+    }
+
+    std::printf("matches      %lld\n", static_cast<long long>(stats.matches));
+    std::printf("threads      %d\n", stats.threads);
+    std::printf("seconds      %.3f\n", stats.seconds);
+    std::printf("matches/sec  %.1f\n", stats.matchesPerSecond());
+    std::printf("turns/sec    %.1f\n", stats.turnsPerSecond());
+    std::printf("avg turns    %.2f\n", stats.matches > 0 ? static_cast<double>(stats.turns) / stats.matches : 0.0);
+    std::printf("player wins  %lld (%.1f%%)\n", static_cast<long long>(stats.playerWins), Percent(stats.playerWins, stats.matches));
+    std::printf("enemy wins   %lld (%.1f%%)\n", static_cast<long long>(stats.enemyWins), Percent(stats.enemyWins, stats.matches));
+    std::printf("draws        %lld (%.1f%%)\n", static_cast<long long>(stats.draws), Percent(stats.draws, stats.matches));
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include "snapshot.h"
+#include "zobrist.h"
+#include <cstring>
+#include <limits>
+
+namespace {
+
+template <typename T>
+bool fitsIn(int v) {
+    return v >= std::numeric_limits<T>::min() && v <= std::numeric_limits<T>::max();
+}
+
+bool fail(std::string* error, const char* msg) {
+    if (error) *error = msg;
+    return false;
+}
+
+} // namespace
+
+uint8_t NameTable::intern(const std::string& name) {
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (names[i] == name) return static_cast<uint8_t>(i);
+    }
+    if (names.size() >= kInvalid) return kInvalid;
+    names.push_back(name);
+    return static_cast<uint8_t>(names.size() - 1);
+}
+
+const std::string& NameTable::lookup(uint8_t index) const {
+    static const std::string empty;
+    return index < names.size() ? names[index] : empty;
+}
+
+bool packSnapshot(const GameState& state, NameTable& names, GameStateSnapshot& out, std::string* error) {
+    out = GameStateSnapshot{};
+    if (state.entities.size() > static_cast<size_t>(GameStateSnapshot::kMaxEntities)) {
+        return fail(error, "Too many entities for snapshot");
+    }
+    out.currentTurn = state.currentTurn;
+    out.entityCount = static_cast<uint8_t>(state.entities.size());
+
+    for (size_t i = 0; i < state.entities.size(); ++i) {
+        const Entity& e = state.entities[i];
+        EntitySnapshot& s = out.entities[i];
+        if (!fitsIn<int16_t>(e.id)) return fail(error, "Entity id out of range");
+        if (!fitsIn<int16_t>(e.health)) return fail(error, "Entity health out of range");
+        if (!fitsIn<int8_t>(e.position.x) || !fitsIn<int8_t>(e.position.y)) {
+            return fail(error, "Entity position out of range");
+        }
+        s.x = static_cast<int8_t>(e.position.x);
+        s.y = static_cast<int8_t>(e.position.y);
+        s.id = static_cast<int16_t>(e.id);
+        s.health = static_cast<int16_t>(e.health);
+        s.typeFacing = static_cast<uint8_t>((static_cast<int>(e.type) & 0x0F) |
+                                            ((static_cast<int>(e.facing) & 0x0F) << 4));
+        s.nameIndex = names.intern(e.name);
+        if (s.nameIndex == NameTable::kInvalid) return fail(error, "Name table full");
+    }
+
+    for (int y = 0; y < Grid::SIZE; ++y) {
+        for (int x = 0; x < Grid::SIZE; ++x) {
+            int type = state.grid.getCell(x, y);
+            if (!fitsIn<int8_t>(type)) return fail(error, "Grid cell type out of range");
+            out.cells[y * Grid::SIZE + x] = static_cast<int8_t>(type);
+        }
+    }
+    return true;
+}
+
+void unpackSnapshot(const GameStateSnapshot& snapshot, const NameTable& names, GameState& out) {
+    out.currentTurn = snapshot.currentTurn;
+    out.entities.resize(snapshot.entityCount);
+    for (int i = 0; i < snapshot.entityCount; ++i) {
+        const EntitySnapshot& s = snapshot.entities[i];
+        Entity& e = out.entities.edit(i);
+        e.id = s.id;
+        e.type = static_cast<EntityType>(s.typeFacing & 0x0F);
+        e.position = {s.x, s.y};
+        e.name = names.lookup(s.nameIndex);
+        e.health = s.health;
+        e.facing = static_cast<Facing>(s.typeFacing >> 4);
+    }
+    for (int y = 0; y < Grid::SIZE; ++y) {
+        for (int x = 0; x < Grid::SIZE; ++x) {
+            out.grid.setCell(x, y, snapshot.cells[y * Grid::SIZE + x]);
+        }
+    }
+    out.grid.syncOccupancy(out.entities);
+    out.hash = zobristHash(out);
+}
+
+uint64_t snapshotHash(const GameStateSnapshot& snapshot) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(&snapshot);
+    uint64_t hash = 1469598103934665603ull;
+    for (size_t i = 0; i < sizeof(snapshot); ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool operator==(const GameStateSnapshot& a, const GameStateSnapshot& b) {
+    return std::memcmp(&a, &b, sizeof(GameStateSnapshot)) == 0;
+}
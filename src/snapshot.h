@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "card.h"
+
+/**
+ * Side table for entity names. Snapshots store a one-byte index instead of the
+ * string, so a table is shared by every snapshot taken from the same match.
+ */
+struct NameTable {
+    static constexpr uint8_t kInvalid = 0xFF;
+    std::vector<std::string> names;
+
+    // Returns the index for name, adding it if new; kInvalid once the table is full.
+    uint8_t intern(const std::string& name);
+    const std::string& lookup(uint8_t index) const;
+};
+
+/**
+ * Packed, trivially-copyable entity record (8 bytes).
+ * typeFacing: low nibble EntityType, high nibble Facing.
+ */
+struct EntitySnapshot {
+    int16_t id = 0;
+    int16_t health = 0;
+    int8_t x = 0;
+    int8_t y = 0;
+    uint8_t typeFacing = 0;
+    uint8_t nameIndex = NameTable::kInvalid;
+};
+
+/**
+ * POD image of a GameState: fixed-size entity array plus the grid cell types.
+ * No padding, so snapshots can be memcpy'd, compared and hashed bytewise.
+ */
+struct GameStateSnapshot {
+    static constexpr int kMaxEntities = 16;
+
+    int32_t currentTurn = 0;
+    uint8_t entityCount = 0;
+    uint8_t reserved[3] = {0, 0, 0};
+    EntitySnapshot entities[kMaxEntities] = {};
+    int8_t cells[Grid::SIZE * Grid::SIZE] = {};
+};
+
+static_assert(sizeof(EntitySnapshot) == 8, "EntitySnapshot must stay packed");
+static_assert(std::is_trivially_copyable_v<GameStateSnapshot>, "snapshots are memcpy'd");
+static_assert(std::has_unique_object_representations_v<GameStateSnapshot>, "snapshots are hashed bytewise");
+
+// Pack state into out. Fails (leaving out unspecified) when the state cannot be
+// represented exactly: positions outside int8, too many entities,
+// ids/health outside int16, grid cell types outside int8, or a full name table.
+bool packSnapshot(const GameState& state, NameTable& names, GameStateSnapshot& out, std::string* error = nullptr);
+
+// Rebuild a GameState from a snapshot taken with the same name table, with
+// occupancy and hash seeded so it resolves like the original.
+void unpackSnapshot(const GameStateSnapshot& snapshot, const NameTable& names, GameState& out);
+
+// FNV-1a over the snapshot bytes; equal states hash equally.
+uint64_t snapshotHash(const GameStateSnapshot& snapshot);
+
+bool operator==(const GameStateSnapshot& a, const GameStateSnapshot& b);
@@ -0,0 +1,230 @@
+#include "subphase.h"
+#include "zobrist.h"
+#include <algorithm>
+
+namespace {
+
+int findSlot(const EntityList& entities, int id) {
+    for (size_t i = 0; i < entities.size(); ++i) {
+        if (entities[i].id == id) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+const Card* findCard(const std::vector<Card>& hand, int cardId) {
+    for (const auto& c : hand) {
+        if (c.id == cardId) return &c;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+void SubphaseResolver::resolve(GameState& state, std::span<const SubphaseAction> actions, std::vector<CardDelta>* deltas,
+                               SubphaseUndo* undo) {
+    const EntityList& entities = state.entities; // reads must not detach shared chunks
+    size_t entityCount = entities.size();
+    health_.assign(entityCount, 0);
+    moveCount_.assign(entityCount, 0);
+    movers_.clear();
+    if (deltas) deltas->assign(actions.size(), CardDelta{});
+
+    // Targets, health sums and candidate moves, all against the starting state.
+    for (size_t i = 0; i < actions.size(); ++i) {
+        const SubphaseAction& action = actions[i];
+        const CardEffect& effect = *action.effect;
+        int targetId = effect.type == CardType::Damage ? effect.targetEntityId : action.actorId;
+        int slot = findSlot(entities, targetId);
+        if (slot < 0) continue;
+        const Entity& e = entities[slot];
+
+        if (deltas) {
+            CardDelta& d = (*deltas)[i];
+            d.type = effect.type;
+            d.entityId = e.id;
+            d.fromX = d.toX = static_cast<int16_t>(e.position.x);
+            d.fromY = d.toY = static_cast<int16_t>(e.position.y);
+        }
+
+        switch (effect.type) {
+        case CardType::Move: {
+            CellDelta step = action.moves ? action.moves->at(e.facing, action.useMirror) : moveDelta(effect.move, e.facing);
+            Mover m;
+            m.action = static_cast<int>(i);
+            m.slot = slot;
+            if (state.grid.isValidPosition(e.position.x, e.position.y)) {
+                m.from = Grid::cellIndex(e.position.x, e.position.y);
+                m.to = Grid::clampedDestination(m.from, step);
+            } else {
+                m.to = Grid::cellIndex(std::clamp(e.position.x + step.dx, 0, Grid::SIZE - 1),
+                                       std::clamp(e.position.y + step.dy, 0, Grid::SIZE - 1));
+            }
+            if (m.to == m.from) break; // clamped in place at the board edge
+            moveCount_[slot]++;
+            movers_.push_back(m);
+            break;
+        }
+        case CardType::Damage:
+            health_[slot] -= effect.damage;
+            if (deltas) (*deltas)[i].healthDelta = static_cast<int16_t>(-effect.damage);
+            break;
+        case CardType::Heal:
+            health_[slot] += effect.heal;
+            if (deltas) (*deltas)[i].healthDelta = static_cast<int16_t>(effect.heal);
+            break;
+        }
+    }
+
+    // One claim pass: destination counts and which mover leaves each cell.
+    for (size_t i = 0; i < movers_.size(); ++i) {
+        claims_[movers_[i].to]++;
+        if (movers_[i].from >= 0) leaving_[movers_[i].from] = static_cast<int16_t>(i);
+    }
+    for (size_t i = 0; i < movers_.size(); ++i) {
+        Mover& m = movers_[i];
+        if (moveCount_[m.slot] > 1 || claims_[m.to] > 1) {
+            m.bounced = true;
+            continue;
+        }
+        int other = m.from >= 0 ? leaving_[m.to] : -1;
+        if (other >= 0 && movers_[other].to == m.from) m.bounced = true; // swap
+    }
+
+    // Held destinations. Bounces only ever hold more cells, so iterate until stable.
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (Mover& m : movers_) {
+            if (m.bounced || !state.grid.isOccupied(m.to % Grid::SIZE, m.to / Grid::SIZE)) continue;
+            int holder = leaving_[m.to];
+            bool vacated = false;
+            if (holder >= 0) {
+                // The holder leaves only if it moves and is the cell's only occupant.
+                const Mover& h = movers_[holder];
+                vacated = !h.bounced;
+                for (size_t s = 0; s < entityCount && vacated; ++s) {
+                    const Entity& e = entities[s];
+                    if (static_cast<int>(s) != h.slot && state.grid.isValidPosition(e.position.x, e.position.y) &&
+                        Grid::cellIndex(e.position.x, e.position.y) == m.to) {
+                        vacated = false;
+                    }
+                }
+            }
+            if (!vacated) {
+                m.bounced = true;
+                changed = true;
+            }
+        }
+    }
+
+    // Record every entity the commit below writes, before it writes. A mover
+    // that goes through moved once, so its slot appears once.
+    if (undo) {
+        undo->entries.clear();
+        for (const Mover& m : movers_) {
+            if (m.bounced) continue;
+            const Entity& e = entities[m.slot];
+            undo->entries.push_back({m.slot, e.position, e.health});
+        }
+        for (size_t slot = 0; slot < entityCount; ++slot) {
+            if (health_[slot] == 0) continue;
+            bool recorded = std::any_of(undo->entries.begin(), undo->entries.end(),
+                [slot](const SubphaseUndo::Entry& u) { return u.slot == static_cast<int>(slot); });
+            if (!recorded) undo->entries.push_back({static_cast<int>(slot), entities[slot].position, entities[slot].health});
+        }
+    }
+
+    // Commit: clear every departing cell before filling any destination, so
+    // rotations see their cells free. Resets the claim tables for the next call.
+    for (const Mover& m : movers_) {
+        if (m.bounced) continue;
+        const Entity& e = entities[m.slot];
+        state.grid.removeOccupant(e.position.x, e.position.y, e.type);
+    }
+    for (const Mover& m : movers_) {
+        claims_[m.to] = 0;
+        if (m.from >= 0) leaving_[m.from] = -1;
+        CardDelta* d = deltas ? &(*deltas)[m.action] : nullptr;
+        if (m.bounced) {
+            if (d) d->blocked = true;
+            continue;
+        }
+        Entity& e = state.entities.edit(m.slot);
+        int toX = m.to % Grid::SIZE;
+        int toY = m.to / Grid::SIZE;
+        state.grid.placeOccupant(toX, toY, e.type);
+        state.hash ^= zobristCellKey(m.slot, e.position.x, e.position.y) ^ zobristCellKey(m.slot, toX, toY);
+        e.position = {toX, toY};
+        if (d) {
+            d->toX = static_cast<int16_t>(toX);
+            d->toY = static_cast<int16_t>(toY);
+        }
+    }
+
+    for (size_t slot = 0; slot < entityCount; ++slot) {
+        int change = health_[slot];
+        if (change == 0) continue;
+        Entity& e = state.entities.edit(slot);
+        int before = e.health;
+        int after = applyHealthChange(before, change);
+        e.health = after;
+        state.hash ^= zobristHealthKey(static_cast<int>(slot), before) ^ zobristHealthKey(static_cast<int>(slot), after);
+    }
+}
+
+void SubphaseResolver::undo(GameState& state, const SubphaseUndo& record) {
+    // Same two passes as the commit, so entities that traded cells in a
+    // rotation find their old cells free.
+    for (const SubphaseUndo::Entry& u : record.entries) {
+        const Entity& e = state.entities[u.slot];
+        if (e.position != u.position) state.grid.removeOccupant(e.position.x, e.position.y, e.type);
+    }
+    for (const SubphaseUndo::Entry& u : record.entries) {
+        const Entity& current = state.entities[u.slot];
+        if (current.position == u.position && current.health == u.health) continue;
+        Entity& e = state.entities.edit(u.slot);
+        if (e.position != u.position) {
+            state.grid.placeOccupant(u.position.x, u.position.y, e.type);
+            state.hash ^= zobristCellKey(u.slot, e.position.x, e.position.y) ^ zobristCellKey(u.slot, u.position.x, u.position.y);
+            e.position = u.position;
+        }
+        if (e.health != u.health) {
+            state.hash ^= zobristHealthKey(u.slot, e.health) ^ zobristHealthKey(u.slot, u.health);
+            e.health = u.health;
+        }
+    }
+}
+
+void SubphaseResolver::resolve(GameState& state, const Hand& hand, std::span<const PlanAssignment> assignments,
+                               std::vector<CardDelta>* deltas) {
+    actions_.clear();
+    for (const PlanAssignment& a : assignments) {
+        CardHandle handle = hand.findHandle(a.cardId);
+        if (handle == kInvalidCardHandle) continue;
+        const Card& card = cardByHandle(handle);
+        actions_.push_back({a.mechId, a.useMirror ? &card.mirroredEffect : &card.effect, &cardMovesByHandle(handle), a.useMirror});
+    }
+    resolve(state, actions_, deltas);
+}
+
+void SubphaseResolver::resolve(GameState& state, const std::vector<Card>& hand, std::span<const PlanAssignment> assignments,
+                               std::vector<CardDelta>* deltas) {
+    actions_.clear();
+    for (const PlanAssignment& a : assignments) {
+        const Card* card = findCard(hand, a.cardId);
+        if (!card) continue;
+        actions_.push_back({a.mechId, a.useMirror ? &card->mirroredEffect : &card->effect, nullptr, a.useMirror});
+    }
+    resolve(state, actions_, deltas);
+}
+
+void SubphaseResolver::resolveTurn(GameState& state, const std::vector<Card>& hand, const TurnPlan& player, const TurnPlan& npc) {
+    size_t steps = std::max(player.assignments.size(), npc.assignments.size());
+    for (size_t i = 0; i < steps; ++i) {
+        PlanAssignment both[2];
+        size_t count = 0;
+        if (i < player.assignments.size()) both[count++] = player.assignments[i];
+        if (i < npc.assignments.size()) both[count++] = npc.assignments[i];
+        resolve(state, hand, std::span<const PlanAssignment>(both, count));
+    }
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "card.h"
+#include "grid.h"
+
+/**
+ * One card played in a subphase: actorId plays it (moves and heals land on the
+ * actor, damage on the effect's target). moves, when set, are the card's
+ * precomputed steps; otherwise the step is rotated from the effect.
+ */
+struct SubphaseAction {
+    int actorId = -1;
+    const CardEffect* effect = nullptr;
+    const CardMoves* moves = nullptr;
+    bool useMirror = false;
+};
+
+/**
+ * What one SubphaseResolver::resolve call wrote: the cell and health each
+ * changed entity had before it. Search code keeps one per subphase and
+ * reuses it, so recording does not allocate once the entry list has grown.
+ */
+struct SubphaseUndo {
+    struct Entry {
+        int slot = -1;
+        GridPos position;
+        int health = 0;
+    };
+    std::vector<Entry> entries;
+};
+
+/**
+ * Simultaneous resolution of one play subphase.
+ *
+ * Every action reads the state as it was when the subphase began, and all
+ * results are committed together, so the order actions are listed in never
+ * changes the outcome. Rules, applied in this order:
+ *   1. A move targets its mover's starting cell plus the rotated step,
+ *      clamped to the board. A step clamped to the start cell is a no-op.
+ *   2. A mover given more than one move in the subphase stays put.
+ *   3. Moves that share a destination all bounce.
+ *   4. Two movers trading cells both bounce. Longer rotations go through.
+ *   5. A move into a cell that stays held bounces. The holder may be an
+ *      entity that is not moving or a mover that bounced. Bounces propagate
+ *      along chains until nothing changes.
+ *   6. Damage and heal amounts on an entity are summed and applied once after
+ *      the moves with applyHealthChange, the rule resolveCard uses.
+ *
+ * Conflicts are found with one claim pass over per-cell tables. The resolver
+ * keeps its scratch between calls, so steady-state subphases do not allocate.
+ * One resolver per thread.
+ */
+class SubphaseResolver {
+public:
+    SubphaseResolver() { leaving_.fill(-1); }
+
+    // Resolve actions together. When deltas is given it receives one record per
+    // action, in action order. Bounced moves are flagged blocked. healthDelta
+    // is the card's own contribution before the clamp. When undo is given it
+    // records what undo() needs to put the state back.
+    void resolve(GameState& state, std::span<const SubphaseAction> actions, std::vector<CardDelta>* deltas = nullptr,
+                 SubphaseUndo* undo = nullptr);
+
+    // Revert one resolve() on the same state, most recent subphase first.
+    // Restores positions, health, occupancy and hash.
+    static void undo(GameState& state, const SubphaseUndo& record);
+
+    // Assignments played together, cards looked up by id. Assignments whose
+    // card is missing are skipped.
+    void resolve(GameState& state, const Hand& hand, std::span<const PlanAssignment> assignments,
+                 std::vector<CardDelta>* deltas = nullptr);
+    void resolve(GameState& state, const std::vector<Card>& hand, std::span<const PlanAssignment> assignments,
+                 std::vector<CardDelta>* deltas = nullptr);
+
+    // A whole turn. Subphase i resolves player.assignments[i] and
+    // npc.assignments[i] together. The turn counter is not advanced.
+    void resolveTurn(GameState& state, const std::vector<Card>& hand, const TurnPlan& player, const TurnPlan& npc);
+
+private:
+    struct Mover {
+        int action = -1;
+        int slot = -1;
+        int from = -1; // cell index, -1 when starting off the board
+        int to = -1;
+        bool bounced = false;
+    };
+
+    std::vector<SubphaseAction> actions_;
+    std::vector<Mover> movers_;
+    std::vector<int> health_;        // per entity slot, summed health change
+    std::vector<uint8_t> moveCount_; // per entity slot
+    std::array<uint8_t, Grid::CELLS> claims_{};
+    std::array<int16_t, Grid::CELLS> leaving_{}; // mover index starting in each cell, -1 if none
+};
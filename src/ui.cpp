@@ -13,13 +13,7 @@ void CardTooltip_Draw(CardTooltip& tooltip, const Game& game) {
     if (!tooltip.visible) return;
 
     // Find card in game.hand
-    const Card* card = nullptr;
-    for (const auto& c : game.hand.cards) {
-        if (c.id == tooltip.cardId) {
-            card = &c;
-            break;
-        }
-    }
+    const Card* card = game.hand.find(tooltip.cardId);
     if (!card) return;
 
     // Tooltip box dimensions and position with offset
@@ -157,10 +151,7 @@ CardActions UI_Draw(AppContext& ctx) {
             // Show pending card selection
             std::string pendingText = "Selected: ";
             if (ctx.game.pendingCardId != -1) {
-                const Card* pc = nullptr;
-                for (const auto& c : ctx.game.hand.cards) {
-                    if (c.id == ctx.game.pendingCardId) { pc = &c; break; }
-                }
+                const Card* pc = ctx.game.hand.find(ctx.game.pendingCardId);
                 pendingText += pc ? pc->name : std::to_string(ctx.game.pendingCardId);
                 if (ctx.game.pendingMirror) pendingText += " (M)";
             } else {
@@ -178,13 +169,26 @@ CardActions UI_Draw(AppContext& ctx) {
                     if (a.mechId == mechId) { slot = &a; break; }
                 }
                 if (slot) {
-                    const Card* c = nullptr;
-                    for (const auto& hc : ctx.game.hand.cards) { if (hc.id == slot->cardId) { c = &hc; break; } }
+                    const Card* c = ctx.game.hand.find(slot->cardId);
                     slotLabel += c ? c->name : std::to_string(slot->cardId);
                     if (slot->useMirror) slotLabel += " (M)";
                 } else {
                     slotLabel += "(empty)";
                 }
+                // Legal-move preview for the pending card, from the same step tables resolution uses
+                CardHandle pending = ctx.game.hand.findHandle(ctx.game.pendingCardId);
+                if (pending != kInvalidCardHandle && cardByHandle(pending).effect.type == CardType::Move) {
+                    for (const auto& e : ctx.game.entities) {
+                        if (e.id != mechId) continue;
+                        CardDelta preview = previewMove(ctx.game.grid, e, cardMovesByHandle(pending).at(e.facing, ctx.game.pendingMirror));
+                        if (preview.blocked) {
+                            slotLabel += " > blocked";
+                        } else {
+                            slotLabel += " > " + std::to_string(preview.toX) + "," + std::to_string(preview.toY);
+                        }
+                        break;
+                    }
+                }
                 bool assign = GuiButton({mechBaseX + (float)i * 210.0f, slotBaseY, 200.0f, 26.0f}, slotLabel.c_str());
                 if (assign) {
                     actions.assignCardToMech = mechId;
@@ -194,8 +198,8 @@ CardActions UI_Draw(AppContext& ctx) {
             // Hand buttons (card selection step)
             float cardBaseY = slotBaseY + 36.0f;
             float cardBaseX = panelRect.x + 12.0f;
-            for (size_t i = 0; i < ctx.game.hand.cards.size(); ++i) {
-                const Card& card = ctx.game.hand.cards[i];
+            for (size_t i = 0; i < ctx.game.hand.size(); ++i) {
+                const Card& card = ctx.game.hand.cards()[i];
                 bool available = ctx.game.hand.canPlay(card.id);
                 // Check if card already assigned
                 int assignedMech = -1;
@@ -230,10 +234,7 @@ CardActions UI_Draw(AppContext& ctx) {
             } else {
                 for (size_t i = 0; i < ctx.game.currentPlan.assignments.size(); ++i) {
                     const auto& a = ctx.game.currentPlan.assignments[i];
-                    const Card* c = nullptr;
-                    for (const auto& hc : ctx.game.hand.cards) {
-                        if (hc.id == a.cardId) { c = &hc; break; }
-                    }
+                    const Card* c = ctx.game.hand.find(a.cardId);
                     std::string name = c ? c->name : std::to_string(a.cardId);
                     if (a.useMirror) name += " (M)";
 
@@ -328,3 +329,89 @@ CardActions UI_Draw(AppContext& ctx) {
 
     return actions;
 }
+
+/**
+ * Allocation overlay: last frame's totals, the worst frame so far, and one
+ * row per named AllocScope. TextFormat formats into raylib's static buffers,
+ * so drawing the overlay adds nothing to the counts it shows.
+ */
+void DrawAllocOverlay(const AllocFrameStats& stats, int x, int y) {
+    const int fontSize = 10;
+    const int rowH = 12;
+    const int rows = 2 + stats.scopeCount;
+    DrawRectangle(x, y, 250, rows * rowH + 8, Color{0, 0, 0, 160});
+    int ty = y + 4;
+    DrawText(TextFormat("heap: %llu allocs  %.1f KB  %llu frees", (unsigned long long)stats.total.allocations,
+                        stats.total.bytes / 1024.0, (unsigned long long)stats.total.frees),
+             x + 4, ty, fontSize, stats.total.allocations == 0 ? GREEN : YELLOW);
+    ty += rowH;
+    DrawText(TextFormat("worst frame: %llu allocs  %.1f KB", (unsigned long long)stats.peak.allocations,
+                        stats.peak.bytes / 1024.0),
+             x + 4, ty, fontSize, LIGHTGRAY);
+    for (int i = 0; i < stats.scopeCount; ++i) {
+        ty += rowH;
+        const AllocScopeCounts& s = stats.scopes[i];
+        DrawText(TextFormat("  %-24s %6llu  %8.1f KB", s.name, (unsigned long long)s.counts.allocations,
+                            s.counts.bytes / 1024.0),
+                 x + 4, ty, fontSize, s.counts.allocations == 0 ? LIGHTGRAY : ORANGE);
+    }
+}
+
+/**
+ * Performance HUD. The graph shows the rolling frame-time window oldest to
+ * newest, one bar per frame, scaled to at least 33 ms so a steady 60 Hz run
+ * sits low and spikes stand out.
+ */
+int DrawPerfHud(const FrameStats& stats, const FrameTimeHistory& history, int x, int y) {
+    const int width = 300;
+    const int graphH = 48;
+    const int fontSize = 10;
+    const int rowH = 12;
+    const int height = 4 + rowH + graphH + 4 + 4 * rowH + 4;
+    DrawRectangle(x, y, width, height, Color{0, 0, 0, 170});
+
+    int ty = y + 4;
+    float fps = stats.frameMs > 0.0f ? 1000.0f / stats.frameMs : 0.0f;
+    DrawText(TextFormat("%3.0f FPS  %5.2f ms   p50 %.1f  p95 %.1f  p99 %.1f", fps, stats.frameMs,
+                        history.percentile(50.0f), history.percentile(95.0f), history.percentile(99.0f)),
+             x + 4, ty, fontSize, RAYWHITE);
+    ty += rowH;
+
+    // Frame-time graph with a 60 Hz reference line
+    const int graphX = x + 4;
+    const int graphW = width - 8;
+    const float scaleMs = std::max(33.3f, history.max());
+    DrawRectangle(graphX, ty, graphW, graphH, Color{30, 30, 30, 200});
+    const int n = history.size();
+    for (int i = 0; i < n; ++i) {
+        float ms = history.at(i);
+        int barH = std::max(1, static_cast<int>(ms / scaleMs * graphH));
+        int bx = graphX + graphW - n + i;
+        if (bx < graphX) continue;
+        Color c = ms <= 17.0f ? GREEN : (ms <= 34.0f ? YELLOW : RED);
+        DrawLine(bx, ty + graphH, bx, ty + graphH - barH, c);
+    }
+    int refY = ty + graphH - static_cast<int>(16.7f / scaleMs * graphH);
+    DrawLine(graphX, refY, graphX + graphW, refY, Color{255, 255, 255, 90});
+    ty += graphH + 4;
+
+    DrawText(TextFormat("update %5.2f  scene %5.2f  post %5.2f  ui %5.2f ms", stats.updateMs, stats.sceneMs,
+                        stats.postMs, stats.uiMs),
+             x + 4, ty, fontSize, LIGHTGRAY);
+    ty += rowH;
+    DrawText(TextFormat("draws %d  uniforms %d  models %d  tris %lld", stats.render.drawCalls,
+                        stats.render.uniformSets, stats.render.modelsDrawn, (long long)stats.render.triangles),
+             x + 4, ty, fontSize, LIGHTGRAY);
+    ty += rowH;
+    DrawText(TextFormat("entities  game %d  world %d", stats.gameEntities, stats.worldEntities), x + 4, ty,
+             fontSize, LIGHTGRAY);
+    ty += rowH;
+    if (allocTrackingEnabled()) {
+        DrawText(TextFormat("heap  %llu allocs  %.1f KB", (unsigned long long)stats.allocs.allocations,
+                            stats.allocs.bytes / 1024.0),
+                 x + 4, ty, fontSize, stats.allocs.allocations == 0 ? LIGHTGRAY : YELLOW);
+    } else {
+        DrawText("heap  not tracked (F3)", x + 4, ty, fontSize, GRAY);
+    }
+    return height;
+}
@@ -5,6 +5,7 @@
 #include "card.h"
 #include "game.h"
 #include "app.h"
+#include "common/alloc_tracker.h"
 #include "raylib.h"
 
 /**
@@ -75,6 +76,13 @@ void CardTooltip_Draw(CardTooltip& tooltip, const Game& game);
 // Draw render controls (supersample toggle, FXAA toggle) anchored at bottom.
 void draw_render_controls(UiState& ui, int screenWidth, int screenHeight);
 
+// Performance HUD: frame-time graph with p50/p95/p99, phase timings, render
+// counters and entity/allocation totals. Returns the panel height in pixels.
+int DrawPerfHud(const FrameStats& stats, const FrameTimeHistory& history, int x, int y);
+
+// Per-frame heap allocation counts (total and per named scope) at the given corner.
+void DrawAllocOverlay(const AllocFrameStats& stats, int x, int y);
+
 // Draw the entire UI and return any user actions.
 CardActions UI_Draw(AppContext& ctx);
 
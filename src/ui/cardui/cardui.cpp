@@ -142,13 +142,7 @@ void update_cardui_drop(Game& game, CardActions& actions, DragState& drag) {
     // If mouse was released while dragging
     if (drag.isDragging && IsMouseButtonReleased(MOUSE_BUTTON_LEFT)) {
         // Find the card being dragged for logging
-        const Card* draggedCard = nullptr;
-        for (const auto& c : game.hand.cards) {
-            if (c.id == drag.draggedCardId) {
-                draggedCard = &c;
-                break;
-            }
-        }
+        const Card* draggedCard = game.hand.find(drag.draggedCardId);
         
         // Log card release event
         TraceLog(LOG_INFO, "UI: Card released - ID: %d, Name: %s", 
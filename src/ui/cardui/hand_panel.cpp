@@ -109,7 +109,7 @@ void HandPanel_Draw(const Rectangle& handRect, Game& game, DragState& drag, Card
     const float cardAreaHeight = handRect.height - 42.0f;
     
     // Calculate total width needed and center cards horizontally
-    int numCards = (int)game.hand.cards.size();
+    int numCards = (int)game.hand.size();
     float totalCardWidth = numCards * cardWidth + (numCards - 1) * spacing;
     float startX = handRect.x + (handRect.width - totalCardWidth) / 2.0f;
     
@@ -126,7 +126,7 @@ void HandPanel_Draw(const Rectangle& handRect, Game& game, DragState& drag, Card
     
     // Draw each card
     for (int i = 0; i < numCards; ++i) {
-        const Card& card = game.hand.cards[i];
+        const Card& card = game.hand.cards()[i];
         
         Rectangle cardRect = {
             startX + i * (cardWidth + spacing),
@@ -190,13 +190,7 @@ void HandPanel_Draw(const Rectangle& handRect, Game& game, DragState& drag, Card
     
     // Draw dragged card at cursor if dragging
     if (drag.isDragging && drag.draggedCardId != -1) {
-        const Card* draggedCard = nullptr;
-        for (const auto& c : game.hand.cards) {
-            if (c.id == drag.draggedCardId) {
-                draggedCard = &c;
-                break;
-            }
-        }
+        const Card* draggedCard = game.hand.find(drag.draggedCardId);
         
         if (draggedCard) {
             Rectangle dragRect = {
@@ -174,13 +174,7 @@ void MechSlotContainer_Draw(const Rectangle& slotRect, Game& game, DragState& dr
         
         // Draw assigned card preview if present
         if (slot.assignedCardId != -1) {
-            const Card* assignedCard = nullptr;
-            for (const auto& c : game.hand.cards) {
-                if (c.id == slot.assignedCardId) {
-                    assignedCard = &c;
-                    break;
-                }
-            }
+            const Card* assignedCard = game.hand.find(slot.assignedCardId);
             
             if (assignedCard) {
                 // Draw card name
@@ -0,0 +1,305 @@
+#include "jsonCodec.h"
+
+#include <charconv>
+#include <cmath>
+
+bool JsonReader::fail(const char* message) {
+    if (!error_) error_ = message;
+    return false;
+}
+
+void JsonReader::skipWhitespace() {
+    while (pos_ < in_.size()) {
+        char c = in_[pos_];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t') break;
+        pos_++;
+    }
+}
+
+bool JsonReader::expect(char c) {
+    if (!ok()) return false;
+    skipWhitespace();
+    if (pos_ >= in_.size() || in_[pos_] != c) return fail("Unexpected character");
+    pos_++;
+    return true;
+}
+
+bool JsonReader::beginObject() {
+    if (!expect('{')) return false;
+    if (depth_ >= kMaxDepth) return fail("Nesting too deep");
+    first_[depth_++] = true;
+    return true;
+}
+
+bool JsonReader::beginArray() {
+    if (!expect('[')) return false;
+    if (depth_ >= kMaxDepth) return fail("Nesting too deep");
+    first_[depth_++] = true;
+    return true;
+}
+
+// Consumes ',' between members, or the closing bracket (returning false).
+bool JsonReader::separator(char close, bool& first) {
+    if (!ok()) return false;
+    if (depth_ == 0) return fail("Not inside a container");
+    skipWhitespace();
+    if (pos_ >= in_.size()) return fail("Unexpected end of input");
+    if (in_[pos_] == close) {
+        pos_++;
+        depth_--;
+        return false;
+    }
+    if (!first) {
+        if (in_[pos_] != ',') return fail("Expected ','");
+        pos_++;
+    }
+    first = false;
+    return true;
+}
+
+bool JsonReader::nextKey(std::string_view& key) {
+    if (!separator('}', first_[depth_ > 0 ? depth_ - 1 : 0])) return false;
+    return readString(key) && expect(':');
+}
+
+bool JsonReader::nextElement() {
+    return separator(']', first_[depth_ > 0 ? depth_ - 1 : 0]);
+}
+
+bool JsonReader::readInt(int& out) {
+    if (!ok()) return false;
+    skipWhitespace();
+    const char* begin = in_.data() + pos_;
+    const char* end = in_.data() + in_.size();
+    auto [ptr, ec] = std::from_chars(begin, end, out);
+    if (ec != std::errc()) return fail("Expected integer");
+    pos_ += static_cast<size_t>(ptr - begin);
+    return true;
+}
+
+bool JsonReader::readDouble(double& out) {
+    if (!ok()) return false;
+    skipWhitespace();
+    const char* begin = in_.data() + pos_;
+    const char* end = in_.data() + in_.size();
+    auto [ptr, ec] = std::from_chars(begin, end, out);
+    if (ec != std::errc()) return fail("Expected number");
+    pos_ += static_cast<size_t>(ptr - begin);
+    return true;
+}
+
+bool JsonReader::readBool(bool& out) {
+    if (!ok()) return false;
+    skipWhitespace();
+    if (in_.substr(pos_, 4) == "true") {
+        out = true;
+        pos_ += 4;
+        return true;
+    }
+    if (in_.substr(pos_, 5) == "false") {
+        out = false;
+        pos_ += 5;
+        return true;
+    }
+    return fail("Expected boolean");
+}
+
+bool JsonReader::readString(std::string_view& out) {
+    if (!expect('"')) return false;
+    size_t start = pos_;
+    while (pos_ < in_.size()) {
+        char c = in_[pos_];
+        if (c == '\\') {
+            pos_ += 2;
+            continue;
+        }
+        if (c == '"') {
+            out = in_.substr(start, pos_ - start);
+            pos_++;
+            return true;
+        }
+        pos_++;
+    }
+    return fail("Unterminated string");
+}
+
+bool JsonReader::skipValue() {
+    if (!ok()) return false;
+    skipWhitespace();
+    if (pos_ >= in_.size()) return fail("Unexpected end of input");
+    char c = in_[pos_];
+    if (c == '"') {
+        std::string_view ignored;
+        return readString(ignored);
+    }
+    if (c == '{') {
+        beginObject();
+        std::string_view key;
+        while (nextKey(key)) {
+            if (!skipValue()) return false;
+        }
+        return ok();
+    }
+    if (c == '[') {
+        beginArray();
+        while (nextElement()) {
+            if (!skipValue()) return false;
+        }
+        return ok();
+    }
+    if (c == 't' || c == 'f') {
+        bool ignored;
+        return readBool(ignored);
+    }
+    if (in_.substr(pos_, 4) == "null") {
+        pos_ += 4;
+        return true;
+    }
+    // Numbers: accept the JSON number alphabet without interpreting it.
+    size_t start = pos_;
+    while (pos_ < in_.size()) {
+        char n = in_[pos_];
+        if ((n >= '0' && n <= '9') || n == '-' || n == '+' || n == '.' || n == 'e' || n == 'E') {
+            pos_++;
+        } else {
+            break;
+        }
+    }
+    if (pos_ == start) return fail("Unexpected character");
+    return true;
+}
+
+bool JsonReader::atEnd() {
+    skipWhitespace();
+    return ok() && pos_ == in_.size();
+}
+
+void JsonReader::unescape(std::string_view raw, std::string& out) {
+    out.clear();
+    out.reserve(raw.size());
+    for (size_t i = 0; i < raw.size(); ++i) {
+        char c = raw[i];
+        if (c != '\\' || i + 1 >= raw.size()) {
+            out.push_back(c);
+            continue;
+        }
+        char e = raw[++i];
+        switch (e) {
+        case 'n': out.push_back('\n'); break;
+        case 't': out.push_back('\t'); break;
+        case 'r': out.push_back('\r'); break;
+        case 'b': out.push_back('\b'); break;
+        case 'f': out.push_back('\f'); break;
+        case 'u':
+            // Names are ASCII; \u00XX is all the encoder emits.
+            if (i + 4 < raw.size()) {
+                unsigned code = 0;
+                std::from_chars(raw.data() + i + 1, raw.data() + i + 5, code, 16);
+                out.push_back(static_cast<char>(code & 0xFF));
+                i += 4;
+            }
+            break;
+        default: out.push_back(e); break; // \" \\ \/
+        }
+    }
+}
+
+void JsonWriter::separate() {
+    if (afterKey_) {
+        afterKey_ = false;
+        return;
+    }
+    if (depth_ > 0) {
+        if (!first_[depth_ - 1]) out_.push_back(',');
+        first_[depth_ - 1] = false;
+    }
+}
+
+JsonWriter& JsonWriter::beginObject() {
+    separate();
+    out_.push_back('{');
+    if (depth_ < kMaxDepth) first_[depth_] = true;
+    depth_++;
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject() {
+    out_.push_back('}');
+    depth_--;
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray() {
+    separate();
+    out_.push_back('[');
+    if (depth_ < kMaxDepth) first_[depth_] = true;
+    depth_++;
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray() {
+    out_.push_back(']');
+    depth_--;
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(std::string_view name) {
+    value(name);
+    out_.push_back(':');
+    afterKey_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(int v) {
+    separate();
+    char buf[16];
+    auto [ptr, ec] = std::to_chars(buf, buf + sizeof(buf), v);
+    out_.append(buf, ptr);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(double v) {
+    separate();
+    if (!std::isfinite(v)) {
+        out_.append("null"); // JSON has no NaN or infinity
+        return *this;
+    }
+    char buf[32];
+    auto [ptr, ec] = std::to_chars(buf, buf + sizeof(buf), v);
+    out_.append(buf, ptr);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool v) {
+    separate();
+    out_.append(v ? "true" : "false");
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(std::string_view v) {
+    separate();
+    out_.push_back('"');
+    size_t run = 0; // start of the pending run of characters that need no escaping
+    for (size_t i = 0; i < v.size(); ++i) {
+        char c = v[i];
+        if (c != '"' && c != '\\' && static_cast<unsigned char>(c) >= 0x20) continue;
+        out_.append(v.data() + run, i - run);
+        run = i + 1;
+        switch (c) {
+        case '"': out_.append("\\\""); break;
+        case '\\': out_.append("\\\\"); break;
+        case '\n': out_.append("\\n"); break;
+        case '\t': out_.append("\\t"); break;
+        case '\r': out_.append("\\r"); break;
+        default: {
+            static const char hex[] = "0123456789abcdef";
+            out_.append("\\u00");
+            out_.push_back(hex[(c >> 4) & 0xF]);
+            out_.push_back(hex[c & 0xF]);
+        }
+        }
+    }
+    out_.append(v.data() + run, v.size() - run);
+    out_.push_back('"');
+    return *this;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * Pull-style JSON reader over a std::string_view. Single pass, no allocation:
+ * strings come back as views into the input (still escaped; see unescape).
+ *
+ *   reader.beginObject();
+ *   std::string_view key;
+ *   while (reader.nextKey(key)) { if (key == "id") reader.readInt(id); else reader.skipValue(); }
+ *
+ * Every call returns false on malformed input and latches the reader into a
+ * failed state with an error message; later calls keep returning false.
+ */
+class JsonReader {
+public:
+    explicit JsonReader(std::string_view input) : in_(input) {}
+
+    bool beginObject();
+    // Reads the next key (and its ':'); false at the closing '}' or on error.
+    bool nextKey(std::string_view& key);
+    bool beginArray();
+    // Positions at the next element; false at the closing ']' or on error.
+    bool nextElement();
+
+    bool readInt(int& out);
+    bool readDouble(double& out);
+    bool readBool(bool& out);
+    bool readString(std::string_view& out); // raw contents between the quotes
+    bool skipValue();
+
+    // True once the whole input (bar trailing whitespace) has been consumed.
+    bool atEnd();
+    bool ok() const { return error_ == nullptr; }
+    const char* error() const { return error_ ? error_ : ""; }
+
+    // Decode escapes in a view returned by readString.
+    static void unescape(std::string_view raw, std::string& out);
+
+private:
+    bool fail(const char* message);
+    void skipWhitespace();
+    bool expect(char c);
+    bool separator(char close, bool& first);
+
+    std::string_view in_;
+    size_t pos_ = 0;
+    const char* error_ = nullptr;
+    // Per nesting level: whether the next element/key is the first one.
+    static constexpr int kMaxDepth = 32;
+    bool first_[kMaxDepth] = {};
+    int depth_ = 0;
+};
+
+/**
+ * Streaming JSON writer that appends into a caller-owned buffer, so encoding
+ * into the same std::string every turn reuses its capacity. Commas are
+ * inserted automatically; keys and values must alternate inside objects.
+ */
+class JsonWriter {
+public:
+    explicit JsonWriter(std::string& out) : out_(out) {}
+
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+    JsonWriter& key(std::string_view name);
+    JsonWriter& value(int v);
+    JsonWriter& value(double v); // shortest form that reads back exactly
+    JsonWriter& value(bool v);
+    JsonWriter& value(std::string_view v);
+    JsonWriter& value(const char* v) { return value(std::string_view(v)); }
+
+private:
+    void separate();
+
+    std::string& out_;
+    static constexpr int kMaxDepth = 32;
+    bool first_[kMaxDepth] = {};
+    int depth_ = 0;
+    bool afterKey_ = false;
+};
@@ -11,6 +11,8 @@
 #include "meshProcessUtils.h"
 #include "meshGenerateUtils.h"
 #include "luaUtils.h"
+#include "common/jobsystem.h"
+#include "common/profiler.h"
 
 struct MechConfig {
     float scale;
@@ -176,6 +178,7 @@ MechConfig::MechConfig()
     , right_weapon(1) {} // default: rocket
 
 static MechConfig LoadMechConfig(const std::string& path) {
+    PROFILE_ZONE("LoadMechConfig");
     MechConfig cfg;
     std::ifstream f(path);
     if (!f.is_open()) return cfg;
@@ -889,6 +892,7 @@ static Mesh CreateArmorPlate(float width, float height, float thickness) {
 }
 
 ProceduralMech AssembleMech(const MechConfig& cfg) {
+    PROFILE_ZONE("AssembleMech");
     ProceduralMech mech;
     const float scale = cfg.scale; 
     
@@ -1004,6 +1008,7 @@ ProceduralMech AssembleMech(const MechConfig& cfg) {
 
 // Merge all mech parts into a single mesh with transforms applied and fresh normals.
 static Mesh MergeMechParts(const ProceduralMech& mech) {
+    PROFILE_ZONE("MergeMechParts");
     std::vector<float> verts;
     std::vector<unsigned short> indices;
 
@@ -1076,7 +1081,27 @@ static std::string SelectMechVariantPath(const std::string& variant) {
 }
 
 Mesh CreateMechMesh(const std::string& variant) {
+    PROFILE_ZONE("CreateMechMesh");
     MechConfig cfg = LoadMechConfig(SelectMechVariantPath(variant));
     ProceduralMech mech = AssembleMech(cfg);
     return MergeMechParts(mech);
-}
\ No newline at end of file
+}
+
+std::vector<Mesh> CreateMechMeshes(const std::vector<std::string>& variants) {
+    PROFILE_ZONE("CreateMechMeshes");
+    // Config parsing is pure CPU work and runs on the job pool; GenMesh*/UploadMesh
+    // touch the GL context, so assembly stays on the calling thread.
+    std::vector<MechConfig> configs(variants.size());
+    jobSystem().parallelFor(0, static_cast<int>(variants.size()), 1, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            configs[i] = LoadMechConfig(SelectMechVariantPath(variants[i]));
+        }
+    });
+
+    std::vector<Mesh> meshes;
+    meshes.reserve(variants.size());
+    for (const MechConfig& cfg : configs) {
+        meshes.push_back(MergeMechParts(AssembleMech(cfg)));
+    }
+    return meshes;
+}
@@ -1,7 +1,12 @@
 #pragma once
 #include "raylib.h"
 #include <string>
+#include <vector>
 
 // Build a single merged mech mesh (matte shading applied by caller's shader)
 // Variants: "alpha" (chunky), "bravo" (default), "charlie" (sleek)
 Mesh CreateMechMesh(const std::string& variant = "bravo");
+
+// Build several variants at once. Variant configs load in parallel on the shared
+// job pool; mesh assembly and upload stay on the calling (GL) thread.
+std::vector<Mesh> CreateMechMeshes(const std::vector<std::string>& variants);
@@ -0,0 +1,366 @@
+#include "wire.h"
+#include "zobrist.h"
+
+namespace {
+
+bool fail(std::string* error, const char* msg) {
+    if (error) *error = msg;
+    return false;
+}
+
+void putVarint(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+void putSigned(std::vector<uint8_t>& out, int64_t v) {
+    putVarint(out, (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+}
+
+void putHeader(std::vector<uint8_t>& out, WireKind kind) {
+    out.clear();
+    out.push_back('V');
+    out.push_back('W');
+    out.push_back(kWireVersion);
+    out.push_back(static_cast<uint8_t>(kind));
+}
+
+// Writes the string table for items[i] names and fills index[i] with each
+// item's table slot. Quadratic in the item count, which is a hand or a board.
+template <typename Items, typename NameOf>
+void putStringTable(std::vector<uint8_t>& out, const Items& items, NameOf nameOf, uint16_t* index) {
+    size_t n = items.size();
+    uint16_t distinct = 0;
+    for (size_t i = 0; i < n; ++i) {
+        index[i] = distinct;
+        for (size_t j = 0; j < i; ++j) {
+            if (nameOf(items[j]) == nameOf(items[i])) {
+                index[i] = index[j];
+                break;
+            }
+        }
+        if (index[i] == distinct) distinct++;
+    }
+    putVarint(out, distinct);
+    uint16_t written = 0;
+    for (size_t i = 0; i < n && written < distinct; ++i) {
+        if (index[i] != written) continue;
+        const std::string& name = nameOf(items[i]);
+        putVarint(out, name.size());
+        out.insert(out.end(), name.begin(), name.end());
+        written++;
+    }
+}
+
+// Scratch for putStringTable indices; stack-backed for typical sizes.
+struct IndexScratch {
+    uint16_t local[64];
+    std::vector<uint16_t> heap;
+
+    uint16_t* get(size_t n) {
+        if (n <= 64) return local;
+        heap.resize(n);
+        return heap.data();
+    }
+};
+
+void putCard(std::vector<uint8_t>& out, const Card& card, uint16_t nameIndex) {
+    putSigned(out, card.id);
+    putVarint(out, nameIndex);
+    out.push_back(static_cast<uint8_t>(card.type));
+    putSigned(out, card.effect.move.forward);
+    putSigned(out, card.effect.move.lateral);
+    putSigned(out, card.effect.targetEntityId);
+    putSigned(out, card.effect.damage);
+    putSigned(out, card.effect.heal);
+}
+
+int toInt(int64_t v) { return static_cast<int>(v); }
+
+bool validType(uint8_t type) { return type <= static_cast<uint8_t>(CardType::Heal); }
+
+// Walk a card record for validation (string index and type checked).
+bool checkCard(WireCursor& cursor, const WireStrings& strings) {
+    cursor.svarint();
+    uint64_t name = cursor.varint();
+    uint8_t type = cursor.byte();
+    for (int i = 0; i < 5; ++i) cursor.svarint();
+    return cursor.ok() && name < strings.size() && validType(type);
+}
+
+} // namespace
+
+uint8_t WireCursor::byte() {
+    if (pos_ >= bytes_.size()) {
+        ok_ = false;
+        return 0;
+    }
+    return bytes_[pos_++];
+}
+
+uint64_t WireCursor::varint() {
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t b = byte();
+        if (!ok_) return 0;
+        v |= static_cast<uint64_t>(b & 0x7F) << shift;
+        if ((b & 0x80) == 0) return v;
+    }
+    ok_ = false; // more than 10 bytes
+    return 0;
+}
+
+int64_t WireCursor::svarint() {
+    uint64_t v = varint();
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+std::string_view WireCursor::bytesView(size_t length) {
+    if (bytes_.size() - pos_ < length) {
+        ok_ = false;
+        pos_ = bytes_.size();
+        return {};
+    }
+    std::string_view view(reinterpret_cast<const char*>(bytes_.data() + pos_), length);
+    pos_ += length;
+    return view;
+}
+
+std::string_view WireStrings::get(size_t index) const {
+    WireCursor cursor(table_);
+    for (size_t i = 0; i < count_; ++i) {
+        std::string_view s = cursor.bytesView(cursor.varint());
+        if (i == index) return s;
+    }
+    return {};
+}
+
+bool parseWireHeader(WireCursor& cursor, WireKind kind, WireStrings& strings, std::string* error) {
+    if (cursor.byte() != 'V' || cursor.byte() != 'W') return fail(error, "Not a wire message");
+    if (cursor.byte() != kWireVersion) return fail(error, "Unsupported wire version");
+    if (cursor.byte() != static_cast<uint8_t>(kind)) return fail(error, "Unexpected message kind");
+    strings.count_ = cursor.varint();
+    size_t start = cursor.offset();
+    std::span<const uint8_t> rest = cursor.rest();
+    for (size_t i = 0; i < strings.count_ && cursor.ok(); ++i) {
+        cursor.bytesView(cursor.varint());
+    }
+    if (!cursor.ok()) return fail(error, "Truncated string table");
+    strings.table_ = rest.first(cursor.offset() - start);
+    return true;
+}
+
+void encodeCard(const Card& card, std::vector<uint8_t>& out) {
+    putHeader(out, WireKind::Card);
+    putVarint(out, 1);
+    putVarint(out, card.name.size());
+    out.insert(out.end(), card.name.begin(), card.name.end());
+    putCard(out, card, 0);
+}
+
+void encodeHand(const Hand& hand, std::vector<uint8_t>& out) {
+    putHeader(out, WireKind::Hand);
+    IndexScratch scratch;
+    Hand::CardRange cards = hand.cards();
+    uint16_t* index = scratch.get(cards.size());
+    putStringTable(out, cards, [](const Card& c) -> const std::string& { return c.name; }, index);
+    putVarint(out, cards.size());
+    for (size_t i = 0; i < cards.size(); ++i) {
+        putCard(out, cards[i], index[i]);
+    }
+}
+
+void encodeTurnPlan(const TurnPlan& plan, std::vector<uint8_t>& out) {
+    putHeader(out, WireKind::TurnPlan);
+    putVarint(out, 0); // no strings
+    putVarint(out, plan.assignments.size());
+    for (const auto& a : plan.assignments) {
+        putSigned(out, a.mechId);
+        putSigned(out, a.cardId);
+        out.push_back(a.useMirror ? 1 : 0);
+    }
+}
+
+void encodeGameState(const GameState& state, std::vector<uint8_t>& out) {
+    putHeader(out, WireKind::GameState);
+    IndexScratch scratch;
+    uint16_t* index = scratch.get(state.entities.size());
+    putStringTable(out, state.entities, [](const Entity& e) -> const std::string& { return e.name; }, index);
+    putSigned(out, state.currentTurn);
+    putVarint(out, state.entities.size());
+    for (size_t i = 0; i < state.entities.size(); ++i) {
+        const Entity& e = state.entities[i];
+        putSigned(out, e.id);
+        out.push_back(static_cast<uint8_t>((static_cast<int>(e.type) & 0x0F) | ((static_cast<int>(e.facing) & 0x0F) << 4)));
+        putSigned(out, e.position.x);
+        putSigned(out, e.position.y);
+        putSigned(out, e.health);
+        putVarint(out, index[i]);
+    }
+
+    // Count runs first so the reader knows how many follow.
+    auto cellAt = [&](int i) { return state.grid.getCell(i % Grid::SIZE, i / Grid::SIZE); };
+    size_t runs = 0;
+    for (int i = 0; i < Grid::CELLS; ++i) {
+        if (i == 0 || cellAt(i) != cellAt(i - 1)) runs++;
+    }
+    putVarint(out, runs);
+    for (int i = 0; i < Grid::CELLS;) {
+        int value = cellAt(i);
+        int length = 1;
+        while (i + length < Grid::CELLS && cellAt(i + length) == value) length++;
+        putSigned(out, value);
+        putVarint(out, static_cast<uint64_t>(length));
+        i += length;
+    }
+}
+
+void decodeCardRecord(WireCursor& cursor, const WireStrings& strings, CardView& out) {
+    out.id = toInt(cursor.svarint());
+    out.name = strings.get(cursor.varint());
+    out.type = static_cast<CardType>(cursor.byte());
+    out.effect.type = out.type;
+    out.effect.move.forward = toInt(cursor.svarint());
+    out.effect.move.lateral = toInt(cursor.svarint());
+    out.effect.targetEntityId = toInt(cursor.svarint());
+    out.effect.damage = toInt(cursor.svarint());
+    out.effect.heal = toInt(cursor.svarint());
+}
+
+void decodeAssignmentRecord(WireCursor& cursor, const WireStrings&, AssignmentView& out) {
+    out.mechId = toInt(cursor.svarint());
+    out.cardId = toInt(cursor.svarint());
+    out.useMirror = cursor.byte() != 0;
+}
+
+void decodeEntityRecord(WireCursor& cursor, const WireStrings& strings, EntityView& out) {
+    out.id = toInt(cursor.svarint());
+    uint8_t typeFacing = cursor.byte();
+    out.type = static_cast<EntityType>(typeFacing & 0x0F);
+    out.facing = static_cast<Facing>(typeFacing >> 4);
+    out.x = toInt(cursor.svarint());
+    out.y = toInt(cursor.svarint());
+    out.health = toInt(cursor.svarint());
+    out.name = strings.get(cursor.varint());
+}
+
+Card CardView::toCard() const {
+    Card c;
+    c.id = id;
+    c.name = std::string(name);
+    c.type = type;
+    c.effect = effect;
+    c.mirroredEffect = mirrorEffect(effect);
+    return c;
+}
+
+bool CardWireView::parse(std::span<const uint8_t> bytes, std::string* error) {
+    WireCursor cursor(bytes);
+    if (!parseWireHeader(cursor, WireKind::Card, strings_, error)) return false;
+    WireCursor check = cursor;
+    if (!checkCard(check, strings_)) return fail(error, "Malformed card");
+    decodeCardRecord(cursor, strings_, card_);
+    return true;
+}
+
+bool HandView::parse(std::span<const uint8_t> bytes, std::string* error) {
+    WireCursor cursor(bytes);
+    if (!parseWireHeader(cursor, WireKind::Hand, strings_, error)) return false;
+    count_ = cursor.varint();
+    records_ = cursor;
+    for (size_t i = 0; i < count_; ++i) {
+        if (!checkCard(cursor, strings_)) return fail(error, "Malformed card");
+    }
+    return cursor.ok() || fail(error, "Truncated hand");
+}
+
+bool HandView::toHand(Hand& out) const {
+    out.clear();
+    for (const CardView& card : *this) {
+        CardHandle handle = findCardHandle(card.toCard());
+        if (handle == kInvalidCardHandle) return false;
+        out.addCard(handle);
+    }
+    out.resetUsage();
+    return true;
+}
+
+bool TurnPlanView::parse(std::span<const uint8_t> bytes, std::string* error) {
+    WireCursor cursor(bytes);
+    if (!parseWireHeader(cursor, WireKind::TurnPlan, strings_, error)) return false;
+    count_ = cursor.varint();
+    records_ = cursor;
+    for (size_t i = 0; i < count_ && cursor.ok(); ++i) {
+        cursor.svarint();
+        cursor.svarint();
+        cursor.byte();
+    }
+    return cursor.ok() || fail(error, "Truncated plan");
+}
+
+void TurnPlanView::toTurnPlan(TurnPlan& out) const {
+    out.assignments.clear();
+    out.assignments.reserve(count_);
+    for (const AssignmentView& a : *this) out.assignments.push_back({a.mechId, a.cardId, a.useMirror});
+}
+
+bool GameStateView::parse(std::span<const uint8_t> bytes, std::string* error) {
+    WireCursor cursor(bytes);
+    if (!parseWireHeader(cursor, WireKind::GameState, strings_, error)) return false;
+    currentTurn_ = toInt(cursor.svarint());
+    count_ = cursor.varint();
+    records_ = cursor;
+    for (size_t i = 0; i < count_ && cursor.ok(); ++i) {
+        cursor.svarint();
+        uint8_t typeFacing = cursor.byte();
+        cursor.svarint();
+        cursor.svarint();
+        cursor.svarint();
+        uint64_t name = cursor.varint();
+        if ((typeFacing & 0x0F) > OBJECT || (typeFacing >> 4) > static_cast<int>(Facing::West) || name >= strings_.size()) {
+            return fail(error, "Malformed entity");
+        }
+    }
+    runs_ = cursor.varint();
+    cells_ = cursor;
+    uint64_t covered = 0;
+    for (size_t i = 0; i < runs_ && cursor.ok(); ++i) {
+        cursor.svarint();
+        covered += cursor.varint();
+    }
+    if (!cursor.ok()) return fail(error, "Truncated game state");
+    if (covered != static_cast<uint64_t>(Grid::CELLS)) return fail(error, "Grid runs do not cover the board");
+    return true;
+}
+
+void GameStateView::copyCells(int* out) const {
+    WireCursor cursor = cells_;
+    int i = 0;
+    for (size_t r = 0; r < runs_; ++r) {
+        int value = toInt(cursor.svarint());
+        uint64_t length = cursor.varint();
+        for (uint64_t k = 0; k < length && i < Grid::CELLS; ++k) out[i++] = value;
+    }
+}
+
+void GameStateView::toGameState(GameState& out) const {
+    out.currentTurn = currentTurn_;
+    out.entities.clear();
+    out.entities.reserve(count_);
+    for (const EntityView& v : *this) {
+        Entity e{v.id, v.type, {v.x, v.y}, std::string(v.name)};
+        e.health = v.health;
+        e.facing = v.facing;
+        out.entities.push_back(e);
+    }
+    int cells[Grid::CELLS];
+    copyCells(cells);
+    for (int i = 0; i < Grid::CELLS; ++i) {
+        out.grid.setCell(i % Grid::SIZE, i / Grid::SIZE, cells[i]);
+    }
+    out.grid.syncOccupancy(out.entities);
+    out.hash = zobristHash(out);
+}
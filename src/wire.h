@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "card.h"
+
+/**
+ * Compact binary wire format for Card, Hand, TurnPlan and GameState.
+ *
+ * Every message starts with a 4-byte header: 'V' 'W', format version, message
+ * kind. A string table follows: varint count, then varint length + bytes per
+ * string. Names elsewhere in the message are varint indices into the table.
+ * Integers are LEB128 varints, and signed values are zigzag-encoded first.
+ *
+ *   Card       i id, u name, u8 type, i forward, i lateral, i target, i damage, i heal
+ *   Hand       u count, Card...
+ *   TurnPlan   u count, (i mechId, i cardId, u8 mirror)...
+ *   GameState  i turn, u count, (i id, u8 type | facing << 4, i x, i y, i health, u name)...,
+ *              u runs, (i cell, u length)...    grid cells run-length encoded, row-major
+ *
+ * Encoders append into a caller-owned buffer (cleared first), so a reused
+ * buffer stops allocating. The *View types decode straight from a read-only
+ * byte span without allocating. parse() validates the whole message once; after
+ * that, iteration cannot fail. Names come back as string_views into the span.
+ */
+
+enum class WireKind : uint8_t {
+    Card = 1,
+    Hand = 2,
+    TurnPlan = 3,
+    GameState = 4
+};
+
+constexpr uint8_t kWireVersion = 1;
+
+void encodeCard(const Card& card, std::vector<uint8_t>& out);
+void encodeHand(const Hand& hand, std::vector<uint8_t>& out);
+void encodeTurnPlan(const TurnPlan& plan, std::vector<uint8_t>& out);
+void encodeGameState(const GameState& state, std::vector<uint8_t>& out);
+
+/**
+ * Bounds-checked varint reader over a byte span. Reads past the end or
+ * malformed varints clear ok() and return 0.
+ */
+class WireCursor {
+public:
+    WireCursor() = default;
+    explicit WireCursor(std::span<const uint8_t> bytes) : bytes_(bytes) {}
+
+    uint8_t byte();
+    uint64_t varint();
+    int64_t svarint();
+    std::string_view bytesView(size_t length);
+
+    bool ok() const { return ok_; }
+    size_t offset() const { return pos_; }
+    std::span<const uint8_t> rest() const { return bytes_.subspan(pos_); }
+
+private:
+    std::span<const uint8_t> bytes_;
+    size_t pos_ = 0;
+    bool ok_ = true;
+};
+
+/** The message's string table; lookups walk the table (names are few and short). */
+class WireStrings {
+public:
+    size_t size() const { return count_; }
+    std::string_view get(size_t index) const;
+
+private:
+    friend bool parseWireHeader(WireCursor&, WireKind, WireStrings&, std::string*);
+    std::span<const uint8_t> table_; // entries after the count
+    size_t count_ = 0;
+};
+
+// Validates header + kind and reads the string table; shared by the views.
+bool parseWireHeader(WireCursor& cursor, WireKind kind, WireStrings& strings, std::string* error);
+
+struct CardView {
+    int id = 0;
+    std::string_view name;
+    CardType type = CardType::Move;
+    CardEffect effect{};
+
+    // Materialise an owning Card (allocates the name; mirroredEffect derived).
+    Card toCard() const;
+};
+
+struct AssignmentView {
+    int mechId = -1;
+    int cardId = -1;
+    bool useMirror = false;
+};
+
+struct EntityView {
+    int id = 0;
+    EntityType type = PLAYER;
+    Facing facing = Facing::North;
+    int x = 0;
+    int y = 0;
+    int health = 0;
+    std::string_view name;
+};
+
+/**
+ * Forward iterator that decodes one record per step. Record decoders are
+ * plain functions, so every view shares the same iterator.
+ */
+template <typename T, void (*Decode)(WireCursor&, const WireStrings&, T&)>
+class WireIterator {
+public:
+    WireIterator(WireCursor cursor, const WireStrings* strings, size_t remaining)
+        : cursor_(cursor), strings_(strings), remaining_(remaining) {
+        if (remaining_ > 0) Decode(cursor_, *strings_, current_);
+    }
+    const T& operator*() const { return current_; }
+    const T* operator->() const { return &current_; }
+    WireIterator& operator++() {
+        if (--remaining_ > 0) Decode(cursor_, *strings_, current_);
+        return *this;
+    }
+    bool operator==(const WireIterator& other) const { return remaining_ == other.remaining_; }
+    bool operator!=(const WireIterator& other) const { return remaining_ != other.remaining_; }
+
+private:
+    WireCursor cursor_;
+    const WireStrings* strings_;
+    size_t remaining_; // records left, including the current one
+    T current_{};
+};
+
+void decodeCardRecord(WireCursor& cursor, const WireStrings& strings, CardView& out);
+void decodeAssignmentRecord(WireCursor& cursor, const WireStrings& strings, AssignmentView& out);
+void decodeEntityRecord(WireCursor& cursor, const WireStrings& strings, EntityView& out);
+
+// A single encoded Card.
+class CardWireView {
+public:
+    bool parse(std::span<const uint8_t> bytes, std::string* error = nullptr);
+    const CardView& card() const { return card_; }
+
+private:
+    WireStrings strings_;
+    CardView card_;
+};
+
+// Range of cards in an encoded Hand.
+class HandView {
+public:
+    using iterator = WireIterator<CardView, decodeCardRecord>;
+
+    bool parse(std::span<const uint8_t> bytes, std::string* error = nullptr);
+    size_t size() const { return count_; }
+    iterator begin() const { return iterator(records_, &strings_, count_); }
+    iterator end() const { return iterator(records_, &strings_, 0); }
+    // Rebuild an owning Hand from registered cards; false if a card is not in the registry.
+    bool toHand(Hand& out) const;
+
+private:
+    WireStrings strings_;
+    WireCursor records_;
+    size_t count_ = 0;
+};
+
+// Range of assignments in an encoded TurnPlan.
+class TurnPlanView {
+public:
+    using iterator = WireIterator<AssignmentView, decodeAssignmentRecord>;
+
+    bool parse(std::span<const uint8_t> bytes, std::string* error = nullptr);
+    size_t size() const { return count_; }
+    iterator begin() const { return iterator(records_, &strings_, count_); }
+    iterator end() const { return iterator(records_, &strings_, 0); }
+    void toTurnPlan(TurnPlan& out) const;
+
+private:
+    WireStrings strings_;
+    WireCursor records_;
+    size_t count_ = 0;
+};
+
+// Entities plus run-length grid cells of an encoded GameState.
+class GameStateView {
+public:
+    using iterator = WireIterator<EntityView, decodeEntityRecord>;
+
+    bool parse(std::span<const uint8_t> bytes, std::string* error = nullptr);
+    int currentTurn() const { return currentTurn_; }
+    size_t entityCount() const { return count_; }
+    iterator begin() const { return iterator(records_, &strings_, count_); }
+    iterator end() const { return iterator(records_, &strings_, 0); }
+    // Expand the grid cells into out (Grid::CELLS entries, row-major).
+    void copyCells(int* out) const;
+    void toGameState(GameState& out) const;
+
+private:
+    WireStrings strings_;
+    WireCursor records_;
+    WireCursor cells_;
+    size_t count_ = 0;
+    size_t runs_ = 0;
+    int currentTurn_ = 0;
+};
@@ -139,16 +139,14 @@ static void PlaceActorsFromOccupants(World& world, const AppContext& appCtx) {
         return p;
     };
     
-    static Mesh mechVariants[3] = { 0 };
-    static bool mechInit[3] = { false, false, false };
-    const char* variantNames[3] = { "alpha", "bravo", "charlie" };
+    // All three variants are built together so their configs load in parallel
+    static std::vector<Mesh> mechVariants;
+    if (mechVariants.empty()) {
+        mechVariants = CreateMechMeshes({ "alpha", "bravo", "charlie" });
+    }
 
     auto getVariantMesh = [&](int variantIdx) -> Mesh {
         if (variantIdx < 0 || variantIdx >= 3) variantIdx = 1; // default to bravo
-        if (!mechInit[variantIdx]) {
-            mechVariants[variantIdx] = CreateMechMesh(variantNames[variantIdx]);
-            mechInit[variantIdx] = true;
-        }
         return mechVariants[variantIdx];
     };
 
@@ -286,7 +284,7 @@ void World_Update(World& world, float elapsedTime) {
         entity.position = entity.targetPos;
     }
 }
-void World_DrawGround(const World& world, const AppContext& appCtx) {
+void World_DrawGround(const World& world, const AppContext& appCtx, RenderStats* stats) {
     auto idx = [](int x, int y) { return y * World::kTilesWide + x; };
 
     // Build a reusable tile model once to ensure the flat shader is applied (matte, no specular)
@@ -313,6 +311,7 @@ void World_DrawGround(const World& world, const AppContext& appCtx) {
 
             // Draw using the flat shader (matte) with non-uniform scale
             DrawModelEx(tileModel, pos, Vector3{0, 1, 0}, 0.0f, size, c);
+            if (stats) stats->countModel(tileModel);
 
             // Outline removed to avoid bright edges when using default wireframe shader
         }
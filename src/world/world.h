@@ -5,6 +5,7 @@
 #include "rlights.h" // For Light type and MAX_LIGHTS
 
 struct AppContext; // forward
+struct RenderStats;
 
 // Tile definitions for an 8x8 board
 enum class TileType {
@@ -88,4 +89,4 @@ void World_Init(World& world, const AppContext& appCtx);
 void World_Update(World& world, float elapsedTime);
 
 // Draw ground/grid for the world
-void World_DrawGround(const World& world, const AppContext& appCtx);
\ No newline at end of file
+void World_DrawGround(const World& world, const AppContext& appCtx, RenderStats* stats = nullptr);
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "zobrist.h"
+#include "card.h"
+#include "grid.h"
+#include <algorithm>
+#include <array>
+
+namespace {
+
+struct ZobristKeys {
+    std::array<uint64_t, kZobristSlots * Grid::CELLS> cells{};
+    std::array<uint64_t, kZobristSlots * 4> facings{};
+    std::array<uint64_t, kZobristSlots * kZobristHealthBuckets> health{};
+    std::array<uint64_t, kZobristTurns> turns{};
+};
+
+// Fixed seed so hashes are identical across runs and machines (replays, TT dumps).
+const ZobristKeys& keys() {
+    static const ZobristKeys table = [] {
+        ZobristKeys k;
+        uint64_t s = 0x5652415953454544ull;
+        auto next = [&s] {
+            uint64_t z = (s += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        };
+        for (auto& v : k.cells) v = next();
+        for (auto& v : k.facings) v = next();
+        for (auto& v : k.health) v = next();
+        for (auto& v : k.turns) v = next();
+        return k;
+    }();
+    return table;
+}
+
+int healthBucket(int health) {
+    return std::clamp(health / 10, 0, kZobristHealthBuckets - 1);
+}
+
+} // namespace
+
+uint64_t zobristCellKey(int slot, int x, int y) {
+    if (slot < 0 || slot >= kZobristSlots || x < 0 || x >= Grid::SIZE || y < 0 || y >= Grid::SIZE) {
+        return 0;
+    }
+    return keys().cells[slot * Grid::CELLS + Grid::cellIndex(x, y)];
+}
+
+uint64_t zobristFacingKey(int slot, Facing facing) {
+    if (slot < 0 || slot >= kZobristSlots) return 0;
+    return keys().facings[slot * 4 + (static_cast<int>(facing) & 3)];
+}
+
+uint64_t zobristHealthKey(int slot, int health) {
+    if (slot < 0 || slot >= kZobristSlots) return 0;
+    return keys().health[slot * kZobristHealthBuckets + healthBucket(health)];
+}
+
+uint64_t zobristTurnKey(int turn) {
+    return keys().turns[static_cast<unsigned>(turn) % kZobristTurns];
+}
+
+uint64_t zobristHash(const GameState& state) {
+    uint64_t h = zobristTurnKey(state.currentTurn);
+    int slots = std::min(static_cast<int>(state.entities.size()), kZobristSlots);
+    for (int i = 0; i < slots; ++i) {
+        const Entity& e = state.entities[i];
+        h ^= zobristCellKey(i, e.position.x, e.position.y);
+        h ^= zobristFacingKey(i, e.facing);
+        h ^= zobristHealthKey(i, e.health);
+    }
+    return h;
+}
+
+void zobristAdvanceTurn(GameState& state) {
+    state.hash ^= zobristTurnKey(state.currentTurn);
+    state.currentTurn++;
+    state.hash ^= zobristTurnKey(state.currentTurn);
+}
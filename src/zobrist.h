@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include "entity.h"
+
+struct GameState;
+
+/**
+ * Zobrist hashing for GameState.
+ *
+ * Keys are per entity slot (index in GameState::entities, which resolution never
+ * reorders) for cell, facing and health bucket, plus one key per turn (mod 64).
+ * Card resolution xors keys in and out as it moves or damages entities, so
+ * GameState::hash stays current without a full recompute.
+ */
+constexpr int kZobristSlots = 16;        // entities beyond this are not hashed
+constexpr int kZobristHealthBuckets = 11; // 0-9, 10-19, ... 100+
+constexpr int kZobristTurns = 64;
+
+uint64_t zobristCellKey(int slot, int x, int y);
+uint64_t zobristFacingKey(int slot, Facing facing);
+uint64_t zobristHealthKey(int slot, int health);
+uint64_t zobristTurnKey(int turn);
+
+// Full recompute; use to seed GameState::hash or to verify incremental updates.
+uint64_t zobristHash(const GameState& state);
+
+// Advance state.currentTurn and fold the change into state.hash.
+void zobristAdvanceTurn(GameState& state);
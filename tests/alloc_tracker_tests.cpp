@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include "common/alloc_tracker.h"
+#include "common/arena.h"
+#include "boss/bossPlayState.h"
+#include "sim/batch_env.h"
+#include "card.h"
+#include "cardRegistry.h"
+#include "game.h"
+#include "ui.h"
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Keeps the optimiser from eliding a new/delete pair.
+void* volatile gEscape = nullptr;
+
+// Turns global tracking on for one test and back off afterwards.
+struct TrackingOn {
+    TrackingOn() { allocTrackingSetEnabled(true); }
+    ~TrackingOn() { allocTrackingSetEnabled(false); }
+};
+
+} // namespace
+
+TEST(AllocTracker, ScopeCountsOwnThread) {
+    AllocScope scope;
+    auto p = std::make_unique<std::string>(100, 'x');
+    gEscape = p.get();
+    AllocCounts c = scope.counts();
+    EXPECT_EQ(c.allocations, 2u); // the string object and its buffer
+    EXPECT_GE(c.bytes, 100u + sizeof(std::string));
+    EXPECT_EQ(c.frees, 0u);
+    p.reset();
+    EXPECT_EQ(scope.counts().frees, 2u);
+
+    // Another thread's allocations belong to that thread.
+    uint64_t before = scope.counts().allocations;
+    std::thread([] { gEscape = new int[8]; delete[] static_cast<int*>(gEscape); }).join();
+    EXPECT_LE(scope.counts().allocations - before, 1u); // at most std::thread's launch state
+}
+
+TEST(AllocTracker, NestedScopesAreInclusive) {
+    AllocScope outer;
+    int* p = new int(1);
+    gEscape = p;
+    {
+        AllocScope inner;
+        int* q = new int(2);
+        gEscape = q;
+        EXPECT_EQ(inner.counts().allocations, 1u);
+        delete q;
+    }
+    EXPECT_EQ(outer.counts().allocations, 2u);
+    delete p;
+    EXPECT_EQ(outer.counts().frees, 2u);
+}
+
+TEST(AllocTracker, FramesCollectNamedScopes) {
+    TrackingOn on;
+    allocFrameBegin();
+    {
+        AllocScope scope("update");
+        gEscape = new char[64];
+        delete[] static_cast<char*>(gEscape);
+    }
+    {
+        AllocScope scope("update");
+        gEscape = new char[32];
+        delete[] static_cast<char*>(gEscape);
+    }
+    {
+        AllocScope scope("draw");
+    }
+    allocFrameBegin();
+
+    const AllocFrameStats& frame = allocLastFrame();
+    EXPECT_GE(frame.total.allocations, 2u);
+    ASSERT_EQ(frame.scopeCount, 2);
+    EXPECT_STREQ(frame.scopes[0].name, "update");
+    EXPECT_EQ(frame.scopes[0].counts.allocations, 2u);
+    EXPECT_EQ(frame.scopes[0].counts.bytes, 96u);
+    EXPECT_STREQ(frame.scopes[1].name, "draw");
+    EXPECT_EQ(frame.scopes[1].counts.allocations, 0u);
+    EXPECT_GE(frame.peak.allocations, frame.total.allocations);
+
+    // The next frame starts from an empty table.
+    allocFrameBegin();
+    EXPECT_EQ(allocLastFrame().scopeCount, 0);
+    EXPECT_GT(allocLastFrame().frame, frame.frame - 1);
+}
+
+TEST(AllocTracker, DisabledTrackingLeavesTotalsAlone) {
+    allocTrackingSetEnabled(false);
+    AllocCounts before = allocTotals();
+    gEscape = new int(3);
+    delete static_cast<int*>(gEscape);
+    AllocCounts after = allocTotals();
+    EXPECT_EQ(after.allocations, before.allocations);
+    EXPECT_EQ(after.frees, before.frees);
+}
+
+TEST(AllocTracker, IdleUpdateDoesNotAllocate) {
+    Game game;
+    init_game(game);
+    update_game(game, 1.0f / 60.0f);
+
+    AllocScope scope;
+    for (int frame = 0; frame < 60; ++frame) update_game(game, 1.0f / 60.0f);
+    EXPECT_EQ(scope.counts().allocations, 0u);
+}
+
+TEST(AllocTracker, ArenaResolvedTurnDoesNotAllocate) {
+    Game game;
+    init_game(game);
+    const GameState root = take_state(game);
+    const Card& advance = cardByHandle(builtinCardHandle(0));
+    Arena arena;
+    {
+        ArenaScope warm(arena); // first pass grows the arena
+        GameState next = applyCard(root, advance, 1, false, &arena);
+        next = applyCard(next, advance, 2, false, &arena);
+    }
+
+    AllocScope scope;
+    for (int i = 0; i < 16; ++i) {
+        ArenaScope scratch(arena);
+        GameState next = applyCard(root, advance, 1, false, &arena);
+        next = applyCard(next, advance, 2, false, &arena);
+    }
+    EXPECT_EQ(scope.counts().allocations, 0u);
+}
+
+TEST(AllocTracker, PlaySubphasesDoNotAllocate) {
+    Game game;
+    init_game(game);
+    game.currentPlan.assignments = {{1, 1, false}, {2, 4, false}, {3, 3, true}};
+    game.lastAiPlan.assignments = {{4, 1, false}, {5, 6, true}, {6, 2, false}};
+
+    BossPlayState play;
+    play.enter(game);
+    CardActions actions;
+    play.update(game, actions, 0.5f); // first subphase sizes the resolver scratch
+
+    {
+        AllocScope scope;
+        play.update(game, actions, 0.5f);
+        EXPECT_EQ(scope.counts().allocations, 0u);
+    }
+    play.update(game, actions, 0.5f); // last subphase also builds the next state
+    EXPECT_TRUE(play.canExit(game));
+}
+
+TEST(AllocTracker, BatchStepDoesNotAllocate) {
+    Game game;
+    init_game(game);
+    BatchEnv env(32, game.hand.cardList());
+    ASSERT_TRUE(env.resetAll(take_state(game)));
+    std::vector<TurnPlan> player(env.size());
+    std::vector<TurnPlan> npc(env.size());
+    for (TurnPlan& p : player) p.assignments = {{1, 1, false}, {2, 4, true}};
+    for (TurnPlan& p : npc) p.assignments = {{4, 2, false}};
+    std::vector<float> rewards(env.size());
+    std::vector<uint8_t> done(env.size());
+    std::vector<float> obs(env.size() * BatchEnv::kObservationSize);
+
+    AllocScope scope;
+    for (int turn = 0; turn < 10; ++turn) {
+        env.step(player, npc, rewards, done);
+        env.observe(obs);
+    }
+    EXPECT_EQ(scope.counts().allocations, 0u);
+}
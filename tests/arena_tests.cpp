@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include "common/arena.h"
+#include "ai/npc_planner.h"
+#include "card.h"
+#include "cardRegistry.h"
+#include "game.h"
+#include "zobrist.h"
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+// Counts upstream traffic so tests can tell the arena stopped asking for blocks.
+class CountingResource : public std::pmr::memory_resource {
+public:
+    int allocations = 0;
+    int deallocations = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        allocations++;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        deallocations++;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+} // namespace
+
+TEST(Arena, AllocationsAreAlignedAndDistinct) {
+    Arena arena(1024);
+    void* a = arena.allocate(3, 1);
+    void* b = arena.allocate(8, 8);
+    void* c = arena.allocate(64, 64);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 8, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(c) % 64, 0u);
+    EXPECT_GE(arena.bytesUsed(), 3u + 8u + 64u);
+}
+
+TEST(Arena, ResetKeepsBlocksAndPeak) {
+    CountingResource upstream;
+    Arena arena(4096, &upstream);
+    for (int i = 0; i < 100; ++i) ASSERT_NE(arena.allocate(100, 8), nullptr);
+    size_t peak = arena.peakBytes();
+    int grown = upstream.allocations;
+    EXPECT_GT(grown, 1);
+
+    arena.reset();
+    EXPECT_EQ(arena.bytesUsed(), 0u);
+    EXPECT_EQ(arena.peakBytes(), peak);
+    EXPECT_EQ(arena.stats().resets, 1u);
+
+    // The same decision again fits in the blocks already held.
+    for (int i = 0; i < 100; ++i) ASSERT_NE(arena.allocate(100, 8), nullptr);
+    EXPECT_EQ(upstream.allocations, grown);
+    EXPECT_EQ(upstream.deallocations, 0);
+
+    arena.release();
+    EXPECT_EQ(upstream.deallocations, grown);
+    EXPECT_EQ(arena.stats().bytesReserved, 0u);
+}
+
+TEST(Arena, OversizedRequestGetsItsOwnBlock) {
+    Arena arena(256);
+    void* big = arena.allocate(10000, 16);
+    ASSERT_NE(big, nullptr);
+    EXPECT_GE(arena.stats().bytesReserved, 10000u);
+    std::pmr::vector<int> v(&arena);
+    for (int i = 0; i < 1000; ++i) v.push_back(i);
+    EXPECT_EQ(v[999], 999);
+}
+
+TEST(Arena, ScopeResetsOnExit) {
+    Arena arena;
+    {
+        ArenaScope scope(arena);
+        std::pmr::vector<int> v(100, 7, &arena);
+        EXPECT_GT(arena.bytesUsed(), 0u);
+    }
+    EXPECT_EQ(arena.bytesUsed(), 0u);
+    EXPECT_GT(arena.peakBytes(), 0u);
+}
+
+TEST(Arena, ApplyCardOnArenaMatchesHeapResult) {
+    Game game;
+    init_game(game);
+    GameState root = take_state(game);
+    const Card& advance = cardByHandle(builtinCardHandle(0));
+
+    Arena arena;
+    GameState heap = applyCard(root, advance, 1);
+    {
+        ArenaScope scope(arena);
+        GameState branch = applyCard(root, advance, 1, false, &arena);
+        EXPECT_EQ(branch.entities.resource(), &arena);
+        EXPECT_GT(arena.bytesUsed(), 0u);
+        ASSERT_EQ(branch.entities.size(), heap.entities.size());
+        for (size_t i = 0; i < heap.entities.size(); ++i) {
+            EXPECT_EQ(branch.entities[i].position, heap.entities[i].position);
+        }
+        EXPECT_EQ(branch.hash, heap.hash);
+
+        // Forks of an arena state stay on the arena.
+        GameState next = applyCard(branch, advance, 1);
+        EXPECT_EQ(next.entities.resource(), &arena);
+        EXPECT_EQ(next.hash, zobristHash(next));
+    }
+    EXPECT_EQ(arena.bytesUsed(), 0u);
+    EXPECT_EQ(root.hash, zobristHash(root));
+}
+
+TEST(Arena, PlannerReportsScratchAndStopsGrowing) {
+    Game game;
+    init_game(game);
+    PlannerInput input = makePlannerInput(game);
+    ExpectimaxNpcPlanner planner;
+    PlannerBudget budget;
+    budget.milliseconds = 1000.0;
+
+    PlannerStats first;
+    TurnPlan a = planner.plan(input, budget, &first);
+    PlannerStats second;
+    TurnPlan b = planner.plan(input, budget, &second);
+
+    EXPECT_GT(first.arenaPeakBytes, 0u);
+    EXPECT_EQ(first.arenaPeakBytes, second.arenaPeakBytes);
+    ASSERT_EQ(a.assignments.size(), b.assignments.size());
+    for (size_t i = 0; i < a.assignments.size(); ++i) {
+        EXPECT_EQ(a.assignments[i].mechId, b.assignments[i].mechId);
+        EXPECT_EQ(a.assignments[i].cardId, b.assignments[i].cardId);
+    }
+}
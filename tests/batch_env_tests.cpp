@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+#include "sim/batch_env.h"
+#include "game.h"
+#include "zobrist.h"
+#include <random>
+#include <vector>
+
+namespace {
+
+Card effectCard(int id, CardEffect effect) {
+    Card c;
+    c.id = id;
+    c.type = effect.type;
+    c.effect = effect;
+    c.mirroredEffect = mirrorEffect(effect);
+    return c;
+}
+
+// Builtin moves plus a long move and cards aimed at both sides.
+std::vector<Card> testHand(const Game& game) {
+    std::vector<Card> hand = game.hand.cardList();
+    CardEffect longMove;
+    longMove.type = CardType::Move;
+    longMove.move = {3, -2};
+    hand.push_back(effectCard(20, longMove));
+    CardEffect hitEnemy;
+    hitEnemy.type = CardType::Damage;
+    hitEnemy.targetEntityId = 4;
+    hitEnemy.damage = 40;
+    hand.push_back(effectCard(21, hitEnemy));
+    CardEffect hitPlayer = hitEnemy;
+    hitPlayer.targetEntityId = 1;
+    hitPlayer.damage = 70;
+    hand.push_back(effectCard(22, hitPlayer));
+    CardEffect heal;
+    heal.type = CardType::Heal;
+    heal.heal = 30;
+    hand.push_back(effectCard(23, heal));
+    return hand;
+}
+
+// Up to three assignments for random mechs (unknown ids and cards included).
+TurnPlan randomPlan(std::mt19937& rng, const GameState& state, const std::vector<Card>& hand) {
+    TurnPlan plan;
+    int count = static_cast<int>(rng() % 4);
+    for (int i = 0; i < count; ++i) {
+        int mechId = rng() % 10 == 0 ? 99 : state.entities[rng() % state.entities.size()].id;
+        int cardId = rng() % 12 == 0 ? -5 : hand[rng() % hand.size()].id;
+        plan.assignments.push_back({mechId, cardId, (rng() & 1) != 0});
+    }
+    return plan;
+}
+
+// Scattered, crowded start: random cells (some stacked, some off the board),
+// facings and health.
+GameState randomStart(std::mt19937& rng, const GameState& base) {
+    GameState state = base;
+    for (size_t i = 0; i < state.entities.size(); ++i) {
+        Entity& e = state.entities.edit(i);
+        e.position = {static_cast<int>(rng() % 6) + 3, static_cast<int>(rng() % 6) + 3};
+        if (rng() % 16 == 0) e.position.x = -2;
+        e.facing = static_cast<Facing>(rng() % 4);
+        e.health = 20 + static_cast<int>(rng() % 81);
+    }
+    state.grid.syncOccupancy(state.entities);
+    state.hash = zobristHash(state);
+    return state;
+}
+
+// The scalar reference: every assignment through applyCard.
+void scalarPlay(GameState& state, const std::vector<Card>& hand, const TurnPlan& plan) {
+    for (const auto& a : plan.assignments) {
+        for (const Card& c : hand) {
+            if (c.id == a.cardId) {
+                state = applyCard(state, c, a.mechId, a.useMirror);
+                break;
+            }
+        }
+    }
+}
+
+bool sideAlive(const GameState& state, EntityType side) {
+    for (const Entity& e : state.entities) {
+        if (e.type == side && e.health > 0) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+TEST(BatchEnv, MatchesScalarApplyCard) {
+    Game game;
+    init_game(game);
+    const GameState base = take_state(game);
+    const std::vector<Card> hand = testHand(game);
+    constexpr size_t kGames = 64;
+    constexpr int kTurns = 25;
+
+    BatchEnvConfig config;
+    config.maxTurns = kTurns;
+    BatchEnv env(kGames, hand, config);
+    std::mt19937 rng(11);
+    std::vector<GameState> scalar;
+    for (size_t g = 0; g < kGames; ++g) {
+        scalar.push_back(randomStart(rng, base));
+        ASSERT_TRUE(env.reset(g, scalar.back()));
+    }
+
+    std::vector<TurnPlan> player(kGames);
+    std::vector<TurnPlan> npc(kGames);
+    std::vector<uint8_t> done(kGames);
+    for (int turn = 0; turn < kTurns; ++turn) {
+        for (size_t g = 0; g < kGames; ++g) {
+            player[g] = randomPlan(rng, scalar[g], hand);
+            npc[g] = randomPlan(rng, scalar[g], hand);
+        }
+        std::vector<bool> live(kGames);
+        for (size_t g = 0; g < kGames; ++g) live[g] = !env.done(g);
+        env.step(player, npc, {}, done);
+
+        for (size_t g = 0; g < kGames; ++g) {
+            if (!live[g]) continue;
+            scalarPlay(scalar[g], hand, player[g]);
+            scalarPlay(scalar[g], hand, npc[g]);
+            scalar[g].currentTurn++;
+            bool over = !sideAlive(scalar[g], PLAYER) || !sideAlive(scalar[g], ENEMY) || turn + 1 == kTurns;
+            EXPECT_EQ(done[g] != 0, over) << "game " << g << " turn " << turn;
+
+            GameState batch;
+            env.exportState(g, batch);
+            ASSERT_EQ(batch.entities.size(), scalar[g].entities.size());
+            for (size_t i = 0; i < batch.entities.size(); ++i) {
+                EXPECT_EQ(batch.entities[i].position, scalar[g].entities[i].position) << "game " << g << " turn " << turn;
+                EXPECT_EQ(batch.entities[i].health, scalar[g].entities[i].health) << "game " << g << " turn " << turn;
+            }
+            EXPECT_EQ(batch.hash, zobristHash(scalar[g]));
+        }
+    }
+}
+
+TEST(BatchEnv, RewardsFollowHealthBalance) {
+    Game game;
+    init_game(game);
+    const std::vector<Card> hand = testHand(game);
+    BatchEnv env(2, hand);
+    ASSERT_TRUE(env.resetAll(take_state(game)));
+
+    std::vector<TurnPlan> player(2);
+    std::vector<TurnPlan> npc(2);
+    player[0].assignments.push_back({1, 21, false}); // enemy 4 takes 40
+    npc[1].assignments.push_back({4, 22, false});    // player 1 takes 70
+    std::vector<float> rewards(2);
+    std::vector<uint8_t> done(2);
+    env.step(player, npc, rewards, done);
+
+    EXPECT_FLOAT_EQ(rewards[0], 0.4f);
+    EXPECT_FLOAT_EQ(rewards[1], -0.7f);
+    EXPECT_EQ(done[0], 0);
+    EXPECT_EQ(env.turn(0), 1);
+}
+
+TEST(BatchEnv, ObservationLayout) {
+    Game game;
+    init_game(game);
+    GameState state = take_state(game);
+    BatchEnv env(3, testHand(game));
+    ASSERT_TRUE(env.resetAll(state));
+
+    std::vector<float> obs(env.size() * BatchEnv::kObservationSize, -1.0f);
+    env.observe(obs);
+    const float* g1 = obs.data() + BatchEnv::kObservationSize;
+    // Slot 3 is enemy 4 at (6, 6) facing South with full health.
+    const float* slot = g1 + 3 * BatchEnv::kSlotFeatures;
+    EXPECT_EQ(slot[0], 1.0f);
+    EXPECT_EQ(slot[1 + ENEMY], 1.0f);
+    EXPECT_FLOAT_EQ(slot[4], 6.0f / 11.0f);
+    EXPECT_FLOAT_EQ(slot[5], 6.0f / 11.0f);
+    EXPECT_EQ(slot[6 + static_cast<int>(Facing::South)], 1.0f);
+    EXPECT_EQ(slot[10], 1.0f);
+    // Unused slots are zero.
+    const float* empty = g1 + static_cast<int>(state.entities.size()) * BatchEnv::kSlotFeatures;
+    for (int f = 0; f < BatchEnv::kSlotFeatures; ++f) EXPECT_EQ(empty[f], 0.0f);
+    EXPECT_EQ(g1[BatchEnv::kObservationSize - 1], 0.0f);
+}
+
+TEST(BatchEnv, DoneGamesIgnorePlansUntilReset) {
+    Game game;
+    init_game(game);
+    GameState state = take_state(game);
+    for (size_t i = 0; i < state.entities.size(); ++i) {
+        if (state.entities[i].type == ENEMY) state.entities.edit(i).health = 0;
+    }
+    BatchEnv env(1, testHand(game));
+    ASSERT_TRUE(env.reset(0, state));
+    EXPECT_TRUE(env.done(0));
+
+    std::vector<TurnPlan> plans(1);
+    plans[0].assignments.push_back({1, 1, false});
+    std::vector<float> rewards(1, 5.0f);
+    env.step(plans, plans, rewards);
+    GameState after;
+    env.exportState(0, after);
+    EXPECT_EQ(after.entities[0].position, state.entities[0].position);
+    EXPECT_EQ(rewards[0], 0.0f);
+    EXPECT_EQ(env.turn(0), 0);
+}
+
+TEST(BatchEnv, RejectsStatesThatDoNotFit) {
+    GameState crowded;
+    for (int i = 0; i < BatchEnv::kMaxEntities + 1; ++i) {
+        crowded.entities.push_back(Entity{i + 1, PLAYER, {i, 0}, "Mech"});
+    }
+    BatchEnv env(1, {});
+    std::string error;
+    EXPECT_FALSE(env.reset(0, crowded, &error));
+    EXPECT_FALSE(error.empty());
+
+    GameState far;
+    far.entities.push_back(Entity{1, PLAYER, {500, 0}, "Mech"});
+    EXPECT_FALSE(env.reset(0, far, &error));
+}
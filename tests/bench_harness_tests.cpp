@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "bench_harness.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+BenchResult result(const std::string& name, std::vector<double> samples, double thresholdPct = 0.0) {
+    BenchResult r;
+    r.name = name;
+    r.iterations = 100;
+    r.samples = std::move(samples);
+    r.medianNs = benchMedian(r.samples);
+    r.madNs = benchMad(r.samples);
+    r.minNs = r.samples.empty() ? 0.0 : r.samples.front();
+    r.thresholdPct = thresholdPct;
+    return r;
+}
+
+const BenchComparison* find(const std::vector<BenchComparison>& comparisons, const std::string& name) {
+    for (const BenchComparison& c : comparisons) {
+        if (c.name == name) return &c;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+TEST(BenchHarness, MedianAndMad) {
+    EXPECT_DOUBLE_EQ(benchMedian({}), 0.0);
+    EXPECT_DOUBLE_EQ(benchMedian({5, 1, 3}), 3.0);
+    EXPECT_DOUBLE_EQ(benchMedian({4, 1, 3, 2}), 2.5);
+    // Deviations from 3 are {2, 1, 0, 1, 97}: one outlier does not move the MAD.
+    EXPECT_DOUBLE_EQ(benchMad({1, 2, 3, 4, 100}), 1.0);
+}
+
+TEST(BenchHarness, JsonRoundTrip) {
+    std::vector<BenchResult> in = {result("applyCard", {101.5, 99.25, 100.0}, 25.0), result("parse \"lua\"", {7.0})};
+    std::string json;
+    writeBenchJson(in, json);
+
+    std::vector<BenchResult> out;
+    std::string error;
+    ASSERT_TRUE(readBenchJson(json, out, &error)) << error;
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(out[0].name, "applyCard");
+    EXPECT_EQ(out[0].iterations, 100);
+    EXPECT_EQ(out[0].samples, in[0].samples);
+    EXPECT_DOUBLE_EQ(out[0].medianNs, 100.0);
+    EXPECT_DOUBLE_EQ(out[0].minNs, 99.25);
+    EXPECT_DOUBLE_EQ(out[0].thresholdPct, 25.0);
+    EXPECT_EQ(out[1].name, "parse \"lua\"");
+    EXPECT_DOUBLE_EQ(out[1].thresholdPct, 0.0);
+}
+
+TEST(BenchHarness, ReadRejectsMalformedInput) {
+    std::vector<BenchResult> out;
+    std::string error;
+    EXPECT_FALSE(readBenchJson("{\"benchmarks\":[{\"name\":\"a\",", out, &error));
+    EXPECT_FALSE(error.empty());
+    error.clear();
+    EXPECT_FALSE(readBenchJson("{\"benchmarks\":[{\"median_ns\":1}]}", out, &error));
+    EXPECT_FALSE(error.empty());
+    // Unknown keys are skipped.
+    EXPECT_TRUE(readBenchJson("{\"schema\":1,\"host\":{\"cpu\":\"x\"},\"benchmarks\":[]}", out));
+}
+
+TEST(BenchHarness, FlagsRegressionsPastThresholdAndNoise) {
+    std::vector<BenchResult> baseline = {result("steady", {100, 101, 99, 100, 100}),
+                                         result("noisy", {100, 140, 60, 100, 120}),
+                                         result("loose", {100, 100, 100}, 50.0)};
+    std::vector<BenchResult> current = {result("steady", {120, 121, 119, 120, 120}),
+                                        result("noisy", {125, 165, 85, 125, 145}),
+                                        result("loose", {140, 140, 140})};
+    std::vector<BenchComparison> comparisons = compareBench(baseline, current);
+    ASSERT_EQ(comparisons.size(), 3u);
+
+    const BenchComparison* steady = find(comparisons, "steady");
+    ASSERT_NE(steady, nullptr);
+    EXPECT_EQ(steady->verdict, BenchVerdict::Regressed);
+    EXPECT_DOUBLE_EQ(steady->changePct, 20.0);
+    // +25% but well inside three robust sigmas of a 20ns MAD.
+    EXPECT_EQ(find(comparisons, "noisy")->verdict, BenchVerdict::Same);
+    // +40% against its own 50% threshold.
+    EXPECT_EQ(find(comparisons, "loose")->verdict, BenchVerdict::Same);
+    EXPECT_DOUBLE_EQ(find(comparisons, "loose")->thresholdPct, 50.0);
+    EXPECT_TRUE(anyRegressed(comparisons));
+
+    BenchCompareOptions strict;
+    strict.thresholdPct = 30.0;
+    EXPECT_FALSE(anyRegressed(compareBench(baseline, current, strict)));
+}
+
+TEST(BenchHarness, ReportsFasterNewAndMissing) {
+    std::vector<BenchResult> baseline = {result("a", {100, 100, 100}), result("gone", {5})};
+    std::vector<BenchResult> current = {result("a", {50, 50, 50}), result("added", {9})};
+    std::vector<BenchComparison> comparisons = compareBench(baseline, current);
+    EXPECT_EQ(find(comparisons, "a")->verdict, BenchVerdict::Faster);
+    EXPECT_EQ(find(comparisons, "added")->verdict, BenchVerdict::New);
+    EXPECT_EQ(find(comparisons, "gone")->verdict, BenchVerdict::Missing);
+    EXPECT_FALSE(anyRegressed(comparisons));
+
+    BenchCompareOptions filtered;
+    filtered.reportMissing = false;
+    EXPECT_EQ(find(compareBench(baseline, current, filtered), "gone"), nullptr);
+}
@@ -6,8 +6,7 @@
 TEST(BossPlay, SkipsEmptyPlansImmediately) {
     Game game;
     init_game(game);
-    game.hand.cards.clear();
-    game.hand.resetUsage();
+    game.hand.clear();
 
     Boss boss;
     boss.begin(game);
@@ -30,13 +29,13 @@ TEST(BossPlay, FinishesWhenActionsRemainBlocked) {
     init_game(game);
 
     // Place an obstacle directly in front of mech 1 to force a blocked move
-    game.entities.push_back(Entity{100, OBJECT, {1.0f, 7.0f}, "Blocker"});
+    game.entities.push_back(Entity{100, OBJECT, {1, 7}, "Blocker"});
 
     Boss boss;
     boss.begin(game);
 
     // Build a single-player plan that tries to move into the blocked tile
-    PlanAssignment moveForward{1, game.hand.cards.front().id, false};
+    PlanAssignment moveForward{1, game.hand.cards().front().id, false};
     game.currentPlan.assignments = {moveForward};
 
     CardActions actions;
@@ -2,35 +2,9 @@
 #include "card.h"
 #include "grid.h"
 #include "entity.h"
+#include "test_fixtures.h"
 #include <string>
 
-namespace {
-
-GameState makeState(const Vector2& playerPos, Facing facing = Facing::North, const std::vector<Entity>& extras = {}) {
-    GameState gs;
-    gs.grid = Grid();
-    gs.entities.clear();
-    Entity player{1, PLAYER, playerPos, "Player"};
-    player.facing = facing;
-    gs.entities.push_back(player);
-    gs.entities.insert(gs.entities.end(), extras.begin(), extras.end());
-    return gs;
-}
-
-Card makeMoveCard(int id, const char* name, int fwd, int lat) {
-    Card c;
-    c.id = id;
-    c.name = name;
-    c.type = CardType::Move;
-    c.effect.type = CardType::Move;
-    c.effect.move.forward = fwd;
-    c.effect.move.lateral = lat;
-    c.mirroredEffect = mirrorEffect(c.effect);
-    return c;
-}
-
-} // namespace
-
 TEST(CardLogic, MirrorEffectForwardsFlip) {
     CardEffect eff{CardType::Move, {1, 0}};
     CardEffect mirrored = mirrorEffect(eff);
@@ -46,38 +20,38 @@ TEST(CardLogic, MirrorEffectSwapsLateral) {
 }
 
 TEST(CardLogic, ApplyCardClampsToGrid) {
-    GameState gs = makeState({10.0f, 5.0f});
+    GameState gs = makeState({10, 5});
     Card move = makeMoveCard(1, "Clamp", 0, 5); // would overshoot to x=15
     GameState out = applyCard(gs, move, 1, false);
     ASSERT_EQ(out.entities.size(), 1u);
-    EXPECT_FLOAT_EQ(out.entities[0].position.x, Grid::SIZE - 1);
-    EXPECT_FLOAT_EQ(out.entities[0].position.y, 5.0f);
+    EXPECT_EQ(out.entities[0].position.x, Grid::SIZE - 1);
+    EXPECT_EQ(out.entities[0].position.y, 5);
 }
 
 TEST(CardLogic, ApplyCardRespectsFacingEast) {
-    GameState gs = makeState({5.0f, 5.0f}, Facing::East);
+    GameState gs = makeState({5, 5}, Facing::East);
     Card move = makeMoveCard(1, "Forward", 1, 0); // local forward
     GameState out = applyCard(gs, move, 1, false);
-    EXPECT_FLOAT_EQ(out.entities[0].position.x, 6.0f); // forward rotates to +X
-    EXPECT_FLOAT_EQ(out.entities[0].position.y, 5.0f);
+    EXPECT_EQ(out.entities[0].position.x, 6); // forward rotates to +X
+    EXPECT_EQ(out.entities[0].position.y, 5);
 }
 
 TEST(CardLogic, ApplyCardRespectsFacingSouthLateral) {
-    GameState gs = makeState({5.0f, 5.0f}, Facing::South);
+    GameState gs = makeState({5, 5}, Facing::South);
     Card move = makeMoveCard(1, "Right", 0, 1); // local right
     GameState out = applyCard(gs, move, 1, false);
-    EXPECT_FLOAT_EQ(out.entities[0].position.x, 4.0f); // right when facing south -> -X
-    EXPECT_FLOAT_EQ(out.entities[0].position.y, 5.0f);
+    EXPECT_EQ(out.entities[0].position.x, 4); // right when facing south -> -X
+    EXPECT_EQ(out.entities[0].position.y, 5);
 }
 
 TEST(CardLogic, ApplyCardBlocksOnCollision) {
-    Entity blocker{2, ENEMY, {6.0f, 5.0f}, "Blocker"};
-    GameState gs = makeState({5.0f, 5.0f}, {blocker});
+    Entity blocker{2, ENEMY, {6, 5}, "Blocker"};
+    GameState gs = makeState({5, 5}, Facing::North, {blocker});
     Card move = makeMoveCard(1, "Right", 0, 1);
     GameState out = applyCard(gs, move, 1, false);
     ASSERT_EQ(out.entities.size(), 2u);
-    EXPECT_FLOAT_EQ(out.entities[0].position.x, 5.0f);
-    EXPECT_FLOAT_EQ(out.entities[0].position.y, 5.0f);
+    EXPECT_EQ(out.entities[0].position.x, 5);
+    EXPECT_EQ(out.entities[0].position.y, 5);
 }
 
 TEST(CardLogic, TurnPlanRejectsDuplicateMech) {
@@ -114,9 +88,9 @@ TEST(CardLogic, TurnPlanRejectsMoreThanThree) {
 }
 
 TEST(CardLogic, TurnPlanAppliesToSpecificMechFacing) {
-    Entity enemy{2, ENEMY, {4.0f, 4.0f}, "Enemy"};
+    Entity enemy{2, ENEMY, {4, 4}, "Enemy"};
     enemy.facing = Facing::West;
-    GameState gs = makeState({5.0f, 5.0f}, Facing::North, {enemy});
+    GameState gs = makeState({5, 5}, Facing::North, {enemy});
 
     std::vector<Card> hand{makeMoveCard(1, "EnemyForward", 1, 0)};
     TurnPlan plan;
@@ -125,8 +99,8 @@ TEST(CardLogic, TurnPlanAppliesToSpecificMechFacing) {
     GameState out = plan.apply(gs, hand, gs.grid);
     ASSERT_EQ(out.entities.size(), 2u);
     // Enemy facing West, forward should move -X
-    EXPECT_FLOAT_EQ(out.entities[1].position.x, 3.0f);
-    EXPECT_FLOAT_EQ(out.entities[1].position.y, 4.0f);
+    EXPECT_EQ(out.entities[1].position.x, 3);
+    EXPECT_EQ(out.entities[1].position.y, 4);
 }
 
 TEST(CardLogic, TurnPlanRejectsMissingMechRoster) {
@@ -168,8 +142,8 @@ TEST(CardLogic, SerializationRoundTrip) {
 
     EXPECT_EQ(card2.id, card.id);
     EXPECT_EQ(card2.effect.move.forward, card.effect.move.forward);
-    EXPECT_EQ(hand2.cards.size(), 1u);
-    EXPECT_EQ(hand2.cards[0].id, card.id);
+    EXPECT_EQ(hand2.cards().size(), 1u);
+    EXPECT_EQ(hand2.cards()[0].id, card.id);
     ASSERT_EQ(plan2.assignments.size(), 1u);
     EXPECT_EQ(plan2.assignments[0].mechId, 42);
     EXPECT_TRUE(plan2.assignments[0].useMirror);
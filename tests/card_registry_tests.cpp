@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "cardRegistry.h"
+#include "card.h"
+#include "test_fixtures.h"
+#include <string>
+
+TEST(CardRegistry, BuiltinsOccupyTheFirstHandles) {
+    for (size_t i = 0; i < kBuiltinCards.size(); ++i) {
+        const Card& card = cardByHandle(builtinCardHandle(i));
+        EXPECT_EQ(card.id, kBuiltinCards[i].id);
+        EXPECT_EQ(card.name, kBuiltinCards[i].name);
+        EXPECT_EQ(card.mirroredEffect, mirrorEffect(card.effect));
+    }
+    EXPECT_EQ(cardRegistry().find(4), builtinCardHandle(3));
+}
+
+TEST(CardRegistry, InternDedupesIdenticalCards) {
+    Card card = makeMoveCard(310, "Registry Hop", 2, 1);
+    CardHandle a = internCard(card);
+    CardHandle b = internCard(card);
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(cardByHandle(a).name, "Registry Hop");
+
+    // Same id, different contents: a separate card.
+    Card variant = makeMoveCard(310, "Registry Hop+", 3, 1);
+    EXPECT_NE(internCard(variant), a);
+    EXPECT_EQ(cardRegistry().find(310), a);
+}
+
+TEST(CardRegistry, LoadsDefinitionsFromJson) {
+    size_t before = cardRegistry().size();
+    std::string error;
+    int loaded = cardRegistry().loadDefinitions(
+        "{\"cards\":[{\"id\":320,\"name\":\"Vault\",\"type\":\"Move\",\"move\":{\"forward\":3,\"lateral\":0}},"
+        "{\"id\":321,\"name\":\"Mend\",\"type\":\"Heal\",\"heal\":10}]}",
+        &error);
+    EXPECT_EQ(loaded, 2) << error;
+    EXPECT_EQ(cardRegistry().size(), before + 2);
+
+    CardHandle vault = cardRegistry().find(320);
+    ASSERT_NE(vault, kInvalidCardHandle);
+    EXPECT_EQ(cardByHandle(vault).mirroredEffect.move.forward, -3);
+
+    EXPECT_EQ(cardRegistry().loadDefinitions("{\"cards\":[{\"id\":", &error), -1);
+    EXPECT_FALSE(error.empty());
+}
+
+TEST(CardRegistry, LookupFindsEveryVariantWithoutAdding) {
+    Card first = makeMoveCard(330, "Skip", 1, 0);
+    Card second = makeMoveCard(330, "Skip+", 2, 0);
+    CardHandle a = internCard(first);
+    CardHandle b = internCard(second);
+    EXPECT_EQ(cardRegistry().lookup(first), a);
+    EXPECT_EQ(findCardHandle(second), b);
+    EXPECT_EQ(cardRegistry().find(330), a);
+
+    size_t before = cardRegistry().size();
+    EXPECT_EQ(findCardHandle(makeMoveCard(330, "Skip++", 3, 0)), kInvalidCardHandle);
+    EXPECT_EQ(findCardHandle(makeMoveCard(331, "Skip", 1, 0)), kInvalidCardHandle);
+    EXPECT_EQ(cardRegistry().find(331), kInvalidCardHandle);
+    EXPECT_EQ(cardRegistry().size(), before);
+}
+
+TEST(CardRegistry, DecodedHandsOnlyNameRegisteredCards) {
+    Hand hand;
+    hand.addCard(builtinCardHandle(0));
+    hand.addCard(builtinCardHandle(3));
+    Hand decoded;
+    ASSERT_TRUE(deserializeHand(serializeHand(hand), decoded));
+    EXPECT_EQ(decoded.size(), 2u);
+
+    size_t before = cardRegistry().size();
+    EXPECT_FALSE(deserializeHand(
+        "{\"cards\":[{\"id\":1,\"name\":\"Advance\",\"type\":\"Move\",\"move\":{\"forward\":9,\"lateral\":0}}]}",
+        decoded));
+    EXPECT_FALSE(deserializeHand("{\"cards\":[{\"id\":340,\"name\":\"Stray\",\"type\":\"Heal\",\"heal\":5}]}", decoded));
+    EXPECT_EQ(cardRegistry().size(), before);
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include "card.h"
+#include "game.h"
+#include "grid.h"
+#include "entity.h"
+#include "test_fixtures.h"
+#include <vector>
+
+TEST(CardResolution, ResolveCardMutatesInPlaceAndReportsMove) {
+    GameState gs = makeState({5, 5});
+    CardDelta delta = resolveCard(gs, makeMoveCard(1, "Advance", 1, 0), 1);
+
+    EXPECT_EQ(gs.entities[0].position.y, 6);
+    EXPECT_EQ(delta.entityId, 1);
+    EXPECT_EQ(delta.type, CardType::Move);
+    EXPECT_EQ(delta.fromX, 5);
+    EXPECT_EQ(delta.fromY, 5);
+    EXPECT_EQ(delta.toX, 5);
+    EXPECT_EQ(delta.toY, 6);
+    EXPECT_FALSE(delta.blocked);
+}
+
+TEST(CardResolution, BlockedMoveIsFlaggedAndLeavesPosition) {
+    Entity blocker{2, ENEMY, {5, 6}, "Blocker"};
+    GameState gs = makeState({5, 5}, Facing::North, {blocker});
+    CardDelta delta = resolveCard(gs, makeMoveCard(1, "Advance", 1, 0), 1);
+
+    EXPECT_TRUE(delta.blocked);
+    EXPECT_EQ(delta.toX, delta.fromX);
+    EXPECT_EQ(delta.toY, delta.fromY);
+    EXPECT_EQ(gs.entities[0].position.y, 5);
+}
+
+TEST(CardResolution, DamageDeltaReportsClampedHealthChange) {
+    Entity enemy{2, ENEMY, {7, 7}, "Enemy"};
+    enemy.health = 10;
+    GameState gs = makeState({5, 5}, Facing::North, {enemy});
+    CardDelta delta = resolveCard(gs, makeDamageCard(9, 2, 25), 1);
+
+    EXPECT_EQ(delta.entityId, 2);
+    EXPECT_EQ(delta.healthDelta, -10);
+    EXPECT_EQ(gs.entities[1].health, 0);
+}
+
+TEST(CardResolution, MissingTargetYieldsEmptyDelta) {
+    GameState gs = makeState({5, 5});
+    CardDelta delta = resolveCard(gs, makeMoveCard(1, "Advance", 1, 0), 99);
+    EXPECT_EQ(delta.entityId, -1);
+    EXPECT_EQ(gs.entities[0].position.y, 5);
+}
+
+TEST(CardResolution, TurnPlanResolveMatchesApply) {
+    Entity enemy{2, ENEMY, {4, 4}, "Enemy"};
+    enemy.facing = Facing::West;
+    GameState gs = makeState({5, 5}, Facing::North, {enemy});
+
+    std::vector<Card> hand{makeMoveCard(1, "Forward", 1, 0), makeMoveCard(2, "Right", 0, 1)};
+    TurnPlan plan;
+    plan.assignments.push_back({1, 1, false});
+    plan.assignments.push_back({2, 2, true});
+
+    GameState copied = plan.apply(gs, hand, gs.grid);
+
+    std::vector<CardDelta> deltas;
+    plan.resolve(gs, hand, &deltas);
+
+    ASSERT_EQ(deltas.size(), 2u);
+    ASSERT_EQ(gs.entities.size(), copied.entities.size());
+    for (size_t i = 0; i < gs.entities.size(); ++i) {
+        EXPECT_EQ(gs.entities[i].position.x, copied.entities[i].position.x);
+        EXPECT_EQ(gs.entities[i].position.y, copied.entities[i].position.y);
+    }
+    EXPECT_EQ(deltas[1].entityId, 2);
+}
+
+TEST(CardResolution, TakeAndRestoreStateRoundTripsGame) {
+    Game game;
+    init_game(game);
+    size_t count = game.entities.size();
+
+    GameState state = take_state(game);
+    EXPECT_EQ(state.entities.size(), count);
+    EXPECT_EQ(state.currentTurn, game.turnNumber);
+    resolveCard(state, game.hand.cards().front(), 1);
+    restore_state(game, std::move(state));
+
+    ASSERT_EQ(game.entities.size(), count);
+    EXPECT_EQ(game.entities[0].position.y, 7);
+}
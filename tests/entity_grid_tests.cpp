@@ -104,11 +104,48 @@ TEST_F(GridTests, GridBoundaryConditions) {
     EXPECT_EQ(grid.getCell(11, 11), 4);
 }
 
+TEST_F(GridTests, OccupancyStartsEmpty) {
+    EXPECT_FALSE(grid.occupancy().any());
+    EXPECT_TRUE(grid.canSpawnAt(0, 0));
+}
+
+TEST_F(GridTests, SyncOccupancyTracksTeams) {
+    std::vector<Entity> entities{
+        {1, PLAYER, {1, 1}, "Hero"},
+        {2, ENEMY, {2, 1}, "Goblin"},
+        {3, OBJECT, {20, 20}, "OffBoard"}
+    };
+    grid.syncOccupancy(entities);
+
+    EXPECT_EQ(grid.occupancy().count(), 2);
+    EXPECT_TRUE(grid.isOccupied(1, 1));
+    EXPECT_TRUE(grid.teamOccupancy(PLAYER).test(Grid::cellIndex(1, 1)));
+    EXPECT_TRUE(grid.teamOccupancy(ENEMY).test(Grid::cellIndex(2, 1)));
+    EXPECT_FALSE(grid.canSpawnAt(2, 1));
+    EXPECT_TRUE(grid.hasAdjacent(1, 1, ENEMY));
+    EXPECT_FALSE(grid.hasAdjacent(1, 1, OBJECT));
+}
+
+TEST_F(GridTests, MoveOccupantUpdatesBitboards) {
+    grid.placeOccupant(4, 4, PLAYER);
+    grid.moveOccupant(4, 4, 4, 5, PLAYER);
+    EXPECT_FALSE(grid.isOccupied(4, 4));
+    EXPECT_TRUE(grid.isOccupied(4, 5));
+    EXPECT_EQ(grid.teamOccupancy(PLAYER).count(), 1);
+}
+
+TEST_F(GridTests, NeighborMaskRespectsEdges) {
+    EXPECT_EQ(Grid::neighborMask(0, 0).count(), 2);
+    EXPECT_EQ(Grid::neighborMask(5, 5).count(), 4);
+    EXPECT_EQ(Grid::neighborMask(11, 6).count(), 3);
+    EXPECT_FALSE(Grid::neighborMask(-1, 3).any());
+}
+
 // ==================== ENTITY TESTS ====================
 
 class EntityTests : public ::testing::Test {
 protected:
-    Entity createEntity(int id, EntityType type, Vector2 position, std::string name) {
+    Entity createEntity(int id, EntityType type, GridPos position, std::string name) {
         Entity e;
         e.id = id;
         e.type = type;
@@ -131,43 +168,44 @@ TEST_F(EntityTests, EntityTypeEnumValid) {
 }
 
 TEST_F(EntityTests, CreatePlayerEntity) {
-    Entity player = createEntity(1, PLAYER, {3.0f, 4.0f}, "Hero");
+    Entity player = createEntity(1, PLAYER, {3, 4}, "Hero");
     
     EXPECT_EQ(player.id, 1);
     EXPECT_EQ(player.type, PLAYER);
-    EXPECT_EQ(player.position.x, 3.0f);
-    EXPECT_EQ(player.position.y, 4.0f);
+    EXPECT_EQ(player.position.x, 3);
+    EXPECT_EQ(player.position.y, 4);
     EXPECT_EQ(player.name, "Hero");
     EXPECT_EQ(player.health, 100);
 }
 
 TEST_F(EntityTests, CreateEnemyEntity) {
-    Entity enemy = createEntity(2, ENEMY, {7.0f, 8.0f}, "Goblin");
+    Entity enemy = createEntity(2, ENEMY, {7, 8}, "Goblin");
     
     EXPECT_EQ(enemy.id, 2);
     EXPECT_EQ(enemy.type, ENEMY);
-    EXPECT_EQ(enemy.position.x, 7.0f);
-    EXPECT_EQ(enemy.position.y, 8.0f);
+    EXPECT_EQ(enemy.position.x, 7);
+    EXPECT_EQ(enemy.position.y, 8);
     EXPECT_EQ(enemy.name, "Goblin");
 }
 
 TEST_F(EntityTests, CreateObjectEntity) {
-    Entity obj = createEntity(3, OBJECT, {5.0f, 5.0f}, "Barrel");
+    Entity obj = createEntity(3, OBJECT, {5, 5}, "Barrel");
     
     EXPECT_EQ(obj.id, 3);
     EXPECT_EQ(obj.type, OBJECT);
     EXPECT_EQ(obj.name, "Barrel");
 }
 
-TEST_F(EntityTests, EntityPositionVector2) {
-    Entity e = createEntity(1, PLAYER, {0.5f, 11.5f}, "Edge");
+TEST_F(EntityTests, EntityPositionIsGridCell) {
+    Entity e = createEntity(1, PLAYER, {0, 11}, "Edge");
     
-    EXPECT_FLOAT_EQ(e.position.x, 0.5f);
-    EXPECT_FLOAT_EQ(e.position.y, 11.5f);
+    EXPECT_EQ(e.position.x, 0);
+    EXPECT_EQ(e.position.y, 11);
+    EXPECT_EQ(e.position, (GridPos{0, 11}));
 }
 
 TEST_F(EntityTests, EntityHealthTrackable) {
-    Entity e = createEntity(1, PLAYER, {5.0f, 5.0f}, "Hero");
+    Entity e = createEntity(1, PLAYER, {5, 5}, "Hero");
     EXPECT_EQ(e.health, 100);
     
     e.health -= 25;
@@ -178,8 +216,8 @@ TEST_F(EntityTests, EntityHealthTrackable) {
 }
 
 TEST_F(EntityTests, MultipleEntitiesIndependent) {
-    Entity player = createEntity(1, PLAYER, {2.0f, 3.0f}, "Player");
-    Entity enemy = createEntity(2, ENEMY, {9.0f, 10.0f}, "Enemy");
+    Entity player = createEntity(1, PLAYER, {2, 3}, "Player");
+    Entity enemy = createEntity(2, ENEMY, {9, 10}, "Enemy");
     
     player.health = 50;
     enemy.health = 30;
@@ -196,7 +234,7 @@ protected:
     Grid grid;
     std::vector<Entity> entities;
     
-    Entity createEntity(int id, EntityType type, Vector2 pos, std::string name) {
+    Entity createEntity(int id, EntityType type, GridPos pos, std::string name) {
         Entity e;
         e.id = id;
         e.type = type;
@@ -231,23 +269,23 @@ protected:
 };
 
 TEST_F(EntityGridIntegrationTests, EntityOnValidGridPosition) {
-    Entity hero = createEntity(1, PLAYER, {5.0f, 6.0f}, "Hero");
+    Entity hero = createEntity(1, PLAYER, {5, 6}, "Hero");
     
     EXPECT_TRUE(grid.isValidPosition(5, 6));
     EXPECT_TRUE(isEntityAtGridPosition(hero, 5, 6));
 }
 
 TEST_F(EntityGridIntegrationTests, EntityOnInvalidGridPosition) {
-    Entity hero = createEntity(1, PLAYER, {15.0f, 15.0f}, "Hero");
+    Entity hero = createEntity(1, PLAYER, {15, 15}, "Hero");
     
     EXPECT_FALSE(grid.isValidPosition(15, 15));
 }
 
 TEST_F(EntityGridIntegrationTests, PlaceEntityAtGridCorners) {
-    Entity e1 = createEntity(1, PLAYER, {0.0f, 0.0f}, "TopLeft");
-    Entity e2 = createEntity(2, ENEMY, {11.0f, 0.0f}, "TopRight");
-    Entity e3 = createEntity(3, PLAYER, {0.0f, 11.0f}, "BottomLeft");
-    Entity e4 = createEntity(4, ENEMY, {11.0f, 11.0f}, "BottomRight");
+    Entity e1 = createEntity(1, PLAYER, {0, 0}, "TopLeft");
+    Entity e2 = createEntity(2, ENEMY, {11, 0}, "TopRight");
+    Entity e3 = createEntity(3, PLAYER, {0, 11}, "BottomLeft");
+    Entity e4 = createEntity(4, ENEMY, {11, 11}, "BottomRight");
     
     entities = {e1, e2, e3, e4};
     
@@ -260,14 +298,14 @@ TEST_F(EntityGridIntegrationTests, PlaceEntityAtGridCorners) {
 }
 
 TEST_F(EntityGridIntegrationTests, PreventEntityPlacementOutOfBounds) {
-    Entity hero = createEntity(1, PLAYER, {-1.0f, 5.0f}, "OutOfBounds");
+    Entity hero = createEntity(1, PLAYER, {-1, 5}, "OutOfBounds");
     
     EXPECT_FALSE(canPlaceEntity(hero, entities));
 }
 
 TEST_F(EntityGridIntegrationTests, PreventEntityCollision) {
-    Entity hero = createEntity(1, PLAYER, {5.0f, 5.0f}, "Hero");
-    Entity enemy = createEntity(2, ENEMY, {5.0f, 5.0f}, "Enemy");
+    Entity hero = createEntity(1, PLAYER, {5, 5}, "Hero");
+    Entity enemy = createEntity(2, ENEMY, {5, 5}, "Enemy");
     
     entities.push_back(hero);
     
@@ -275,8 +313,8 @@ TEST_F(EntityGridIntegrationTests, PreventEntityCollision) {
 }
 
 TEST_F(EntityGridIntegrationTests, AllowEntityPlacementAtAdjacentPositions) {
-    Entity hero = createEntity(1, PLAYER, {5.0f, 5.0f}, "Hero");
-    Entity enemy = createEntity(2, ENEMY, {5.0f, 6.0f}, "Enemy");
+    Entity hero = createEntity(1, PLAYER, {5, 5}, "Hero");
+    Entity enemy = createEntity(2, ENEMY, {5, 6}, "Enemy");
     
     entities.push_back(hero);
     
@@ -284,7 +322,7 @@ TEST_F(EntityGridIntegrationTests, AllowEntityPlacementAtAdjacentPositions) {
 }
 
 TEST_F(EntityGridIntegrationTests, MarkGridCellAsOccupiedByEntity) {
-    Entity hero = createEntity(1, PLAYER, {3.0f, 4.0f}, "Hero");
+    Entity hero = createEntity(1, PLAYER, {3, 4}, "Hero");
     
     int gridX = static_cast<int>(hero.position.x);
     int gridY = static_cast<int>(hero.position.y);
@@ -295,9 +333,9 @@ TEST_F(EntityGridIntegrationTests, MarkGridCellAsOccupiedByEntity) {
 }
 
 TEST_F(EntityGridIntegrationTests, MultipleEntitiesOnGridWithoutCollision) {
-    Entity p1 = createEntity(1, PLAYER, {2.0f, 2.0f}, "Player1");
-    Entity p2 = createEntity(2, PLAYER, {2.0f, 4.0f}, "Player2");
-    Entity e1 = createEntity(3, ENEMY, {9.0f, 9.0f}, "Enemy1");
+    Entity p1 = createEntity(1, PLAYER, {2, 2}, "Player1");
+    Entity p2 = createEntity(2, PLAYER, {2, 4}, "Player2");
+    Entity e1 = createEntity(3, ENEMY, {9, 9}, "Enemy1");
     
     entities = {p1, p2, e1};
     
@@ -307,14 +345,14 @@ TEST_F(EntityGridIntegrationTests, MultipleEntitiesOnGridWithoutCollision) {
 }
 
 TEST_F(EntityGridIntegrationTests, ClearGridCellWhenEntityMoves) {
-    Entity hero = createEntity(1, PLAYER, {5.0f, 5.0f}, "Hero");
+    Entity hero = createEntity(1, PLAYER, {5, 5}, "Hero");
     
     // Mark initial position
     grid.setCell(5, 5, hero.id);
     EXPECT_EQ(grid.getCell(5, 5), 1);
     
     // Move hero
-    hero.position = {6.0f, 6.0f};
+    hero.position = {6, 6};
     grid.setCell(5, 5, 0); // Clear old position
     grid.setCell(6, 6, hero.id); // Mark new position
     
@@ -323,8 +361,8 @@ TEST_F(EntityGridIntegrationTests, ClearGridCellWhenEntityMoves) {
 }
 
 TEST_F(EntityGridIntegrationTests, EntityDistanceCalculation) {
-    Entity p1 = createEntity(1, PLAYER, {0.0f, 0.0f}, "Start");
-    Entity p2 = createEntity(2, PLAYER, {3.0f, 4.0f}, "End");
+    Entity p1 = createEntity(1, PLAYER, {0, 0}, "Start");
+    Entity p2 = createEntity(2, PLAYER, {3, 4}, "End");
     
     float dx = p2.position.x - p1.position.x;
     float dy = p2.position.y - p1.position.y;
@@ -334,8 +372,8 @@ TEST_F(EntityGridIntegrationTests, EntityDistanceCalculation) {
 }
 
 TEST_F(EntityGridIntegrationTests, ManhattanDistanceBetweenEntities) {
-    Entity p1 = createEntity(1, PLAYER, {2.0f, 3.0f}, "Start");
-    Entity p2 = createEntity(2, PLAYER, {5.0f, 7.0f}, "End");
+    Entity p1 = createEntity(1, PLAYER, {2, 3}, "Start");
+    Entity p2 = createEntity(2, PLAYER, {5, 7}, "End");
     
     int manhattan = static_cast<int>(std::abs(p2.position.x - p1.position.x) +
                                       std::abs(p2.position.y - p1.position.y));
@@ -382,9 +420,9 @@ TEST_F(EntityGridIntegrationTests, FindNeighboringGridCellsAtEdge) {
 }
 
 TEST_F(EntityGridIntegrationTests, EntityCountInGame) {
-    entities.push_back(createEntity(1, PLAYER, {1.0f, 1.0f}, "Hero"));
-    entities.push_back(createEntity(2, ENEMY, {10.0f, 10.0f}, "Goblin"));
-    entities.push_back(createEntity(3, OBJECT, {5.0f, 5.0f}, "Barrel"));
+    entities.push_back(createEntity(1, PLAYER, {1, 1}, "Hero"));
+    entities.push_back(createEntity(2, ENEMY, {10, 10}, "Goblin"));
+    entities.push_back(createEntity(3, OBJECT, {5, 5}, "Barrel"));
     
     EXPECT_EQ(entities.size(), 3);
     
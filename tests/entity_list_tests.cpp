@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "entityList.h"
+#include "card.h"
+#include "cardRegistry.h"
+#include "game.h"
+#include "zobrist.h"
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+EntityList makeList(int count) {
+    EntityList list;
+    for (int i = 0; i < count; ++i) {
+        list.push_back(Entity{i + 1, i % 2 ? ENEMY : PLAYER, {i % 12, i / 12}, "Mech " + std::to_string(i + 1)});
+    }
+    return list;
+}
+
+} // namespace
+
+TEST(EntityList, ForkSharesEverySlot) {
+    EntityList base = makeList(10);
+    EntityList fork = base;
+    ASSERT_EQ(fork.size(), base.size());
+    for (size_t i = 0; i < base.size(); ++i) {
+        EXPECT_TRUE(fork.sharesSlot(base, i));
+        EXPECT_EQ(fork[i].id, base[i].id);
+    }
+}
+
+TEST(EntityList, WriteCopiesOnlyTheTouchedChunk) {
+    EntityList base = makeList(10);
+    EntityList fork = base;
+    fork.edit(5).health = 7;
+
+    EXPECT_EQ(base[5].health, 100);
+    EXPECT_EQ(fork[5].health, 7);
+    size_t chunk = 5 / EntityList::kChunkSize;
+    for (size_t i = 0; i < base.size(); ++i) {
+        EXPECT_EQ(fork.sharesSlot(base, i), i / EntityList::kChunkSize != chunk) << "slot " << i;
+    }
+}
+
+TEST(EntityList, ReadsThroughConstViewsNeverDetach) {
+    EntityList base = makeList(6);
+    EntityList fork = base;
+    int sum = 0;
+    for (const Entity& e : fork) sum += e.id;
+    auto it = std::find_if(fork.begin(), fork.end(), [](const Entity& e) { return e.id == 4; });
+    ASSERT_NE(it, fork.end());
+    EXPECT_EQ(it - fork.begin(), 3);
+    EXPECT_EQ(sum, 21);
+    for (size_t i = 0; i < base.size(); ++i) EXPECT_TRUE(fork.sharesSlot(base, i));
+}
+
+TEST(EntityList, GrowingAForkLeavesTheParent) {
+    EntityList base = makeList(4);
+    EntityList fork = base;
+    fork.push_back(Entity{99, OBJECT, {5, 5}, "Rock"});
+    fork.resize(2);
+    fork.push_back(Entity{98, OBJECT, {6, 6}, "Crate"});
+
+    ASSERT_EQ(base.size(), 4u);
+    EXPECT_EQ(base[2].id, 3);
+    ASSERT_EQ(fork.size(), 3u);
+    EXPECT_EQ(fork[2].id, 98);
+}
+
+TEST(EntityList, TakeVectorCopiesWhenShared) {
+    EntityList base = makeList(5);
+    EntityList fork = base;
+    std::vector<Entity> taken = fork.takeVector();
+    ASSERT_EQ(taken.size(), 5u);
+    EXPECT_TRUE(fork.empty());
+    EXPECT_EQ(base[4].name, "Mech 5");
+    EXPECT_EQ(taken[4].name, "Mech 5");
+}
+
+TEST(EntityList, GameStateForksAreIndependentBranches) {
+    Game game;
+    init_game(game);
+    GameState root = take_state(game);
+    const GameState& parent = root;
+
+    GameState branch = applyCard(root, cardByHandle(builtinCardHandle(0)), 1); // mech 1 advances
+    ASSERT_EQ(branch.entities.size(), parent.entities.size());
+    EXPECT_NE(branch.entities[0].position, parent.entities[0].position);
+    EXPECT_EQ(parent.hash, zobristHash(parent));
+    EXPECT_EQ(branch.hash, zobristHash(branch));
+    // Only the mover's chunk was copied.
+    for (size_t i = EntityList::kChunkSize; i < parent.entities.size(); ++i) {
+        EXPECT_TRUE(branch.entities.sharesSlot(parent.entities, i));
+    }
+}
+
+TEST(EntityList, GridCellsAreCopiedOnWrite) {
+    Grid a;
+    a.setCell(3, 3, 2);
+    Grid b = a;
+    b.setCell(3, 3, 5);
+    EXPECT_EQ(a.getCell(3, 3), 2);
+    EXPECT_EQ(b.getCell(3, 3), 5);
+    EXPECT_EQ(Grid().getCell(3, 3), 0);
+}
+
+TEST(EntityList, ForksMutateOnSeparateThreads) {
+    EntityList base = makeList(12);
+    std::vector<EntityList> forks(4, base);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < forks.size(); ++t) {
+        threads.emplace_back([&forks, t] {
+            for (int round = 0; round < 1000; ++round) {
+                EntityList child = forks[t];
+                child.edit((round + t) % child.size()).health -= 1;
+                forks[t] = child;
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    for (const Entity& e : base) EXPECT_EQ(e.health, 100);
+    for (const EntityList& fork : forks) {
+        int total = 0;
+        for (const Entity& e : fork) total += 100 - e.health;
+        EXPECT_EQ(total, 1000);
+    }
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include "card.h"
+#include "game.h"
+#include "cardRegistry.h"
+#include "test_fixtures.h"
+#include <type_traits>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<int> availableIds(const Hand& hand) {
+    std::vector<int> ids;
+    for (const Card& c : hand.available()) ids.push_back(c.id);
+    return ids;
+}
+
+} // namespace
+
+TEST(Hand, CountsCopiesAndUsage) {
+    Hand hand;
+    hand.addCard(makeCard(1));
+    hand.addCard(makeCard(2));
+    hand.addCard(makeCard(1));
+
+    EXPECT_EQ(hand.totalCount(1), 2);
+    EXPECT_EQ(hand.totalCount(7), 0);
+    EXPECT_TRUE(hand.markUsed(1));
+    EXPECT_EQ(hand.usedCount(1), 1);
+    EXPECT_EQ(hand.availableCount(1), 1);
+    EXPECT_TRUE(hand.markUsed(1));
+    EXPECT_FALSE(hand.markUsed(1));
+    EXPECT_FALSE(hand.canPlay(1));
+    EXPECT_TRUE(hand.unmarkUsed(1));
+    EXPECT_TRUE(hand.canPlay(1));
+    EXPECT_FALSE(hand.unmarkUsed(2));
+}
+
+TEST(Hand, AvailableKeepsHandOrderFirstCopiesFirst) {
+    Hand hand;
+    hand.addCard(makeCard(1));
+    hand.addCard(makeCard(2));
+    hand.addCard(makeCard(1));
+    EXPECT_EQ(availableIds(hand), (std::vector<int>{1, 2, 1}));
+
+    hand.markUsed(1);
+    EXPECT_EQ(availableIds(hand), (std::vector<int>{1, 2}));
+    hand.markUsed(2);
+    EXPECT_EQ(availableIds(hand), (std::vector<int>{1}));
+    EXPECT_EQ(hand.availableAt(0).id, 1);
+
+    hand.unmarkUsed(1);
+    EXPECT_EQ(availableIds(hand), (std::vector<int>{1, 1}));
+    hand.resetUsage();
+    EXPECT_EQ(hand.availableSize(), 3u);
+
+    int ids[2];
+    EXPECT_EQ(hand.availableCardIds(ids), 2u);
+    EXPECT_EQ(ids[0], 1);
+    EXPECT_EQ(ids[1], 2);
+}
+
+TEST(Hand, LargeAndNegativeIdsUseSlotLookup) {
+    Hand hand;
+    hand.addCard(makeCard(1000));
+    hand.addCard(makeCard(-4));
+    hand.addCard(makeCard(1000));
+    EXPECT_EQ(hand.totalCount(1000), 2);
+    EXPECT_TRUE(hand.markUsed(-4));
+    EXPECT_FALSE(hand.canPlay(-4));
+    EXPECT_EQ(availableIds(hand), (std::vector<int>{1000, 1000}));
+}
+
+TEST(Hand, StoresRegistryHandlesWithoutHeap) {
+    static_assert(std::is_trivially_copyable_v<Hand>, "hands copy as plain values");
+    Game game;
+    init_game(game);
+    ASSERT_EQ(game.hand.size(), kBuiltinCards.size());
+    for (size_t i = 0; i < game.hand.size(); ++i) EXPECT_EQ(game.hand.handle(i), builtinCardHandle(i));
+
+    Hand copy = game.hand;
+    copy.markUsed(1);
+    EXPECT_TRUE(game.hand.canPlay(1));
+    ASSERT_NE(copy.find(4), nullptr);
+    EXPECT_EQ(copy.find(4)->name, "Lunge");
+    EXPECT_EQ(copy.find(99), nullptr);
+}
+
+TEST(Hand, ClearForgetsIds) {
+    Game game;
+    init_game(game);
+    game.hand.markUsed(1);
+    game.hand.clear();
+    EXPECT_FALSE(game.hand.canPlay(1));
+    EXPECT_EQ(game.hand.find(1), nullptr);
+
+    game.hand.addCard(builtinCardHandle(2));
+    EXPECT_EQ(game.hand.availableSize(), 1u);
+    EXPECT_EQ(game.hand.available().begin()->id, game.hand.cards().front().id);
+}
+
+TEST(Hand, CapacityIsBounded) {
+    Hand hand;
+    for (int i = 0; i < Hand::kMaxCards + 5; ++i) hand.addCard(makeCard(i % 3));
+    EXPECT_EQ(hand.cards().size(), static_cast<size_t>(Hand::kMaxCards));
+    EXPECT_EQ(hand.availableSize(), static_cast<size_t>(Hand::kMaxCards));
+}
+
+TEST(Hand, RandomMarkUnmarkMatchesCounts) {
+    Hand hand;
+    const int ids[] = {3, 1, 3, 9, 1, 3};
+    for (int id : ids) hand.addCard(makeCard(id));
+
+    std::mt19937 rng(42);
+    for (int step = 0; step < 500; ++step) {
+        int id = ids[rng() % 6];
+        if (rng() % 2) hand.markUsed(id);
+        else hand.unmarkUsed(id);
+
+        size_t expected = 0;
+        for (int distinct : {1, 3, 9}) {
+            int available = 0;
+            for (const Card& c : hand.available()) available += c.id == distinct;
+            EXPECT_EQ(available, hand.availableCount(distinct));
+            expected += static_cast<size_t>(hand.availableCount(distinct));
+        }
+        EXPECT_EQ(hand.availableSize(), expected);
+    }
+}
+
+TEST(Hand, AddingCopyWhileOthersAreUsedKeepsAvailableInSync) {
+    Hand hand;
+    hand.addCard(makeCard(5));
+    hand.addCard(makeCard(2));
+    ASSERT_TRUE(hand.markUsed(5));
+    hand.addCard(makeCard(5));
+    EXPECT_EQ(hand.availableCount(5), 1);
+    EXPECT_EQ(hand.availableSize(), 2u);
+    EXPECT_EQ(availableIds(hand), (std::vector<int>{5, 2}));
+
+    ASSERT_TRUE(hand.unmarkUsed(5));
+    EXPECT_EQ(hand.availableCount(5), 2);
+    EXPECT_EQ(hand.availableSize(), 3u);
+    EXPECT_EQ(availableIds(hand), (std::vector<int>{5, 2, 5}));
+
+    ASSERT_TRUE(hand.markUsed(5));
+    ASSERT_TRUE(hand.markUsed(5));
+    EXPECT_EQ(availableIds(hand), (std::vector<int>{2}));
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include "common/jobsystem.h"
+#include <atomic>
+#include <vector>
+
+TEST(JobSystem, RunsEveryJobInGroup) {
+    JobSystem jobs(2);
+    TaskGroup group;
+    std::atomic<int> count{0};
+    for (int i = 0; i < 1000; ++i) {
+        jobs.run(group, [&count]() { count.fetch_add(1, std::memory_order_relaxed); });
+    }
+    jobs.wait(group);
+    EXPECT_TRUE(group.done());
+    EXPECT_EQ(count.load(), 1000);
+}
+
+TEST(JobSystem, ParallelForCoversRangeExactlyOnce) {
+    JobSystem jobs(3);
+    std::vector<int> hits(10007, 0);
+    jobs.parallelFor(0, static_cast<int>(hits.size()), 64, [&hits](int begin, int end) {
+        for (int i = begin; i < end; ++i) hits[i]++;
+    });
+    for (int h : hits) ASSERT_EQ(h, 1);
+}
+
+TEST(JobSystem, NestedParallelForDoesNotDeadlock) {
+    // Waiting inside a job helps drain the queues instead of blocking a worker.
+    JobSystem jobs(1);
+    std::atomic<long long> sum{0};
+    jobs.parallelFor(0, 8, 1, [&](int outerBegin, int outerEnd) {
+        for (int o = outerBegin; o < outerEnd; ++o) {
+            jobs.parallelFor(0, 100, 10, [&](int begin, int end) {
+                long long local = 0;
+                for (int i = begin; i < end; ++i) local += i;
+                sum.fetch_add(local, std::memory_order_relaxed);
+            });
+        }
+    });
+    EXPECT_EQ(sum.load(), 8 * 4950LL);
+}
+
+TEST(JobSystem, ThreadIndexIsZeroOutsidePool) {
+    JobSystem jobs(2);
+    EXPECT_EQ(jobs.threadCount(), 3);
+    EXPECT_EQ(jobs.currentThreadIndex(), 0);
+
+    std::vector<std::atomic<int>> seen(jobs.threadCount());
+    jobs.parallelFor(0, 256, 1, [&](int, int) {
+        int index = jobs.currentThreadIndex();
+        ASSERT_GE(index, 0);
+        ASSERT_LT(index, jobs.threadCount());
+        seen[index].fetch_add(1, std::memory_order_relaxed);
+    });
+    int total = 0;
+    for (auto& s : seen) total += s.load();
+    EXPECT_EQ(total, 256);
+}
+
+TEST(JobSystem, SharedPoolIsSingleton) {
+    EXPECT_EQ(&jobSystem(), &jobSystem());
+    EXPECT_GE(jobSystem().workerCount(), 1);
+}
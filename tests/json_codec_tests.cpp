@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "card.h"
+#include "game.h"
+#include "utils/jsonCodec.h"
+#include "test_fixtures.h"
+#include <limits>
+#include <string>
+
+TEST(JsonCodec, CardEncodingKeepsWireFormat) {
+    Card card = makeCard(3, "Hook", CardType::Move, 1, -1);
+    EXPECT_EQ(serializeCard(card),
+              "{\"id\":3,\"name\":\"Hook\",\"type\":\"Move\",\"move\":{\"forward\":1,\"lateral\":-1},\"damage\":0,\"heal\":0,\"target\":-1}");
+
+    TurnPlan plan;
+    plan.assignments = {{1, 2, true}};
+    EXPECT_EQ(serializeTurnPlan(plan), "{\"assignments\":[{\"mechId\":1,\"cardId\":2,\"useMirror\":true}]}");
+}
+
+TEST(JsonCodec, HandRoundTripsNestedMoveObjects) {
+    Game game;
+    init_game(game);
+    Card zap = makeCard(20, "Zap", CardType::Damage, 0, 0, 15);
+    zap.effect.targetEntityId = 4;
+    zap.mirroredEffect = mirrorEffect(zap.effect);
+    game.hand.addCard(zap);
+    game.hand.addCard(makeCard(21, "Patch", CardType::Heal, 0, 0, 0, 12));
+
+    Hand decoded;
+    ASSERT_TRUE(deserializeHand(serializeHand(game.hand), decoded));
+    ASSERT_EQ(decoded.cards().size(), game.hand.cards().size());
+    for (size_t i = 0; i < decoded.cards().size(); ++i) {
+        const Card& a = game.hand.cards()[i];
+        const Card& b = decoded.cards()[i];
+        EXPECT_EQ(b.id, a.id);
+        EXPECT_EQ(b.name, a.name);
+        EXPECT_EQ(b.type, a.type);
+        EXPECT_EQ(b.effect.move, a.effect.move);
+        EXPECT_EQ(b.effect.damage, a.effect.damage);
+        EXPECT_EQ(b.effect.heal, a.effect.heal);
+        EXPECT_EQ(b.effect.targetEntityId, a.effect.targetEntityId);
+        EXPECT_EQ(b.mirroredEffect.targetEntityId, a.mirroredEffect.targetEntityId);
+        EXPECT_EQ(b.mirroredEffect.move, a.mirroredEffect.move);
+    }
+}
+
+TEST(JsonCodec, TurnPlanRoundTrips) {
+    TurnPlan plan;
+    plan.assignments = {{1, 4, false}, {2, 6, true}, {3, 1, false}};
+    TurnPlan decoded;
+    ASSERT_TRUE(deserializeTurnPlan(serializeTurnPlan(plan), decoded));
+    EXPECT_EQ(decoded.assignments, plan.assignments);
+}
+
+TEST(JsonCodec, ReaderAcceptsAnyKeyOrderWhitespaceAndUnknownKeys) {
+    const char* json = R"( { "name" : "Lunge", "extra" : {"a":[1,2,{"b":null}],"c":"}"},
+        "move": { "lateral": 0, "forward": 2 }, "type":"Move", "id": 4 } )";
+    Card card;
+    ASSERT_TRUE(deserializeCard(json, card));
+    EXPECT_EQ(card.id, 4);
+    EXPECT_EQ(card.name, "Lunge");
+    EXPECT_EQ(card.effect.move.forward, 2);
+    EXPECT_EQ(card.effect.move.lateral, 0);
+}
+
+TEST(JsonCodec, EscapedNamesRoundTrip) {
+    Card card = makeCard(9, "Say \"hi\"\\now\n", CardType::Move, 1, 0);
+    Card decoded;
+    ASSERT_TRUE(deserializeCard(serializeCard(card), decoded));
+    EXPECT_EQ(decoded.name, card.name);
+}
+
+TEST(JsonCodec, MalformedInputIsRejected) {
+    Card card;
+    EXPECT_FALSE(deserializeCard("{\"id\":1,\"name\":\"A\"", card));            // truncated, no type
+    EXPECT_FALSE(deserializeCard("{\"id\":1 \"name\":\"A\",\"type\":\"Move\"}", card)); // missing comma
+    EXPECT_FALSE(deserializeCard("{\"name\":\"A\",\"type\":\"Move\"}", card));   // missing id
+    EXPECT_FALSE(deserializeCard("{\"id\":1,\"name\":\"A\",\"type\":\"Warp\"}", card)); // unknown type
+
+    TurnPlan plan;
+    EXPECT_FALSE(deserializeTurnPlan("{\"assignments\":[{\"mechId\":1}]}", plan));
+    EXPECT_FALSE(deserializeTurnPlan("[]", plan));
+
+    Hand hand;
+    EXPECT_FALSE(deserializeHand("{\"cards\":[{\"id\":x}]}", hand));
+
+    JsonReader reader("{\"a\":1");
+    std::string_view key;
+    int v = 0;
+    ASSERT_TRUE(reader.beginObject());
+    ASSERT_TRUE(reader.nextKey(key));
+    ASSERT_TRUE(reader.readInt(v));
+    EXPECT_FALSE(reader.nextKey(key));
+    EXPECT_FALSE(reader.ok());
+    EXPECT_STRNE(reader.error(), "");
+}
+
+TEST(JsonCodec, BufferOverloadsReuseCapacity) {
+    Game game;
+    init_game(game);
+    std::string buffer;
+    serializeHand(game.hand, buffer);
+    const char* data = buffer.data();
+    size_t capacity = buffer.capacity();
+    std::string first = buffer;
+
+    serializeHand(game.hand, buffer);
+    EXPECT_EQ(buffer, first);
+    EXPECT_EQ(buffer.data(), data);
+    EXPECT_EQ(buffer.capacity(), capacity);
+}
+
+TEST(JsonCodec, DoublesRoundTripExactly) {
+    std::string out;
+    JsonWriter writer(out);
+    writer.beginArray().value(0.1).value(-1234.5e-7).value(3.0).value(std::numeric_limits<double>::infinity()).endArray();
+    EXPECT_EQ(out, "[0.1,-0.00012345,3,null]");
+
+    JsonReader reader(out);
+    double a = 0.0, b = 0.0, c = 0.0;
+    ASSERT_TRUE(reader.beginArray());
+    ASSERT_TRUE(reader.nextElement() && reader.readDouble(a));
+    ASSERT_TRUE(reader.nextElement() && reader.readDouble(b));
+    ASSERT_TRUE(reader.nextElement() && reader.readDouble(c));
+    EXPECT_EQ(a, 0.1);
+    EXPECT_EQ(b, -1234.5e-7);
+    EXPECT_EQ(c, 3.0);
+    ASSERT_TRUE(reader.nextElement());
+    EXPECT_FALSE(reader.readDouble(a)); // null is not a number
+}
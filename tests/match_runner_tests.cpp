@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include "sim/match_runner.h"
+
+TEST(MatchRunner, SameSeedReplaysIdentically) {
+    MatchConfig config;
+    config.maxTurns = 12;
+    MatchResult a = runMatch(config, 1234u);
+    MatchResult b = runMatch(config, 1234u);
+    EXPECT_EQ(a.turns, b.turns);
+    EXPECT_EQ(a.outcome, b.outcome);
+    EXPECT_EQ(a.playerHealth, b.playerHealth);
+    EXPECT_EQ(a.enemyHealth, b.enemyHealth);
+}
+
+TEST(MatchRunner, MatchSeedsDifferPerIndex) {
+    EXPECT_NE(matchSeed(1u, 0), matchSeed(1u, 1));
+    EXPECT_EQ(matchSeed(7u, 3), matchSeed(7u, 3));
+}
+
+TEST(MatchRunner, BatchCountsEveryMatchAcrossThreads) {
+    MatchConfig config;
+    config.matchCount = 150;
+    config.maxTurns = 5;
+    config.threadCount = 3;
+
+    SimStats stats = runMatches(config);
+    EXPECT_EQ(stats.matches, 150);
+    EXPECT_EQ(stats.playerWins + stats.enemyWins + stats.draws, stats.matches);
+    EXPECT_EQ(stats.turns, 150 * 5);
+    EXPECT_EQ(stats.threads, 3);
+}
+
+TEST(MatchRunner, ThreadCountDoesNotChangeResults) {
+    MatchConfig config;
+    config.matchCount = 40;
+    config.maxTurns = 8;
+
+    config.threadCount = 1;
+    SimStats serial = runMatches(config);
+    config.threadCount = 4;
+    SimStats parallel = runMatches(config);
+
+    EXPECT_EQ(serial.turns, parallel.turns);
+    EXPECT_EQ(serial.playerWins, parallel.playerWins);
+    EXPECT_EQ(serial.enemyWins, parallel.enemyWins);
+    EXPECT_EQ(serial.draws, parallel.draws);
+}
+
+TEST(MatchRunner, OutcomesVaryAcrossSeeds) {
+    MatchConfig config;
+    config.maxTurns = 30;
+    for (bool simultaneous : {false, true}) {
+        config.simultaneous = simultaneous;
+        int playerWins = 0;
+        int enemyWins = 0;
+        bool healthChanged = false;
+        for (int i = 0; i < 60; ++i) {
+            MatchResult r = runMatch(config, matchSeed(5u, i));
+            if (r.outcome == MatchOutcome::PlayerWin) playerWins++;
+            if (r.outcome == MatchOutcome::EnemyWin) enemyWins++;
+            if (r.playerHealth != 300 || r.enemyHealth != 300) healthChanged = true;
+        }
+        EXPECT_TRUE(healthChanged);
+        EXPECT_GT(playerWins, 0);
+        EXPECT_GT(enemyWins, 0);
+    }
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "card.h"
+#include "cardRegistry.h"
+#include "game.h"
+#include "grid.h"
+#include "entity.h"
+#include "test_fixtures.h"
+#include <vector>
+
+namespace {
+
+// Straight rotation of (lateral, forward) the way resolution computed it before the tables.
+CellDelta rotateReference(int forward, int lateral, Facing facing) {
+    switch (facing) {
+    case Facing::North: return {static_cast<int8_t>(lateral), static_cast<int8_t>(forward)};
+    case Facing::East:  return {static_cast<int8_t>(forward), static_cast<int8_t>(-lateral)};
+    case Facing::South: return {static_cast<int8_t>(-lateral), static_cast<int8_t>(-forward)};
+    case Facing::West:  return {static_cast<int8_t>(-forward), static_cast<int8_t>(lateral)};
+    }
+    return {};
+}
+
+constexpr Facing kFacings[] = {Facing::North, Facing::East, Facing::South, Facing::West};
+
+} // namespace
+
+TEST(MoveTables, MoveDeltaMatchesRotationForEveryFacing) {
+    for (int forward = -3; forward <= 3; ++forward) {
+        for (int lateral = -3; lateral <= 3; ++lateral) {
+            for (Facing f : kFacings) {
+                EXPECT_EQ(moveDelta(MoveVector{forward, lateral}, f), rotateReference(forward, lateral, f))
+                    << "forward " << forward << " lateral " << lateral << " facing " << static_cast<int>(f);
+            }
+        }
+    }
+}
+
+TEST(MoveTables, BuiltinCardTablesCoverBothSides) {
+    for (size_t i = 0; i < kBuiltinCards.size(); ++i) {
+        const CardMoves& moves = cardMovesByHandle(builtinCardHandle(i));
+        const Card& card = cardByHandle(builtinCardHandle(i));
+        for (Facing f : kFacings) {
+            EXPECT_EQ(moves.at(f, false), moveDelta(card.effect.move, f));
+            EXPECT_EQ(moves.at(f, true), moveDelta(card.mirroredEffect.move, f));
+        }
+    }
+}
+
+TEST(MoveTables, ClampedDestinationStopsAtEdges) {
+    EXPECT_EQ(Grid::clampedDestination(Grid::cellIndex(5, 5), {1, 2}), Grid::cellIndex(6, 7));
+    EXPECT_EQ(Grid::clampedDestination(Grid::cellIndex(0, 0), {-2, -1}), Grid::cellIndex(0, 0));
+    EXPECT_EQ(Grid::clampedDestination(Grid::cellIndex(11, 10), {3, 3}), Grid::cellIndex(11, 11));
+    // Beyond the table's reach the step is clamped arithmetically.
+    EXPECT_EQ(Grid::clampedDestination(Grid::cellIndex(2, 2), {7, -9}), Grid::cellIndex(9, 0));
+}
+
+TEST(MoveTables, MoveDestinationReportsBlockedCells) {
+    Grid grid;
+    grid.placeOccupant(4, 5, ENEMY);
+    bool blocked = false;
+    EXPECT_EQ(grid.moveDestination(4, 3, {0, 2}, &blocked), Grid::cellIndex(4, 3));
+    EXPECT_TRUE(blocked);
+    EXPECT_EQ(grid.moveDestination(4, 3, {1, 2}, &blocked), Grid::cellIndex(5, 5));
+    EXPECT_FALSE(blocked);
+}
+
+TEST(MoveTables, HandleResolutionMatchesCardResolution) {
+    Entity blocker{2, ENEMY, {6, 5}, "Blocker"};
+    for (size_t i = 0; i < kBuiltinCards.size(); ++i) {
+        CardHandle handle = builtinCardHandle(i);
+        for (Facing f : kFacings) {
+            for (bool mirror : {false, true}) {
+                GameState byCard = makeState({5, 5}, f, {blocker});
+                GameState byHandle = byCard;
+                CardDelta a = resolveCard(byCard, cardByHandle(handle), 1, mirror);
+                CardDelta b = resolveCard(byHandle, handle, 1, mirror);
+                EXPECT_EQ(a.toX, b.toX);
+                EXPECT_EQ(a.toY, b.toY);
+                EXPECT_EQ(a.blocked, b.blocked);
+                EXPECT_EQ(byCard.hash, byHandle.hash);
+                EXPECT_EQ(byCard.entities[0].position.x, byHandle.entities[0].position.x);
+                EXPECT_EQ(byCard.entities[0].position.y, byHandle.entities[0].position.y);
+            }
+        }
+    }
+}
+
+TEST(MoveTables, PreviewMatchesResolutionWithoutMutating) {
+    Entity blocker{2, ENEMY, {5, 6}, "Blocker"};
+    GameState gs = makeState({5, 5}, Facing::North, {blocker});
+    CellDelta forward = moveDelta(MoveVector{1, 0}, Facing::North);
+
+    CardDelta preview = previewMove(gs.grid, gs.entities[0], forward);
+    EXPECT_TRUE(preview.blocked);
+    EXPECT_TRUE(gs.grid.isOccupied(5, 5));
+
+    preview = previewMove(gs.grid, gs.entities[0], moveDelta(MoveVector{0, 1}, Facing::North));
+    EXPECT_FALSE(preview.blocked);
+    EXPECT_EQ(preview.toX, 6);
+    EXPECT_EQ(preview.toY, 5);
+    EXPECT_EQ(gs.entities[0].position.x, 5);
+    EXPECT_FALSE(gs.grid.isOccupied(6, 5));
+}
+
+TEST(MoveTables, LegalDestinationsFollowStarterHand) {
+    Game game;
+    init_game(game);
+    const Entity& player = game.entities[0];
+    Bitboard legal = legalMoveDestinations(game.grid, player, game.hand);
+
+    Bitboard expected;
+    for (const Card& card : game.hand.cards()) {
+        if (card.effect.type != CardType::Move) continue;
+        for (bool mirror : {false, true}) {
+            CardDelta d = previewMove(game.grid, player,
+                moveDelta((mirror ? card.mirroredEffect : card.effect).move, player.facing));
+            if (!d.blocked && (d.toX != d.fromX || d.toY != d.fromY)) expected.set(Grid::cellIndex(d.toX, d.toY));
+        }
+    }
+    EXPECT_TRUE(legal.any());
+    EXPECT_EQ(legal, expected);
+}
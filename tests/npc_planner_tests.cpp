@@ -0,0 +1,384 @@
+#include <gtest/gtest.h>
+#include "ai/npc_planner.h"
+#include "ai/npc_plan_task.h"
+#include "boss/bossCardSelectState.h"
+#include "boss/bossNpcSelectState.h"
+#include "cardRegistry.h"
+#include "game.h"
+#include "ui.h"
+#include "zobrist.h"
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::vector<int> mechIdsOf(const std::vector<Entity>& entities, EntityType type) {
+    std::vector<int> ids;
+    for (const auto& e : entities) {
+        if (e.type == type) ids.push_back(e.id);
+    }
+    return ids;
+}
+
+// Counts plan() calls and the threads they ran on.
+class CountingPlanner : public NpcPlanner {
+public:
+    TurnPlan plan(const PlannerInput& input, const PlannerBudget& budget, PlannerStats* stats = nullptr) override {
+        calls.fetch_add(1);
+        if (std::this_thread::get_id() == mainThread) callsOnMain.fetch_add(1);
+        return RandomNpcPlanner().plan(input, budget, stats);
+    }
+    const char* getName() const override { return "Counting"; }
+
+    std::thread::id mainThread = std::this_thread::get_id();
+    std::atomic<int> calls{0};
+    std::atomic<int> callsOnMain{0};
+};
+
+// Parks every pool worker until release is set, so queued jobs cannot start.
+void occupyWorkers(TaskGroup& group, std::atomic<int>& parked, std::atomic<bool>& release) {
+    JobSystem& jobs = jobSystem();
+    for (int i = 0; i < jobs.workerCount(); ++i) {
+        jobs.run(group, [&parked, &release]() {
+            parked.fetch_add(1);
+            while (!release.load()) std::this_thread::yield();
+        });
+    }
+    while (parked.load() < jobs.workerCount()) std::this_thread::yield();
+}
+
+} // namespace
+
+TEST(NpcPlanner, RandomPlannerMatchesSeededPicks) {
+    Game game;
+    init_game(game);
+    game.turnNumber = 7;
+    PlannerInput input = makePlannerInput(game);
+
+    RandomNpcPlanner planner;
+    TurnPlan plan = planner.plan(input, PlannerBudget{});
+
+    // Same draws the NpcSelect state has always made for this turn.
+    std::mt19937 rng(1000 + 7);
+    ASSERT_EQ(plan.assignments.size(), input.npcMechIds.size());
+    for (size_t i = 0; i < plan.assignments.size(); ++i) {
+        std::uniform_int_distribution<size_t> dist(0, game.hand.cards().size() - 1);
+        int cardId = game.hand.cards()[dist(rng)].id;
+        bool mirror = std::bernoulli_distribution(0.5f)(rng);
+        EXPECT_EQ(plan.assignments[i].mechId, input.npcMechIds[i]);
+        EXPECT_EQ(plan.assignments[i].cardId, cardId);
+        EXPECT_EQ(plan.assignments[i].useMirror, mirror);
+    }
+}
+
+TEST(NpcPlanner, PlannerInputUsesEnemyMechs) {
+    Game game;
+    init_game(game);
+    PlannerInput input = makePlannerInput(game);
+
+    EXPECT_EQ(input.npcMechIds, mechIdsOf(game.entities, ENEMY));
+    EXPECT_EQ(input.playerMechIds, mechIdsOf(game.entities, PLAYER));
+    EXPECT_EQ(input.state.hash, zobristHash(input.state));
+}
+
+TEST(NpcPlanner, PlannerInputSkipsDeadMechs) {
+    Game game;
+    init_game(game);
+    for (auto& e : game.entities) {
+        if (e.id == 2 || e.id == 5) e.health = 0;
+    }
+    PlannerInput input = makePlannerInput(game);
+
+    EXPECT_EQ(input.playerMechIds, (std::vector<int>{1, 3}));
+    EXPECT_EQ(input.npcMechIds, (std::vector<int>{4, 6}));
+}
+
+TEST(NpcPlanner, UndoCardRestoresPositionHealthAndHash) {
+    Game game;
+    init_game(game);
+    GameState state = take_state(game);
+    GameState before = state;
+
+    Card hit;
+    hit.id = 50;
+    hit.type = CardType::Damage;
+    hit.effect.type = CardType::Damage;
+    hit.effect.targetEntityId = 4;
+    hit.effect.damage = 30;
+    hit.mirroredEffect = hit.effect;
+
+    CardDelta move = resolveCard(state, game.hand.cards().front(), 1);
+    CardDelta damage = resolveCard(state, hit, 1);
+    ASSERT_NE(state.hash, before.hash);
+    undoCard(state, damage);
+    undoCard(state, move);
+
+    EXPECT_EQ(state.hash, before.hash);
+    ASSERT_EQ(state.entities.size(), before.entities.size());
+    for (size_t i = 0; i < state.entities.size(); ++i) {
+        EXPECT_EQ(state.entities[i].position.x, before.entities[i].position.x);
+        EXPECT_EQ(state.entities[i].position.y, before.entities[i].position.y);
+        EXPECT_EQ(state.entities[i].health, before.entities[i].health);
+    }
+    EXPECT_TRUE(state.grid.occupancy() == before.grid.occupancy());
+}
+
+TEST(NpcPlanner, LeavesResolveSubphasesSimultaneously) {
+    auto card = [](int id, CardEffect effect) {
+        Card c;
+        c.id = id;
+        c.type = effect.type;
+        c.effect = effect;
+        c.mirroredEffect = mirrorEffect(effect);
+        return c;
+    };
+    CardEffect advance;
+    advance.move = {1, 0};
+    CardEffect strike;
+    strike.type = CardType::Damage;
+    strike.targetEntityId = 4;
+    strike.damage = 30;
+    CardEffect mend;
+    mend.type = CardType::Heal;
+    mend.heal = 50;
+
+    PlannerInput input;
+    input.hand = {card(1, advance), card(2, strike), card(3, mend)};
+    input.npcMechIds = {4};
+    input.playerMechIds = {1};
+    Entity player{1, PLAYER, {5, 5}, "P"};
+    Entity npc{4, ENEMY, {5, 7}, "N"};
+    npc.facing = Facing::South;
+    npc.health = 10;
+    input.state.entities = {player, npc};
+    input.state.grid.syncOccupancy(input.state.entities);
+    input.state.hash = zobristHash(input.state);
+
+    // Both advance into (5,6): contested. Strike and mend on a 10-health mech:
+    // in sequence it floors at 0 and heals to 50, together it ends on 30.
+    const std::pair<TurnPlan, TurnPlan> cases[] = {
+        {TurnPlan{{{1, 1, false}}}, TurnPlan{{{4, 1, false}}}},
+        {TurnPlan{{{1, 2, false}}}, TurnPlan{{{4, 3, false}}}},
+    };
+    ExpectimaxNpcPlanner planner;
+    SubphaseResolver resolver;
+    for (const auto& [reply, plan] : cases) {
+        GameState together = input.state;
+        resolver.resolveTurn(together, input.hand, reply, plan);
+        GameState interleaved = input.state;
+        reply.resolve(interleaved, input.hand);
+        plan.resolve(interleaved, input.hand);
+        float simultaneousValue = ExpectimaxNpcPlanner::evaluate(together, input.npcMechIds, input.playerMechIds);
+        float interleavedValue = ExpectimaxNpcPlanner::evaluate(interleaved, input.npcMechIds, input.playerMechIds);
+        ASSERT_NE(simultaneousValue, interleavedValue);
+
+        EXPECT_EQ(planner.scorePlan(input, plan, reply), simultaneousValue);
+    }
+}
+
+TEST(NpcPlanner, SearchReachesDepthTwoWithLegalPlan) {
+    Game game;
+    init_game(game);
+    PlannerInput input = makePlannerInput(game);
+
+    ExpectimaxNpcPlanner planner;
+    PlannerBudget budget;
+    budget.milliseconds = 50.0;
+    PlannerStats stats;
+    TurnPlan plan = planner.plan(input, budget, &stats);
+
+    std::string err;
+    EXPECT_TRUE(plan.validate(input.hand, input.npcMechIds, &err)) << err;
+    EXPECT_EQ(plan.assignments.size(), input.npcMechIds.size());
+    EXPECT_EQ(stats.depthReached, 2);
+    EXPECT_GT(stats.repliesSampled, 0);
+    EXPECT_GT(stats.nodes, 0u);
+}
+
+TEST(NpcPlanner, UnregisteredHandCardsAreNotInterned) {
+    Game game;
+    init_game(game);
+    PlannerInput input = makePlannerInput(game);
+    ASSERT_FALSE(input.hand.empty());
+    input.hand[0].name = "Unregistered Lunge";
+    input.hand[0].effect.move = {3, 0};
+    input.hand[0].mirroredEffect = mirrorEffect(input.hand[0].effect);
+
+    size_t before = cardRegistry().size();
+    ExpectimaxNpcPlanner planner;
+    PlannerBudget budget;
+    budget.milliseconds = 20.0;
+    TurnPlan plan = planner.plan(input, budget);
+    std::string err;
+    EXPECT_TRUE(plan.validate(input.hand, input.npcMechIds, &err)) << err;
+    EXPECT_EQ(cardRegistry().size(), before);
+}
+
+TEST(NpcPlanner, SearchReusesTranspositionTableOnRepeat) {
+    Game game;
+    init_game(game);
+    PlannerInput input = makePlannerInput(game);
+
+    ExpectimaxNpcPlanner planner;
+    PlannerBudget budget;
+    budget.milliseconds = 20.0;
+    PlannerStats first;
+    planner.plan(input, budget, &first);
+    PlannerStats second;
+    planner.plan(input, budget, &second);
+
+    EXPECT_GT(second.ttHits, 0u);
+}
+
+TEST(NpcPlanner, TranspositionTableKeysOnExactHealth) {
+    Game game;
+    init_game(game);
+    game.entities[0].health = 95;
+    PlannerInput first = makePlannerInput(game);
+    game.entities[0].health = 91;
+    PlannerInput second = makePlannerInput(game);
+    // Same zobrist health bucket, so only the exact health tells them apart.
+    ASSERT_EQ(first.state.hash, second.state.hash);
+
+    ExpectimaxNpcPlanner planner;
+    PlannerBudget budget;
+    budget.milliseconds = 20.0;
+    planner.plan(first, budget);
+    PlannerStats stats;
+    planner.plan(second, budget, &stats);
+
+    EXPECT_EQ(stats.ttHits, 0u);
+}
+
+TEST(NpcPlanner, TranspositionTableKeysOnFullTurnNumber) {
+    Game game;
+    init_game(game);
+    game.turnNumber = 3;
+    PlannerInput first = makePlannerInput(game);
+    game.turnNumber = 3 + 64;
+    PlannerInput second = makePlannerInput(game);
+    // The zobrist turn key wraps, but the reply sample is seeded from the full turn.
+    ASSERT_EQ(first.state.hash, second.state.hash);
+
+    ExpectimaxNpcPlanner planner;
+    PlannerBudget budget;
+    budget.milliseconds = 20.0;
+    planner.plan(first, budget);
+    PlannerStats stats;
+    planner.plan(second, budget, &stats);
+
+    EXPECT_EQ(stats.ttHits, 0u);
+}
+
+TEST(NpcPlanner, CancelledSearchStillReturnsDepthOnePlan) {
+    Game game;
+    init_game(game);
+    PlannerInput input = makePlannerInput(game);
+
+    std::atomic<bool> cancel{true};
+    ExpectimaxNpcPlanner planner;
+    PlannerBudget budget;
+    budget.milliseconds = 1000.0;
+    budget.cancel = &cancel;
+    PlannerStats stats;
+    TurnPlan plan = planner.plan(input, budget, &stats);
+
+    EXPECT_TRUE(plan.validate(input.hand, input.npcMechIds, nullptr));
+    EXPECT_EQ(stats.depthReached, 1);
+    EXPECT_LT(stats.seconds, 0.5);
+}
+
+TEST(NpcPlanTask, BackgroundRunMatchesSynchronousPlan) {
+    Game game;
+    init_game(game);
+    PlannerInput input = makePlannerInput(game);
+    TurnPlan expected = RandomNpcPlanner().plan(input, PlannerBudget{});
+
+    NpcPlanTask task;
+    task.start(nullptr, input, 8.0);
+    while (!task.ready()) std::this_thread::yield();
+
+    TurnPlan plan;
+    ASSERT_TRUE(task.collect(plan));
+    EXPECT_EQ(plan.assignments, expected.assignments);
+    EXPECT_FALSE(task.active());
+    EXPECT_FALSE(task.collect(plan));
+}
+
+TEST(NpcPlanTask, RenderSideCancelAndCollectNeverRunTheSearch) {
+    Game game;
+    init_game(game);
+    auto planner = std::make_shared<CountingPlanner>();
+
+    TaskGroup blockers;
+    std::atomic<int> parked{0};
+    std::atomic<bool> release{false};
+    occupyWorkers(blockers, parked, release);
+
+    NpcPlanTask task;
+    task.start(planner, makePlannerInput(game), 60000.0);
+    TurnPlan plan;
+    EXPECT_FALSE(task.collect(plan)); // not finished: returns instead of helping the pool
+    task.cancel();
+    task.start(planner, makePlannerInput(game), 60000.0);
+    EXPECT_FALSE(task.collect(plan));
+    EXPECT_EQ(planner->calls.load(), 0);
+
+    // Once a worker is free the live run completes there; the cancelled one is skipped.
+    release.store(true);
+    while (!task.ready()) std::this_thread::yield();
+    EXPECT_TRUE(task.collect(plan));
+    EXPECT_FALSE(plan.assignments.empty());
+    EXPECT_EQ(planner->calls.load(), 1);
+    EXPECT_EQ(planner->callsOnMain.load(), 0);
+    while (!blockers.done()) std::this_thread::yield();
+}
+
+TEST(NpcPlanTask, RestartCancelsLongSearch) {
+    Game game;
+    init_game(game);
+    game.npcPlanner = makeNpcPlanner(NpcPlannerKind::Search);
+    game.npcBudgetMs = 60000.0f;
+
+    restartNpcPlanning(game);
+    ASSERT_TRUE(npcPlanningCurrent(game));
+    uint64_t firstGeneration = game.npcTask->generation();
+
+    // Player assigns a card: the running search is stale and gets replaced.
+    game.currentPlan.assignments.push_back({1, game.hand.cards().front().id, false});
+    EXPECT_FALSE(npcPlanningCurrent(game));
+    auto start = std::chrono::steady_clock::now();
+    restartNpcPlanning(game);
+    EXPECT_LT(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), 1.0);
+    EXPECT_EQ(game.npcTask->generation(), firstGeneration + 1);
+    EXPECT_TRUE(npcPlanningCurrent(game));
+
+    game.npcTask->cancel();
+    EXPECT_FALSE(game.npcTask->active());
+}
+
+TEST(NpcPlanTask, NpcSelectWaitsForBackgroundPlan) {
+    Game game;
+    init_game(game);
+    BossCardSelectState cardSelect;
+    cardSelect.enter(game);
+    ASSERT_TRUE(game.npcTask);
+
+    game.currentPlan.assignments.push_back({1, game.hand.cards().front().id, false});
+    BossNpcSelectState npcSelect;
+    npcSelect.enter(game);
+
+    CardActions actions;
+    std::unique_ptr<BossState> next;
+    for (int frame = 0; frame < 10000 && !next; ++frame) {
+        next = npcSelect.update(game, actions, 0.016f);
+        if (!next) std::this_thread::yield();
+    }
+    ASSERT_TRUE(next);
+    EXPECT_STREQ(next->getName(), "Play");
+    EXPECT_FALSE(game.lastAiPlan.assignments.empty());
+}
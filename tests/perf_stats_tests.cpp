@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include "perf_stats.h"
+
+TEST(PerfStats, PercentilesUseNearestRank) {
+    FrameTimeHistory history;
+    EXPECT_EQ(history.percentile(50.0f), 0.0f);
+    for (int i = 1; i <= 100; ++i) history.push(static_cast<float>(i));
+    EXPECT_EQ(history.size(), 100);
+    EXPECT_FLOAT_EQ(history.percentile(50.0f), 50.0f);
+    EXPECT_FLOAT_EQ(history.percentile(95.0f), 95.0f);
+    EXPECT_FLOAT_EQ(history.percentile(99.0f), 99.0f);
+    EXPECT_FLOAT_EQ(history.percentile(100.0f), 100.0f);
+    EXPECT_FLOAT_EQ(history.percentile(0.0f), 1.0f);
+    EXPECT_FLOAT_EQ(history.max(), 100.0f);
+}
+
+TEST(PerfStats, HistoryKeepsNewestWindow) {
+    FrameTimeHistory history;
+    const int total = FrameTimeHistory::kCapacity + 10;
+    for (int i = 0; i < total; ++i) history.push(static_cast<float>(i));
+    ASSERT_EQ(history.size(), FrameTimeHistory::kCapacity);
+    EXPECT_FLOAT_EQ(history.at(0), 10.0f);
+    EXPECT_FLOAT_EQ(history.at(history.size() - 1), static_cast<float>(total - 1));
+    // One spike in an otherwise steady window shows in p99 only.
+    FrameTimeHistory steady;
+    for (int i = 0; i < 199; ++i) steady.push(16.0f);
+    steady.push(80.0f);
+    EXPECT_FLOAT_EQ(steady.percentile(95.0f), 16.0f);
+    EXPECT_FLOAT_EQ(steady.percentile(100.0f), 80.0f);
+}
+
+TEST(PerfStats, RenderStatsCountMeshesAndTriangles) {
+    Mesh meshes[2] = {};
+    meshes[0].triangleCount = 12;
+    meshes[1].triangleCount = 30;
+    Model model = {};
+    model.meshCount = 2;
+    model.meshes = meshes;
+
+    RenderStats stats;
+    stats.countModel(model);
+    stats.countModel(model);
+    stats.countDraw(2);
+    EXPECT_EQ(stats.modelsDrawn, 2);
+    EXPECT_EQ(stats.drawCalls, 5);
+    EXPECT_EQ(stats.triangles, 2 * 42 + 2);
+}
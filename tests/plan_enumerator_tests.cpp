@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "ai/plan_enumerator.h"
+#include "game.h"
+#include "test_fixtures.h"
+#include <algorithm>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+using PlanKey = std::vector<std::tuple<int, int, bool>>;
+
+PlanKey keyOf(const TurnPlan& plan) {
+    PlanKey key;
+    for (const auto& a : plan.assignments) key.emplace_back(a.mechId, a.cardId, a.useMirror);
+    return key;
+}
+
+} // namespace
+
+TEST(PlanEnumerator, StarterHandProducesAllDistinctPlans) {
+    Game game;
+    init_game(game);
+    std::vector<int> mechs{1, 2, 3};
+
+    std::vector<TurnPlan> plans;
+    enumeratePlans(mechs, game.hand.cardList(), plans);
+
+    // 6 distinct move cards, each with a distinct mirror: 6*5*4 orderings * 2^3 mirrors
+    EXPECT_EQ(plans.size(), 960u);
+    std::set<PlanKey> unique;
+    for (const auto& p : plans) unique.insert(keyOf(p));
+    EXPECT_EQ(unique.size(), plans.size());
+
+    PlanValidator validator(game.hand.cardList(), mechs);
+    std::vector<uint8_t> ok;
+    EXPECT_EQ(validator.validateAll(plans, ok), plans.size());
+    for (const auto& p : plans) {
+        EXPECT_TRUE(p.validate(game.hand, mechs));
+    }
+}
+
+TEST(PlanEnumerator, SkipsMirrorWhenEffectIsSymmetric) {
+    std::vector<Card> hand{makeCard(1, "C1", CardType::Damage, 0, 0, 10), makeCard(2, "C2", CardType::Heal, 0, 0, 0, 10)};
+    std::vector<TurnPlan> plans;
+    enumeratePlans({7}, hand, plans);
+    ASSERT_EQ(plans.size(), 2u);
+    for (const auto& p : plans) EXPECT_FALSE(p.assignments[0].useMirror);
+}
+
+TEST(PlanEnumerator, DuplicateCardIdsEnumeratedOnce) {
+    std::vector<Card> hand{makeCard(1, "C1", CardType::Damage, 0, 0, 10), makeCard(1, "C1", CardType::Damage, 0, 0, 10)};
+    std::vector<TurnPlan> plans;
+    enumeratePlans({7, 8}, hand, plans);
+    // Both mechs take a copy of card 1; swapping the copies is not a new plan.
+    ASSERT_EQ(plans.size(), 1u);
+    EXPECT_EQ(plans[0].assignments.size(), 2u);
+}
+
+TEST(PlanEnumerator, FewerCardsThanMechsLeavesMechsIdle) {
+    std::vector<Card> hand{makeCard(1, "C1", CardType::Heal, 0, 0, 0, 10)};
+    std::vector<TurnPlan> plans;
+    enumeratePlans({7, 8, 9}, hand, plans);
+    ASSERT_EQ(plans.size(), 3u);
+    for (const auto& p : plans) EXPECT_EQ(p.assignments.size(), 1u);
+}
+
+TEST(PlanEnumerator, OmitsReorderedAndPartialPlans) {
+    std::vector<Card> hand{makeCard(1, "C1", CardType::Heal, 0, 0, 0, 10), makeCard(2, "C2", CardType::Damage, 0, 0, 10),
+                           makeCard(3, "C3", CardType::Heal, 0, 0, 0, 10)};
+    std::vector<TurnPlan> plans;
+    enumeratePlans({7, 8, 9, 10}, hand, plans);
+
+    // Legal, but outside the documented reduced set.
+    TurnPlan reordered;
+    reordered.assignments = {{8, 1, false}, {7, 2, false}, {9, 3, false}};
+    TurnPlan partial;
+    partial.assignments = {{7, 1, false}};
+    TurnPlan fourthMech;
+    fourthMech.assignments = {{10, 1, false}};
+    for (const TurnPlan* legal : {&reordered, &partial, &fourthMech}) {
+        EXPECT_TRUE(legal->validate(hand, {7, 8, 9, 10}));
+        EXPECT_EQ(std::count_if(plans.begin(), plans.end(), [&](const TurnPlan& p) { return keyOf(p) == keyOf(*legal); }), 0);
+    }
+    ASSERT_EQ(plans.size(), 6u); // 3! card orders over mechs 7, 8, 9
+    for (const auto& p : plans) {
+        ASSERT_EQ(p.assignments.size(), 3u);
+        EXPECT_EQ(p.assignments[0].mechId, 7);
+        EXPECT_EQ(p.assignments[1].mechId, 8);
+        EXPECT_EQ(p.assignments[2].mechId, 9);
+    }
+}
+
+TEST(PlanEnumerator, ValidatorMatchesTurnPlanValidate) {
+    std::vector<Card> hand{makeMoveCard(1, "C1", 1, 0), makeMoveCard(2, "C2", 0, 1)};
+    std::vector<int> roster{1, 2};
+    PlanValidator validator(hand, roster);
+    ASSERT_TRUE(validator.usable());
+
+    std::vector<TurnPlan> cases(5);
+    cases[0].assignments = {{1, 1, false}, {2, 2, true}};
+    cases[1].assignments = {{1, 1, false}, {1, 2, false}};  // duplicate mech
+    cases[2].assignments = {{1, 1, false}, {2, 1, false}};  // overuse
+    cases[3].assignments = {{3, 1, false}};                 // not in roster
+    cases[4].assignments = {{1, 9, false}};                 // card not in hand
+    for (const auto& plan : cases) {
+        EXPECT_EQ(validator.validate(plan), plan.validate(hand, roster));
+    }
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "common/profiler.h"
+#include "utils/jsonCodec.h"
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const ProfileEvent* findEvent(const std::vector<ProfileEvent>& events, const char* name) {
+    for (const ProfileEvent& e : events) {
+        if (e.name && std::string(e.name) == name) return &e;
+    }
+    return nullptr;
+}
+
+void spin(int64_t ns) {
+    int64_t until = profilerNowNs() + ns;
+    while (profilerNowNs() < until) {
+    }
+}
+
+} // namespace
+
+TEST(Profiler, NestedZonesNestInTime) {
+    profilerStart();
+    {
+        PROFILE_ZONE("outer");
+        spin(20000);
+        {
+            PROFILE_ZONE("inner");
+            spin(20000);
+        }
+        spin(20000);
+    }
+    profilerStop();
+
+    std::vector<ProfileEvent> events;
+    profilerCollect(events);
+    ASSERT_EQ(events.size(), 2u);
+    // Zones close innermost first.
+    EXPECT_STREQ(events[0].name, "inner");
+    const ProfileEvent* outer = findEvent(events, "outer");
+    const ProfileEvent* inner = findEvent(events, "inner");
+    ASSERT_NE(outer, nullptr);
+    ASSERT_NE(inner, nullptr);
+    EXPECT_EQ(outer->thread, inner->thread);
+    EXPECT_LT(outer->startNs, inner->startNs);
+    EXPECT_GT(outer->startNs + outer->durationNs, inner->startNs + inner->durationNs);
+    EXPECT_GE(inner->durationNs, 20000);
+}
+
+TEST(Profiler, StoppedProfilerRecordsNothing) {
+    profilerStart();
+    profilerStop();
+    {
+        PROFILE_ZONE("ignored");
+    }
+    std::vector<ProfileEvent> events;
+    profilerCollect(events);
+    EXPECT_TRUE(events.empty());
+
+    // A restart clears what the previous capture held.
+    profilerStart();
+    { PROFILE_ZONE("first"); }
+    profilerStart();
+    { PROFILE_ZONE("second"); }
+    profilerStop();
+    profilerCollect(events);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_STREQ(events[0].name, "second");
+}
+
+TEST(Profiler, RingKeepsNewestEvents) {
+    static const char* kNames[] = {"z0", "z1", "z2", "z3", "z4", "z5", "z6", "z7", "z8", "z9"};
+    profilerStart(4);
+    for (const char* name : kNames) {
+        ProfileZone zone(name);
+    }
+    profilerStop();
+
+    std::vector<ProfileEvent> events;
+    profilerCollect(events);
+    ASSERT_EQ(events.size(), 4u);
+    EXPECT_STREQ(events[0].name, "z6");
+    EXPECT_STREQ(events[3].name, "z9");
+}
+
+TEST(Profiler, ThreadsRecordIntoTheirOwnRings) {
+    profilerStart();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 100; ++i) {
+                PROFILE_ZONE("work");
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    profilerStop();
+
+    std::vector<ProfileEvent> events;
+    profilerCollect(events);
+    EXPECT_EQ(events.size(), 400u);
+    std::vector<uint32_t> ids;
+    for (const ProfileEvent& e : events) ids.push_back(e.thread);
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    EXPECT_EQ(ids.size(), 4u);
+}
+
+TEST(Profiler, ChromeTraceIsValidJson) {
+    profilerSetThreadName("test \"main\"");
+    profilerStart();
+    { PROFILE_ZONE("update_game"); }
+    profilerStop();
+
+    std::string json;
+    profilerWriteChromeTrace(json);
+    JsonReader reader(json);
+    ASSERT_TRUE(reader.beginObject());
+    std::string_view key;
+    int zones = 0;
+    bool named = false;
+    while (reader.nextKey(key)) {
+        if (key != "traceEvents") {
+            ASSERT_TRUE(reader.skipValue());
+            continue;
+        }
+        ASSERT_TRUE(reader.beginArray());
+        while (reader.nextElement()) {
+            ASSERT_TRUE(reader.beginObject());
+            std::string name;
+            std::string phase;
+            while (reader.nextKey(key)) {
+                std::string_view raw;
+                if (key == "name" || key == "ph") {
+                    ASSERT_TRUE(reader.readString(raw));
+                    JsonReader::unescape(raw, key == "name" ? name : phase);
+                } else {
+                    ASSERT_TRUE(reader.skipValue());
+                }
+            }
+            if (phase == "X" && name == "update_game") zones++;
+            if (phase == "M" && name == "thread_name") named = true;
+        }
+    }
+    ASSERT_TRUE(reader.ok()) << reader.error();
+    EXPECT_EQ(zones, 1);
+    EXPECT_TRUE(named);
+}
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "sim/replay.h"
+#include "sim/match_runner.h"
+#include "boss/bossPlayState.h"
+#include "game.h"
+#include "ui.h"
+#include <memory>
+#include <vector>
+
+namespace {
+
+ReplayLog recordMatch(uint32_t seed, MatchResult* result = nullptr) {
+    MatchConfig config;
+    config.maxTurns = 20;
+    ReplayLog log;
+    MatchResult r = runMatch(config, seed, &log);
+    if (result) *result = r;
+    return log;
+}
+
+} // namespace
+
+TEST(Replay, RecordedMatchReplaysWithMatchingChecksums) {
+    MatchResult match;
+    ReplayLog log = recordMatch(42, &match);
+    ASSERT_EQ(static_cast<int>(log.turns.size()), match.turns);
+    EXPECT_EQ(log.order, ReplayOrder::PlayerFirst);
+    EXPECT_EQ(log.seed, 42u);
+
+    GameState final;
+    ReplayResult result = runReplay(log, &final);
+    EXPECT_TRUE(result.ok()) << "mismatch at turn " << result.mismatchTurn;
+    EXPECT_EQ(result.turnsPlayed, match.turns);
+
+    int playerHealth = 0;
+    for (const auto& e : final.entities) {
+        if (e.type == PLAYER) playerHealth += e.health;
+    }
+    EXPECT_EQ(playerHealth, match.playerHealth);
+}
+
+TEST(Replay, BinaryRoundTripIsStableAndCompact) {
+    ReplayLog log = recordMatch(7);
+    std::vector<uint8_t> bytes;
+    ASSERT_TRUE(writeReplay(log, bytes));
+    EXPECT_LT(bytes.size(), 2048u);
+
+    ReplayLog decoded;
+    std::string err;
+    ASSERT_TRUE(readReplay(bytes.data(), bytes.size(), decoded, &err)) << err;
+    EXPECT_EQ(decoded.turns.size(), log.turns.size());
+    EXPECT_TRUE(decoded.initial == log.initial);
+    EXPECT_TRUE(runReplay(decoded).ok());
+
+    std::vector<uint8_t> again;
+    ASSERT_TRUE(writeReplay(decoded, again));
+    EXPECT_EQ(again, bytes);
+}
+
+TEST(Replay, TamperedChecksumReportsFirstMismatch) {
+    ReplayLog log = recordMatch(9);
+    ASSERT_GT(log.turns.size(), 4u);
+    log.turns[3].checksum ^= 1;
+
+    ReplayResult result = runReplay(log);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(result.mismatchTurn, 3);
+    EXPECT_EQ(result.turnsPlayed, 4);
+    EXPECT_NE(result.expected, result.actual);
+}
+
+TEST(Replay, RejectsTruncatedAndForeignData) {
+    ReplayLog log = recordMatch(11);
+    std::vector<uint8_t> bytes;
+    ASSERT_TRUE(writeReplay(log, bytes));
+
+    ReplayLog decoded;
+    std::string err;
+    EXPECT_FALSE(readReplay(bytes.data(), bytes.size() - 3, decoded, &err));
+    EXPECT_FALSE(err.empty());
+
+    bytes[0] ^= 0xFF;
+    EXPECT_FALSE(readReplay(bytes.data(), bytes.size(), decoded, &err));
+}
+
+TEST(Replay, RejectsInvalidEntityAndCardTypes) {
+    ReplayLog log = recordMatch(13);
+    std::vector<uint8_t> bytes;
+    ASSERT_TRUE(writeReplay(log, bytes));
+
+    size_t namesSize = 1;
+    for (const auto& name : log.names.names) namesSize += 1 + name.size();
+    size_t typeFacing = 16 + namesSize + 4 + 1 + 6;
+
+    ReplayLog decoded;
+    std::string err;
+    std::vector<uint8_t> badType = bytes;
+    badType[typeFacing] = static_cast<uint8_t>((badType[typeFacing] & 0xF0) | (OBJECT + 1));
+    EXPECT_FALSE(readReplay(badType.data(), badType.size(), decoded, &err));
+
+    std::vector<uint8_t> badFacing = bytes;
+    badFacing[typeFacing] = static_cast<uint8_t>((badFacing[typeFacing] & 0x0F) | 0x40);
+    EXPECT_FALSE(readReplay(badFacing.data(), badFacing.size(), decoded, &err));
+
+    ASSERT_FALSE(log.hand.empty());
+    log.hand[0].type = static_cast<CardType>(static_cast<int>(CardType::Heal) + 1);
+    ASSERT_TRUE(writeReplay(log, bytes));
+    EXPECT_FALSE(readReplay(bytes.data(), bytes.size(), decoded, &err));
+    EXPECT_EQ(err, "Invalid card type");
+}
+
+TEST(Replay, WriterRejectsValuesThatDoNotFit) {
+    ReplayLog log = recordMatch(15);
+    std::vector<uint8_t> bytes;
+    std::string err;
+
+    ReplayLog badId = log;
+    ASSERT_FALSE(badId.hand.empty());
+    badId.hand[0].id = 40000;
+    EXPECT_FALSE(writeReplay(badId, bytes, &err));
+    EXPECT_EQ(err, "Card id out of range");
+
+    ReplayLog badPlan = log;
+    ASSERT_FALSE(badPlan.turns.empty());
+    badPlan.turns[0].player.assignments.push_back({-40000, 1, false});
+    EXPECT_FALSE(writeReplay(badPlan, bytes, &err));
+    EXPECT_EQ(err, "Plan id out of range");
+
+    ReplayLog longPlan = log;
+    longPlan.turns[0].npc.assignments.assign(256, {1, 1, false});
+    EXPECT_FALSE(writeReplay(longPlan, bytes, &err));
+    EXPECT_EQ(err, "Too many plan assignments");
+
+    ReplayLog badTarget = log;
+    badTarget.hand[0].effect.targetEntityId = 70000;
+    EXPECT_FALSE(saveReplay(badTarget, "unused.vrpl", &err));
+    EXPECT_EQ(err, "Card effect value out of range");
+}
+
+TEST(Replay, PlayStateRecordingMatchesSimultaneousReplay) {
+    Game game;
+    init_game(game);
+    game.replay = std::make_shared<ReplayLog>();
+    GameState initial = take_state(game);
+    ASSERT_TRUE(beginReplay(*game.replay, initial, game.hand.cardList(), ReplayOrder::Simultaneous));
+    restore_state(game, std::move(initial));
+
+    game.currentPlan.assignments = {{1, 1, false}, {2, 4, false}, {3, 3, true}};
+    game.lastAiPlan.assignments = {{4, 1, false}, {5, 6, true}};
+
+    BossPlayState play;
+    ASSERT_TRUE(play.canEnter(game));
+    play.enter(game);
+    CardActions actions;
+    for (int i = 0; i < 10 && !play.canExit(game); ++i) {
+        play.update(game, actions, 0.5f);
+    }
+    ASSERT_TRUE(play.canExit(game));
+    play.exit(game);
+
+    ASSERT_EQ(game.replay->turns.size(), 1u);
+    GameState final;
+    ReplayResult result = runReplay(*game.replay, &final);
+    EXPECT_TRUE(result.ok());
+    ASSERT_EQ(final.entities.size(), game.entities.size());
+    for (size_t i = 0; i < final.entities.size(); ++i) {
+        EXPECT_EQ(final.entities[i].position.x, game.entities[i].position.x);
+        EXPECT_EQ(final.entities[i].position.y, game.entities[i].position.y);
+    }
+}
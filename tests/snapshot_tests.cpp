@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "snapshot.h"
+#include "game.h"
+#include "zobrist.h"
+#include <cstring>
+#include <vector>
+
+namespace {
+
+GameState makeMatchState() {
+    Game game;
+    init_game(game);
+    GameState state;
+    state.grid = game.grid;
+    state.entities = game.entities;
+    state.currentTurn = 7;
+    return state;
+}
+
+} // namespace
+
+TEST(Snapshot, RoundTripIsLossless) {
+    GameState state = makeMatchState();
+    state.entities.edit(1).health = 42;
+    state.entities.edit(3).facing = Facing::West;
+    state.grid.setCell(3, 4, 2);
+
+    NameTable names;
+    GameStateSnapshot snap;
+    std::string err;
+    ASSERT_TRUE(packSnapshot(state, names, snap, &err)) << err;
+
+    GameState restored;
+    unpackSnapshot(snap, names, restored);
+
+    ASSERT_EQ(restored.entities.size(), state.entities.size());
+    EXPECT_EQ(restored.currentTurn, 7);
+    for (size_t i = 0; i < state.entities.size(); ++i) {
+        const Entity& a = state.entities[i];
+        const Entity& b = restored.entities[i];
+        EXPECT_EQ(a.id, b.id);
+        EXPECT_EQ(a.type, b.type);
+        EXPECT_EQ(a.position.x, b.position.x);
+        EXPECT_EQ(a.position.y, b.position.y);
+        EXPECT_EQ(a.name, b.name);
+        EXPECT_EQ(a.health, b.health);
+        EXPECT_EQ(a.facing, b.facing);
+    }
+    EXPECT_EQ(restored.grid.getCell(3, 4), 2);
+    state.grid.syncOccupancy(state.entities);
+    EXPECT_EQ(restored.grid.occupancy(), state.grid.occupancy());
+    EXPECT_TRUE(restored.grid.isOccupied(state.entities[0].position.x, state.entities[0].position.y));
+    EXPECT_EQ(restored.hash, zobristHash(restored));
+    EXPECT_EQ(restored.hash, zobristHash(state));
+}
+
+TEST(Snapshot, MemcpyCopiesCompareAndHashEqual) {
+    GameState state = makeMatchState();
+    NameTable names;
+    GameStateSnapshot snap;
+    ASSERT_TRUE(packSnapshot(state, names, snap));
+
+    std::vector<GameStateSnapshot> flat(4);
+    std::memcpy(&flat[2], &snap, sizeof(snap));
+    EXPECT_TRUE(flat[2] == snap);
+    EXPECT_EQ(snapshotHash(flat[2]), snapshotHash(snap));
+
+    state.entities.edit(0).position.x += 1;
+    GameStateSnapshot moved;
+    ASSERT_TRUE(packSnapshot(state, names, moved));
+    EXPECT_NE(snapshotHash(moved), snapshotHash(snap));
+}
+
+TEST(Snapshot, NamesAreInternedOnce) {
+    GameState state = makeMatchState();
+    state.entities.edit(1).name = state.entities[0].name;
+    NameTable names;
+    GameStateSnapshot snap;
+    ASSERT_TRUE(packSnapshot(state, names, snap));
+    EXPECT_EQ(snap.entities[0].nameIndex, snap.entities[1].nameIndex);
+    EXPECT_EQ(names.names.size(), state.entities.size() - 1);
+}
+
+TEST(Snapshot, RejectsPositionsOutsideInt8) {
+    GameState state = makeMatchState();
+    state.entities.edit(0).position.x = 200;
+    NameTable names;
+    GameStateSnapshot snap;
+    std::string err;
+    EXPECT_FALSE(packSnapshot(state, names, snap, &err));
+    EXPECT_FALSE(err.empty());
+}
+
+TEST(Snapshot, RejectsTooManyEntities) {
+    GameState state;
+    for (int i = 0; i <= GameStateSnapshot::kMaxEntities; ++i) {
+        state.entities.push_back(Entity{i, OBJECT, {0, 0}, "Rock"});
+    }
+    NameTable names;
+    GameStateSnapshot snap;
+    EXPECT_FALSE(packSnapshot(state, names, snap));
+}
@@ -0,0 +1,248 @@
+#include <gtest/gtest.h>
+#include "subphase.h"
+#include "game.h"
+#include "zobrist.h"
+#include "sim/match_runner.h"
+#include "sim/replay.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+CardEffect moveEffect(int forward, int lateral) {
+    CardEffect e;
+    e.type = CardType::Move;
+    e.move = {forward, lateral};
+    return e;
+}
+
+CardEffect damageEffect(int targetId, int amount) {
+    CardEffect e;
+    e.type = CardType::Damage;
+    e.targetEntityId = targetId;
+    e.damage = amount;
+    return e;
+}
+
+CardEffect healEffect(int amount) {
+    CardEffect e;
+    e.type = CardType::Heal;
+    e.heal = amount;
+    return e;
+}
+
+// Entities all face north, so a move's (lateral, forward) is its (dx, dy).
+GameState makeState(std::initializer_list<GridPos> cells) {
+    GameState gs;
+    int id = 1;
+    for (GridPos p : cells) {
+        gs.entities.push_back(Entity{id, id % 2 ? PLAYER : ENEMY, p, "Mech"});
+        ++id;
+    }
+    gs.grid.syncOccupancy(gs.entities);
+    gs.hash = zobristHash(gs);
+    return gs;
+}
+
+void expectSameState(const GameState& a, const GameState& b) {
+    ASSERT_EQ(a.entities.size(), b.entities.size());
+    for (size_t i = 0; i < a.entities.size(); ++i) {
+        EXPECT_EQ(a.entities[i].position, b.entities[i].position);
+        EXPECT_EQ(a.entities[i].health, b.entities[i].health);
+    }
+    EXPECT_EQ(a.grid.occupancy(), b.grid.occupancy());
+    EXPECT_EQ(a.hash, b.hash);
+}
+
+} // namespace
+
+TEST(Subphase, SharedDestinationBouncesEveryone) {
+    GameState gs = makeState({{4, 4}, {6, 4}});
+    CardEffect right = moveEffect(0, 1);
+    CardEffect left = moveEffect(0, -1);
+    SubphaseAction actions[] = {{1, &right}, {2, &left}};
+    std::vector<CardDelta> deltas;
+    SubphaseResolver resolver;
+    resolver.resolve(gs, actions, &deltas);
+
+    EXPECT_EQ(gs.entities[0].position, (GridPos{4, 4}));
+    EXPECT_EQ(gs.entities[1].position, (GridPos{6, 4}));
+    ASSERT_EQ(deltas.size(), 2u);
+    EXPECT_TRUE(deltas[0].blocked);
+    EXPECT_TRUE(deltas[1].blocked);
+    EXPECT_EQ(gs.hash, zobristHash(gs));
+}
+
+TEST(Subphase, SwapBouncesButFollowingSucceeds) {
+    SubphaseResolver resolver;
+    CardEffect right = moveEffect(0, 1);
+    CardEffect left = moveEffect(0, -1);
+
+    GameState swap = makeState({{4, 4}, {5, 4}});
+    SubphaseAction swapActions[] = {{1, &right}, {2, &left}};
+    resolver.resolve(swap, swapActions);
+    EXPECT_EQ(swap.entities[0].position, (GridPos{4, 4}));
+    EXPECT_EQ(swap.entities[1].position, (GridPos{5, 4}));
+
+    // 1 steps into the cell 2 is leaving; sequential resolution would block it.
+    GameState follow = makeState({{4, 4}, {5, 4}});
+    SubphaseAction followActions[] = {{1, &right}, {2, &right}};
+    resolver.resolve(follow, followActions);
+    EXPECT_EQ(follow.entities[0].position, (GridPos{5, 4}));
+    EXPECT_EQ(follow.entities[1].position, (GridPos{6, 4}));
+    EXPECT_EQ(follow.hash, zobristHash(follow));
+}
+
+TEST(Subphase, BouncesPropagateAlongChains) {
+    // 3 is walled in by 4, so 2 cannot enter 3's cell and 1 cannot enter 2's.
+    GameState gs = makeState({{2, 4}, {3, 4}, {4, 4}, {5, 4}});
+    CardEffect right = moveEffect(0, 1);
+    SubphaseAction actions[] = {{1, &right}, {2, &right}, {3, &right}};
+    std::vector<CardDelta> deltas;
+    SubphaseResolver resolver;
+    resolver.resolve(gs, actions, &deltas);
+
+    EXPECT_EQ(gs.entities[0].position, (GridPos{2, 4}));
+    EXPECT_EQ(gs.entities[1].position, (GridPos{3, 4}));
+    EXPECT_EQ(gs.entities[2].position, (GridPos{4, 4}));
+    for (const CardDelta& d : deltas) EXPECT_TRUE(d.blocked);
+}
+
+TEST(Subphase, RotationOfThreeGoesThrough) {
+    GameState gs = makeState({{5, 5}, {6, 5}, {6, 6}});
+    CardEffect east = moveEffect(0, 1);
+    CardEffect north = moveEffect(1, 0);
+    CardEffect southWest = moveEffect(-1, -1);
+    SubphaseAction actions[] = {{1, &east}, {2, &north}, {3, &southWest}};
+    SubphaseResolver resolver;
+    resolver.resolve(gs, actions);
+
+    EXPECT_EQ(gs.entities[0].position, (GridPos{6, 5}));
+    EXPECT_EQ(gs.entities[1].position, (GridPos{6, 6}));
+    EXPECT_EQ(gs.entities[2].position, (GridPos{5, 5}));
+    EXPECT_EQ(gs.grid.occupancy().count(), 3);
+    EXPECT_EQ(gs.hash, zobristHash(gs));
+}
+
+TEST(Subphase, DoubleMovedMechStaysAndHealthIsSummed) {
+    GameState gs = makeState({{4, 4}, {8, 8}});
+    gs.entities.edit(1).health = 10;
+    gs.hash = zobristHash(gs);
+    CardEffect right = moveEffect(0, 1);
+    CardEffect up = moveEffect(1, 0);
+    CardEffect hit = damageEffect(2, 30);
+    CardEffect mend = healEffect(50);
+    SubphaseAction actions[] = {{1, &right}, {1, &up}, {1, &hit}, {2, &mend}};
+    SubphaseResolver resolver;
+    resolver.resolve(gs, actions);
+
+    EXPECT_EQ(gs.entities[0].position, (GridPos{4, 4}));
+    // Damage then heal in sequence would floor at 0 and end on 50; the sum is 30 in any order.
+    EXPECT_EQ(gs.entities[1].health, 30);
+    EXPECT_EQ(gs.hash, zobristHash(gs));
+}
+
+TEST(Subphase, HealCapMatchesSequentialResolution) {
+    // At, just below and above the cap.
+    for (int start : {100, 95, 130}) {
+        GameState simultaneous = makeState({{4, 4}});
+        simultaneous.entities.edit(0).health = start;
+        simultaneous.hash = zobristHash(simultaneous);
+        GameState sequential = simultaneous;
+
+        CardEffect mend = healEffect(20);
+        SubphaseAction actions[] = {{1, &mend}};
+        SubphaseResolver resolver;
+        resolver.resolve(simultaneous, actions);
+
+        Card card;
+        card.id = 9;
+        card.type = CardType::Heal;
+        card.effect = mend;
+        card.mirroredEffect = mend;
+        resolveCard(sequential, card, 1);
+
+        EXPECT_EQ(simultaneous.entities[0].health, 100) << "start " << start;
+        EXPECT_EQ(sequential.entities[0].health, simultaneous.entities[0].health) << "start " << start;
+        EXPECT_EQ(simultaneous.hash, zobristHash(simultaneous));
+    }
+}
+
+TEST(Subphase, OutcomeIgnoresActionOrder) {
+    Game game;
+    init_game(game);
+    std::vector<Card> hand = game.hand.cardList();
+    std::mt19937 rng(7);
+    SubphaseResolver resolver;
+
+    for (int trial = 0; trial < 200; ++trial) {
+        GameState base = take_state(game);
+        std::vector<PlanAssignment> assignments;
+        for (const Entity& e : base.entities) {
+            if (e.type == OBJECT) continue;
+            const Card& card = hand[rng() % hand.size()];
+            assignments.push_back({e.id, card.id, (rng() & 1) != 0});
+        }
+        GameState forward = base;
+        resolver.resolve(forward, hand, assignments);
+        for (int shuffle = 0; shuffle < 4; ++shuffle) {
+            std::shuffle(assignments.begin(), assignments.end(), rng);
+            GameState shuffled = base;
+            resolver.resolve(shuffled, game.hand, assignments);
+            expectSameState(forward, shuffled);
+        }
+        restore_state(game, std::move(forward));
+    }
+}
+
+TEST(Subphase, UndoRestoresEveryRecordedSubphase) {
+    Game game;
+    init_game(game);
+    std::vector<Card> hand = game.hand.cardList();
+    CardEffect hit = damageEffect(4, 40);
+    CardEffect mend = healEffect(30);
+    std::mt19937 rng(11);
+    SubphaseResolver resolver;
+    SubphaseUndo undo[3];
+
+    GameState state = take_state(game);
+    for (int trial = 0; trial < 200; ++trial) {
+        GameState before = state;
+        for (SubphaseUndo& record : undo) {
+            std::vector<PlanAssignment> assignments;
+            for (const Entity& e : state.entities) {
+                if (e.type == OBJECT || rng() % 3 == 0) continue;
+                assignments.push_back({e.id, hand[rng() % hand.size()].id, (rng() & 1) != 0});
+            }
+            std::vector<SubphaseAction> actions;
+            for (const PlanAssignment& a : assignments) {
+                const Card& card = *std::find_if(hand.begin(), hand.end(), [&a](const Card& c) { return c.id == a.cardId; });
+                actions.push_back({a.mechId, a.useMirror ? &card.mirroredEffect : &card.effect, nullptr, a.useMirror});
+            }
+            if (rng() % 2) actions.push_back({1, &hit});
+            if (rng() % 2) actions.push_back({4, &mend});
+            resolver.resolve(state, actions, nullptr, &record);
+        }
+        GameState after = state;
+        for (int i = 2; i >= 0; --i) SubphaseResolver::undo(state, undo[i]);
+        expectSameState(before, state);
+        state = after; // walk on so later trials start from crowded, damaged positions
+    }
+}
+
+TEST(Subphase, SimultaneousMatchesReplayCleanly) {
+    MatchConfig config;
+    config.maxTurns = 12;
+    config.simultaneous = true;
+    ReplayLog log;
+    runMatch(config, matchSeed(3, 0), &log);
+    EXPECT_EQ(log.order, ReplayOrder::Simultaneous);
+    ASSERT_FALSE(log.turns.empty());
+
+    std::vector<uint8_t> bytes;
+    ASSERT_TRUE(writeReplay(log, bytes));
+    ReplayLog decoded;
+    ASSERT_TRUE(readReplay(bytes.data(), bytes.size(), decoded));
+    EXPECT_TRUE(runReplay(decoded).ok());
+}
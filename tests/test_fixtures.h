@@ -0,0 +1,54 @@
+#pragma once
+
+#include "card.h"
+#include "entity.h"
+#include "grid.h"
+#include <string>
+#include <vector>
+
+/**
+ * Card and state builders shared by the card, hand, codec and planner tests.
+ * Mirrored effects are derived with mirrorEffect, as the registry does.
+ */
+
+inline Card makeCard(int id, const std::string& name, CardType type = CardType::Move, int fwd = 0, int lat = 0,
+                     int damage = 0, int heal = 0) {
+    Card c;
+    c.id = id;
+    c.name = name;
+    c.type = type;
+    c.effect.type = type;
+    c.effect.move = {fwd, lat};
+    c.effect.damage = damage;
+    c.effect.heal = heal;
+    c.mirroredEffect = mirrorEffect(c.effect);
+    return c;
+}
+
+// Zero-step Move card named after its id; for tests that only track ids.
+inline Card makeCard(int id) {
+    return makeCard(id, "Card" + std::to_string(id));
+}
+
+inline Card makeMoveCard(int id, const std::string& name, int fwd, int lat) {
+    return makeCard(id, name, CardType::Move, fwd, lat);
+}
+
+inline Card makeDamageCard(int id, int targetId, int amount) {
+    Card c = makeCard(id, "Hit", CardType::Damage, 0, 0, amount);
+    c.effect.targetEntityId = targetId;
+    c.mirroredEffect = mirrorEffect(c.effect);
+    return c;
+}
+
+// Player 1 at playerPos plus extras, with occupancy synced.
+inline GameState makeState(const GridPos& playerPos, Facing facing = Facing::North,
+                           const std::vector<Entity>& extras = {}) {
+    GameState gs;
+    Entity player{1, PLAYER, playerPos, "Player"};
+    player.facing = facing;
+    gs.entities.push_back(player);
+    gs.entities.insert(gs.entities.end(), extras.begin(), extras.end());
+    gs.grid.syncOccupancy(gs.entities);
+    return gs;
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "card.h"
+#include "game.h"
+#include "wire.h"
+#include "zobrist.h"
+#include "test_fixtures.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+bool insideBuffer(std::string_view view, const std::vector<uint8_t>& bytes) {
+    const char* begin = reinterpret_cast<const char*>(bytes.data());
+    return view.data() >= begin && view.data() + view.size() <= begin + bytes.size();
+}
+
+} // namespace
+
+TEST(Wire, CardRoundTripsThroughView) {
+    Card card = makeCard(7, "Zap", CardType::Damage, 0, 0, 15);
+    card.effect.targetEntityId = 4;
+    card.mirroredEffect = mirrorEffect(card.effect);
+    std::vector<uint8_t> bytes;
+    encodeCard(card, bytes);
+
+    CardWireView view;
+    ASSERT_TRUE(view.parse(bytes));
+    EXPECT_EQ(view.card().name, "Zap");
+    EXPECT_TRUE(insideBuffer(view.card().name, bytes));
+
+    Card decoded = view.card().toCard();
+    EXPECT_EQ(decoded.id, 7);
+    EXPECT_EQ(decoded.type, CardType::Damage);
+    EXPECT_EQ(decoded.effect.targetEntityId, 4);
+    EXPECT_EQ(decoded.effect.damage, 15);
+}
+
+TEST(Wire, HandViewIteratesWithoutCopyingNames) {
+    Game game;
+    init_game(game);
+    game.hand.addCard(makeCard(20, "Advance", CardType::Move, 1, 0)); // repeated name shares a table slot
+
+    std::vector<uint8_t> bytes;
+    encodeHand(game.hand, bytes);
+    HandView view;
+    ASSERT_TRUE(view.parse(bytes));
+    ASSERT_EQ(view.size(), game.hand.cards().size());
+
+    size_t i = 0;
+    for (const CardView& card : view) {
+        const Card& expected = game.hand.cards()[i++];
+        EXPECT_EQ(card.id, expected.id);
+        EXPECT_EQ(card.name, expected.name);
+        EXPECT_TRUE(insideBuffer(card.name, bytes));
+        EXPECT_EQ(card.effect.move.forward, expected.effect.move.forward);
+        EXPECT_EQ(card.effect.move.lateral, expected.effect.move.lateral);
+    }
+    EXPECT_EQ(i, game.hand.cards().size());
+
+    Hand decoded;
+    ASSERT_TRUE(view.toHand(decoded));
+    ASSERT_EQ(decoded.cards().size(), game.hand.cards().size());
+    EXPECT_EQ(decoded.cards().back().mirroredEffect.move.lateral, game.hand.cards().back().mirroredEffect.move.lateral);
+
+    // Binary is much smaller than the JSON form of the same hand.
+    EXPECT_LT(bytes.size() * 3, serializeHand(game.hand).size());
+}
+
+TEST(Wire, TurnPlanRoundTrips) {
+    TurnPlan plan;
+    plan.assignments = {{1, 1, false}, {2, 4, true}, {-3, 600, false}};
+    std::vector<uint8_t> bytes;
+    encodeTurnPlan(plan, bytes);
+
+    TurnPlanView view;
+    ASSERT_TRUE(view.parse(bytes));
+    TurnPlan decoded;
+    view.toTurnPlan(decoded);
+    EXPECT_EQ(decoded.assignments, plan.assignments);
+}
+
+TEST(Wire, GameStateRoundTripsGridAndHash) {
+    Game game;
+    init_game(game);
+    GameState state = take_state(game);
+    state.currentTurn = 5;
+    state.hash = zobristHash(state);
+
+    std::vector<uint8_t> bytes;
+    encodeGameState(state, bytes);
+    GameStateView view;
+    ASSERT_TRUE(view.parse(bytes));
+    EXPECT_EQ(view.currentTurn(), 5);
+    EXPECT_EQ(view.entityCount(), state.entities.size());
+
+    GameState decoded;
+    view.toGameState(decoded);
+    ASSERT_EQ(decoded.entities.size(), state.entities.size());
+    for (size_t i = 0; i < state.entities.size(); ++i) {
+        EXPECT_EQ(decoded.entities[i].id, state.entities[i].id);
+        EXPECT_EQ(decoded.entities[i].name, state.entities[i].name);
+        EXPECT_EQ(decoded.entities[i].facing, state.entities[i].facing);
+        EXPECT_EQ(decoded.entities[i].position.x, state.entities[i].position.x);
+        EXPECT_EQ(decoded.entities[i].position.y, state.entities[i].position.y);
+    }
+    for (int y = 0; y < Grid::SIZE; ++y) {
+        for (int x = 0; x < Grid::SIZE; ++x) EXPECT_EQ(decoded.grid.getCell(x, y), state.grid.getCell(x, y));
+    }
+    EXPECT_EQ(decoded.hash, state.hash);
+}
+
+TEST(Wire, GameStateKeepsCellsOutsideTheBoard) {
+    GameState state;
+    state.entities.push_back(Entity{1, PLAYER, {-3, 400}, "Player"});
+    std::vector<uint8_t> bytes;
+    encodeGameState(state, bytes);
+
+    GameStateView view;
+    ASSERT_TRUE(view.parse(bytes));
+    GameState decoded;
+    view.toGameState(decoded);
+    ASSERT_EQ(decoded.entities.size(), 1u);
+    EXPECT_EQ(decoded.entities[0].position, (GridPos{-3, 400}));
+}
+
+TEST(Wire, RejectsWrongVersionKindAndTruncation) {
+    Game game;
+    init_game(game);
+    std::vector<uint8_t> bytes;
+    encodeHand(game.hand, bytes);
+
+    std::string error;
+    TurnPlanView wrongKind;
+    EXPECT_FALSE(wrongKind.parse(bytes, &error));
+
+    std::vector<uint8_t> future = bytes;
+    future[2] = kWireVersion + 1;
+    HandView view;
+    EXPECT_FALSE(view.parse(future, &error));
+    EXPECT_EQ(error, "Unsupported wire version");
+
+    for (size_t cut = 0; cut < bytes.size(); ++cut) {
+        EXPECT_FALSE(view.parse(std::span<const uint8_t>(bytes.data(), cut))) << "cut at " << cut;
+    }
+    EXPECT_TRUE(view.parse(bytes));
+}
+
+TEST(Wire, EncodersReuseCallerBuffer) {
+    Game game;
+    init_game(game);
+    std::vector<uint8_t> bytes;
+    encodeHand(game.hand, bytes);
+    size_t size = bytes.size();
+    const uint8_t* data = bytes.data();
+
+    encodeHand(game.hand, bytes);
+    EXPECT_EQ(bytes.size(), size);
+    EXPECT_EQ(bytes.data(), data);
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "zobrist.h"
+#include "card.h"
+#include "game.h"
+#include "ai/transposition_table.h"
+#include <thread>
+#include <vector>
+
+namespace {
+
+Card makeDamageCard(int id, int targetId, int amount) {
+    Card c;
+    c.id = id;
+    c.name = "Hit";
+    c.type = CardType::Damage;
+    c.effect.type = CardType::Damage;
+    c.effect.targetEntityId = targetId;
+    c.effect.damage = amount;
+    c.mirroredEffect = mirrorEffect(c.effect);
+    return c;
+}
+
+} // namespace
+
+TEST(Zobrist, IncrementalHashMatchesRecompute) {
+    Game game;
+    init_game(game);
+    GameState state = take_state(game);
+    ASSERT_EQ(state.hash, zobristHash(state));
+
+    for (const auto& card : game.hand.cards()) {
+        resolveCard(state, card, 1, false);
+        resolveCard(state, card, 4, true);
+        EXPECT_EQ(state.hash, zobristHash(state));
+    }
+    resolveCard(state, makeDamageCard(50, 5, 35), 1);
+    EXPECT_EQ(state.hash, zobristHash(state));
+
+    zobristAdvanceTurn(state);
+    EXPECT_EQ(state.hash, zobristHash(state));
+}
+
+TEST(Zobrist, DistinguishesPositionsAndTransposesEqualStates) {
+    Game game;
+    init_game(game);
+    GameState a = take_state(game);
+    GameState b = a;
+    uint64_t start = a.hash;
+
+    const Card& advance = game.hand.cards()[0];  // forward 1
+    const Card& retreat = game.hand.cards()[4];  // back 1
+    resolveCard(a, advance, 1);
+    EXPECT_NE(a.hash, start);
+    resolveCard(a, retreat, 1);
+    EXPECT_EQ(a.hash, start);
+
+    // Same moves in a different order land on the same hash
+    resolveCard(a, advance, 2);
+    resolveCard(a, advance, 3);
+    resolveCard(b, advance, 3);
+    resolveCard(b, advance, 2);
+    EXPECT_EQ(a.hash, b.hash);
+}
+
+TEST(TranspositionTable, StoreProbeAndDepthPreference) {
+    TranspositionTable tt(2048);
+    TTEntry out;
+    EXPECT_FALSE(tt.probe(0x1234, out));
+
+    tt.store(0x1234, {1.5f, 7, 2, 1});
+    ASSERT_TRUE(tt.probe(0x1234, out));
+    EXPECT_FLOAT_EQ(out.value, 1.5f);
+    EXPECT_EQ(out.bestPlan, 7);
+    EXPECT_EQ(out.depth, 2);
+
+    tt.store(0x1234, {9.0f, 1, 1, 0}); // shallower result is ignored
+    ASSERT_TRUE(tt.probe(0x1234, out));
+    EXPECT_EQ(out.bestPlan, 7);
+
+    // Same slot, different key: replaced, and the old key no longer hits
+    uint64_t other = 0x1234 + tt.capacity();
+    tt.store(other, {0.0f, 0, 0, 0});
+    EXPECT_TRUE(tt.probe(other, out));
+    EXPECT_FALSE(tt.probe(0x1234, out));
+
+    tt.clear();
+    EXPECT_FALSE(tt.probe(other, out));
+}
+
+TEST(TranspositionTable, ConcurrentWritersNeverReturnForeignEntries) {
+    TranspositionTable tt(1024);
+    auto writer = [&tt](uint64_t base) {
+        for (uint64_t i = 0; i < 20000; ++i) {
+            uint64_t key = base + (i % 4096) * 0x9E3779B97F4A7C15ull;
+            tt.store(key, {static_cast<float>(key & 0xFFFF), static_cast<uint16_t>(key & 0x7FFF), 1, 0});
+            TTEntry e;
+            if (tt.probe(key, e)) {
+                ASSERT_EQ(e.bestPlan, static_cast<uint16_t>(key & 0x7FFF));
+            }
+        }
+    };
+    std::thread t1(writer, 1);
+    std::thread t2(writer, 2);
+    t1.join();
+    t2.join();
+}
@@ -23,3 +23,12 @@ input = {
     zoom_min = 5.0,
     zoom_max = 80.0
 }
+
+ai = {
+    search = false,
+    budget_ms = 8.0
+}
+
+debug = {
+    alloc_tracking = false
+}